@@ -30,6 +30,7 @@
 
 #include "../AC3Solver/AC3Solver.h"
 #include "../BacktrackSolver/BacktrackSolver.h"
+#include "../BackjumpSolver/BackjumpSolver.h"
 
 #include <assert.h>
 
@@ -37,4 +38,46 @@ bool AC3BacktrackSolver(SudokuPuzzle* pzl)
 {
     assert(pzl != NULL);
     return (AC3Solver(pzl)&& BacktrackSolver(pzl));
+}
+
+bool AC3BacktrackLCVSolver(SudokuPuzzle* pzl)
+{
+    assert(pzl != NULL);
+    return (AC3Solver(pzl) && BacktrackLCVSolver(pzl));
+}
+
+bool AC3SubsetBacktrackSolver(SudokuPuzzle* pzl)
+{
+    assert(pzl != NULL);
+    return (AC3SubsetSolver(pzl) && BacktrackSolver(pzl));
+}
+
+bool AC3ChainBacktrackSolver(SudokuPuzzle* pzl)
+{
+    assert(pzl != NULL);
+    return (AC3ChainSolver(pzl) && BacktrackSolver(pzl));
+}
+
+bool AC3AllDifferentBacktrackSolver(SudokuPuzzle* pzl)
+{
+    assert(pzl != NULL);
+    return (AC3AllDifferentSolver(pzl) && BacktrackSolver(pzl));
+}
+
+bool AC3ProbeBacktrackSolver(SudokuPuzzle* pzl)
+{
+    assert(pzl != NULL);
+    return (AC3ProbeSolver(pzl) && BacktrackSolver(pzl));
+}
+
+bool AC3RestartBacktrackSolver(SudokuPuzzle* pzl)
+{
+    assert(pzl != NULL);
+    return (AC3Solver(pzl) && BacktrackRestartSolver(pzl));
+}
+
+bool AC3BackjumpSolver(SudokuPuzzle* pzl)
+{
+    assert(pzl != NULL);
+    return (AC3Solver(pzl) && BackjumpSolver(pzl));
 }
\ No newline at end of file
@@ -40,4 +40,41 @@
 
 bool AC3BacktrackSolver(SudokuPuzzle* pzl);
 
+/*
+** As AC3BacktrackSolver, but the backtracking search uses least-constraining-
+** value ordering.
+*/
+bool AC3BacktrackLCVSolver(SudokuPuzzle* pzl);
+
+/*
+** As AC3BacktrackSolver, but uses AC3SubsetSolver to simplify the puzzle.
+*/
+bool AC3SubsetBacktrackSolver(SudokuPuzzle* pzl);
+
+/*
+** As AC3BacktrackSolver, but uses AC3ChainSolver to simplify the puzzle.
+*/
+bool AC3ChainBacktrackSolver(SudokuPuzzle* pzl);
+
+/*
+** As AC3BacktrackSolver, but uses AC3AllDifferentSolver to simplify the
+** puzzle.
+*/
+bool AC3AllDifferentBacktrackSolver(SudokuPuzzle* pzl);
+
+/*
+** As AC3BacktrackSolver, but uses AC3ProbeSolver to simplify the puzzle.
+*/
+bool AC3ProbeBacktrackSolver(SudokuPuzzle* pzl);
+
+/*
+** As AC3BacktrackSolver, but searches with BacktrackRestartSolver.
+*/
+bool AC3RestartBacktrackSolver(SudokuPuzzle* pzl);
+
+/*
+** As AC3BacktrackSolver, but searches with BackjumpSolver.
+*/
+bool AC3BackjumpSolver(SudokuPuzzle* pzl);
+
 #endif // !AC3BACKTRACK_H
@@ -29,24 +29,30 @@
 */
 
 #include "AC3Solver.h"
+#include "AC3Solver9.h"
 
-#include "GridLocationSet.h"
 #include "../common/Domain.h"
+#include "../Propagators/AllDifferentPropagator.h"
+#include "../Propagators/ChainPropagator.h"
+#include "../Propagators/FishPropagator.h"
+#include "../Propagators/KillerPropagator.h"
+#include "../Propagators/PropagationEngine.h"
+#include "../Propagators/SubsetPropagator.h"
 #include "../SudokuPrint.h"
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 /*
-** Initializes location set and GridSquare domains.
+** Initializes GridSquare domains.
 */
-static void PopulateSet(GridLocationSet* set, SudokuPuzzle* pzl)
+static void InitializeDomains(SudokuPuzzle* pzl)
 {
     const unsigned int gridOrder = GetGridOrder(pzl->grid);
     unsigned int row = 0;
 
-    assert(set != NULL);
-
     for (row = 0; row < gridOrder; ++row) {
         unsigned int col = 0;
         for (col = 0; col < gridOrder; ++col) {
@@ -57,79 +63,175 @@ static void PopulateSet(GridLocationSet* set, SudokuPuzzle* pzl)
                 DomSetFull(&square->domain);
             }
             else {
-                GridLocation location = { 0, 0 };
-
                 DomSetEmpty(&square->domain);
                 DomAddElement(&square->domain, square->value);
-
-                location.row = row;
-                location.col = col;
-                GLSInsert(set, location);
             }
         }
     }
 }
 
 /*
-** Helper function for AC3. Given the location of an modified square, updates
-** the domain of all squares in the same regions as the modified square and
-** adds affected squares to the location set.
+** Squares waiting to be handled by ArcConsistency, by cell index. A square is
+** only queued once at a time. The queue is the propagator's state, and is
+** empty between runs.
+*/
+typedef struct {
+    CellIndex* cells;
+    bool* queued;
+    unsigned int numQueued;
+} CellQueue;
+
+/*
+** Allocates an empty queue sized for the puzzle, in one block.
 */
-static void UpdateAffectedSquares(GridLocation modifiedLoc, SudokuPuzzle* pzl, GridLocationSet* locationSet)
+static void* CreateCellQueue(SudokuPuzzle* pzl)
 {
-    const Constraint* constraints = pzl->uniqueValue->constraints;
-    const unsigned int numConstraints = pzl->uniqueValue->numConstraints;
+    const unsigned int numSquares = GetGridOrder(pzl->grid) * GetGridOrder(pzl->grid);
+    CellQueue* queue = (CellQueue*)malloc(sizeof(CellQueue) + numSquares * (sizeof(CellIndex) + sizeof(bool)));
 
-    unsigned int index = 0;
+    if (queue == NULL) return NULL;
 
-    for (index = 0; index < numConstraints; ++index) {
+    queue->cells = (CellIndex*)(queue + 1);
+    queue->queued = (bool*)(queue->cells + numSquares);
+    queue->numQueued = 0;
+    memset(queue->queued, 0, numSquares * sizeof(bool));
 
-        /* If this region contains the modified square */
-        if (RegionContains(&constraints[index].region, modifiedLoc)) {
+    return queue;
+}
 
-            const GridLocation* locations = constraints[index].region.locations;
-            const unsigned int regionSize = constraints[index].region.regionSize;
-            BinaryConstraintUpdate updaterFunc = constraints[index].funcs.binaryConstraint;
-            unsigned int regIndex = 0;
+static void DestroyCellQueue(void* queue)
+{
+    free(queue);
+}
 
-            /* Move through each square of the region */
-            for (regIndex = 0; regIndex < regionSize; ++regIndex) {
+static void QueueCell(CellQueue* queue, const CellIndex cell)
+{
+    if (queue->queued[cell]) return;
+
+    queue->queued[cell] = true;
+    queue->cells[queue->numQueued++] = cell;
+}
+
+static CellIndex PopCell(CellQueue* queue)
+{
+    const CellIndex cell = queue->cells[--queue->numQueued];
+
+    queue->queued[cell] = false;
+    return cell;
+}
 
-                /* Update the domain */
-                if (updaterFunc(pzl->grid, locations[regIndex], modifiedLoc)) {
+/*
+** Helper function for ArcConsistency. Given the cell of a modified square,
+** updates the domain of all squares in the same regions as the modified
+** square, and of its neighbours, and queues and reports the affected squares.
+**
+** Returns true if any domain was changed.
+*/
+static bool UpdateAffectedSquares(const CellIndex modifiedCell, SudokuPuzzle* pzl, CellQueue* queue, const PropagationDelta* delta)
+{
+    const ConstraintList* list = pzl->uniqueValue;
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    GridSquare* squares = GetSquares(pzl->grid);
+    const GridLocation modifiedLoc = { modifiedCell / gridOrder, modifiedCell % gridOrder };
+    bool changed = false;
 
-                    /* And add to the locationSet if the domain is changed */
-                    GLSInsert(locationSet, locations[regIndex]);
+    unsigned int index = 0;
+
+    /* Only the regions containing the modified square */
+    for (index = list->regionStart[modifiedCell]; index < list->regionStart[modifiedCell + 1]; ++index) {
+
+        const Constraint* constraint = &list->constraints[list->regionIndices[index]];
+        const Region* region = &constraint->region;
+        RegionConstraintUpdate regionFunc = constraint->funcs.regionUpdate;
+        BinaryConstraintUpdate updaterFunc = constraint->funcs.binaryConstraint;
+        unsigned int regIndex = 0;
+
+        /* Update the whole region in one pass where the constraint supports it */
+        if (regionFunc != NULL) {
+            RegionMask updated = regionFunc(pzl->grid, region, modifiedLoc);
+            if (updated != 0) changed = true;
+
+            /* Queue each changed square */
+            for (regIndex = 0; updated != 0; ++regIndex, updated >>= 1) {
+                if (updated & 1) {
+                    QueueCell(queue, region->cells[regIndex]);
+                    ReportChange(delta, region->cells[regIndex]);
                 }
             }
+
+            continue;
+        }
+
+        /* Move through each square of the region */
+        for (regIndex = 0; regIndex < region->regionSize; ++regIndex) {
+
+            /* Update the domain */
+            if (updaterFunc(pzl->grid, region->locations[regIndex], modifiedLoc)) {
+
+                /* And queue the square if the domain is changed */
+                QueueCell(queue, region->cells[regIndex]);
+                ReportChange(delta, region->cells[regIndex]);
+                changed = true;
+            }
+        }
+    }
+
+    if ((list->neighbours != NULL) && (squares[modifiedCell].value != VALUE_NONE)) {
+        for (index = list->neighbourStart[modifiedCell]; index < list->neighbourStart[modifiedCell + 1]; ++index) {
+            GridSquare* neighbour = &squares[list->neighbours[index]];
+
+            if ((neighbour->value == VALUE_NONE) && DomRemoveElement(&neighbour->domain, squares[modifiedCell].value)) {
+                QueueCell(queue, list->neighbours[index]);
+                ReportChange(delta, list->neighbours[index]);
+                changed = true;
+            }
         }
     }
+
+    return changed;
 }
 
 /*
-** Implements the AC3 algorithm.
+** Arc consistency propagator. Assigns each fixed square its value and updates
+** the domains of the squares sharing a region with it or neighbouring it.
+** Squares fixed by the update are handled in turn, so the propagator is
+** idempotent.
+**
+** AC3 uses the specialised version in AC3Solver9.c for 9x9 puzzles instead.
 */
-static bool AC3(SudokuPuzzle* pzl)
+static PropagateResult ArcConsistency(SudokuPuzzle* pzl, const PropagationDelta* delta)
 {
-    bool success = true;
-    GridLocationSet* locationSet = NULL;
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const unsigned int numSquares = gridOrder * gridOrder;
+    GridSquare* squares = GetSquares(pzl->grid);
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    CellQueue* queue = NULL;
+    unsigned int index = 0;
 
     assert(pzl != NULL);
 
-    if (!GLSCreate(&locationSet)) return false;
-
-    PopulateSet(locationSet, pzl);
+    /* Run on its own, without a queue there's no deduction to make */
+    queue = (CellQueue*)((delta != NULL) ? delta->state : CreateCellQueue(pzl));
+    if (queue == NULL) return PROPAGATE_NO_CHANGE;
+    assert(queue->numQueued == 0);
 
-    while ((!GLSIsEmpty(locationSet)) && (success == true)) {
-        GridLocation location = { 0,0 };
-        GridSquare* square = NULL;
+    if (delta != NULL) {
+        for (index = 0; index < delta->numFixed; ++index) {
+            QueueCell(queue, (CellIndex)(delta->fixed[index].row * gridOrder + delta->fixed[index].col));
+        }
+    }
+    else {
+        for (index = 0; index < numSquares; ++index) {
+            if (DomIsSingletonDomain(squares[index].domain)) QueueCell(queue, (CellIndex)index);
+        }
+    }
 
-        GLSPop(locationSet, &location);
-        square = GetSquare(pzl->grid, location.row, location.col);
-        assert(square != NULL);
+    while ((queue->numQueued > 0) && (result != PROPAGATE_CONTRADICTION)) {
+        const CellIndex cell = PopCell(queue);
+        GridSquare* square = &squares[cell];
 
         /* If domain is empty, this square has no possible values */
-        if (DomIsEmptyDomain(square->domain)) success = false;
+        if (DomIsEmptyDomain(square->domain)) result = PROPAGATE_CONTRADICTION;
 
         /* If domain is singleton, we've reduced the number of possible values to one */
         if (DomIsSingletonDomain(square->domain)) {
@@ -138,15 +240,293 @@ static bool AC3(SudokuPuzzle* pzl)
             square->value = DomGetLSValue(square->domain);
 
             /* and update the affected squares */
-            UpdateAffectedSquares(location, pzl, locationSet);
+            if (UpdateAffectedSquares(cell, pzl, queue, delta)) result = PROPAGATE_CHANGED;
+        }
+    }
+
+    /* Leave the queue empty for the next run */
+    while (queue->numQueued > 0) PopCell(queue);
+
+    if (delta == NULL) DestroyCellQueue(queue);
+    return result;
+}
+
+/*
+** Hidden singles propagator. Finds values that can only be placed in a single
+** square of a changed region. The domain of that square is reduced to the
+** single value.
+**
+** Candidate positions are counted with bitmasks: a value is in seenOnce if it
+** is in the domain of at least one square of the region, and in seenTwice if
+** it's in the domain of at least two.
+**
+** Only regions with one square for every square value are considered, as
+** every value must appear in such a region exactly once.
+**
+** Returns PROPAGATE_CONTRADICTION if a region has a value that can't be
+** placed in any square.
+**
+** AC3 uses the specialised version in AC3Solver9.c for 9x9 puzzles instead.
+*/
+static PropagateResult HiddenSingles(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    const Constraint* constraints = pzl->uniqueValue->constraints;
+    const unsigned int numConstraints = pzl->uniqueValue->numConstraints;
+    const unsigned int numValues = GetGridOrder(pzl->grid);
+    GridSquare* squares = GetSquares(pzl->grid);
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int index = 0;
+
+    for (index = 0; index < numConstraints; ++index) {
+        const CellIndex* cells = constraints[index].region.cells;
+        const unsigned int regionSize = constraints[index].region.regionSize;
+        Domain seenOnce = DomCreate(VALUE_1, numValues, false);
+        Domain seenTwice = seenOnce;
+        Domain hiddenSingles = seenOnce;
+        unsigned int regIndex = 0;
+
+        if (regionSize != numValues) continue;
+        if ((delta != NULL) && !delta->changedRegions[index]) continue;
+
+        for (regIndex = 0; regIndex < regionSize; ++regIndex) {
+            const GridSquare* square = &squares[cells[regIndex]];
+
+            seenTwice = DomUnion(seenTwice, DomIntersection(seenOnce, square->domain));
+            seenOnce = DomUnion(seenOnce, square->domain);
+        }
+
+        /* A value with no possible square means there's no solution */
+        if (!DomIsFullDomain(seenOnce)) return PROPAGATE_CONTRADICTION;
+
+        hiddenSingles = DomDifference(seenOnce, seenTwice);
+
+        while (!DomIsEmptyDomain(hiddenSingles)) {
+            const SquareValue value = DomPopLSValue(&hiddenSingles);
+
+            /* Find the one square that can hold value */
+            for (regIndex = 0; regIndex < regionSize; ++regIndex) {
+                GridSquare* square = &squares[cells[regIndex]];
+
+                if (!DomContainsElement(square->domain, value)) continue;
+
+                /* Squares with a singleton domain are assigned or already fixed */
+                if (!DomIsSingletonDomain(square->domain)) {
+                    DomSetEmpty(&square->domain);
+                    DomAddElement(&square->domain, value);
+                    ReportChange(delta, cells[regIndex]);
+                    result = PROPAGATE_CHANGED;
+                }
+
+                break;
+            }
         }
     }
 
-    GLSDestroy(&locationSet);
+    return result;
+}
+
+/* The propagators every AC3 solver starts with */
+static const Propagator arcConsistencyPropagator = { ArcConsistency, EVENT_VALUE_FIXED, PROPAGATOR_COST_LOW, true, CreateCellQueue, DestroyCellQueue };
+static const Propagator hiddenSinglesPropagator = { HiddenSingles, EVENT_REGION_CHANGED, PROPAGATOR_COST_LOW, false, NULL, NULL };
+static const Propagator arcConsistency9Propagator = { ArcConsistency9, EVENT_VALUE_FIXED, PROPAGATOR_COST_LOW, true, NULL, NULL };
+static const Propagator hiddenSingles9Propagator = { HiddenSingles9, EVENT_REGION_CHANGED, PROPAGATOR_COST_LOW, false, NULL, NULL };
+
+static ProbeBudget probeBudget = {
+    20000,      /* maxRuns */
+    0           /* maxTime */
+};
+
+ProbeBudget GetProbeBudget(void)
+{
+    return probeBudget;
+}
+
+void SetProbeBudget(const ProbeBudget budget)
+{
+    probeBudget = budget;
+}
+
+/*
+** Helper functions for Probe. Copy every square to or from the snapshot.
+*/
+static void SaveSnapshot(SudokuPuzzle* pzl, GridSquare* snapshot)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    memcpy(snapshot, GetSquares(pzl->grid), gridOrder * gridOrder * sizeof(GridSquare));
+}
+
+static void RestoreSnapshot(SudokuPuzzle* pzl, const GridSquare* snapshot)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    memcpy(GetSquares(pzl->grid), snapshot, gridOrder * gridOrder * sizeof(GridSquare));
+}
+
+/*
+** Singleton arc consistency. Each value of each open square is assigned in
+** turn and propagated with the engine's propagators. A value that leads to a
+** contradiction is removed and the removal propagated. A value that leads to
+** a solution is kept. Passes over the grid repeat until no value is removed
+** or the probe budget is spent.
+**
+** The engine must be at fixpoint. The grid is restored from a single
+** snapshot after each probe.
+*/
+static PropagateResult Probe(SudokuPuzzle* pzl, PropagationEngine engine)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const unsigned long startRuns = GetEngineStats(engine).numRuns;
+    const clock_t startTime = clock();
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    GridSquare* snapshot = NULL;
+    bool removed = true;
+    bool budgetSpent = false;
+
+    snapshot = (GridSquare*)malloc(gridOrder * gridOrder * sizeof(GridSquare));
+    if (snapshot == NULL) return PROPAGATE_NO_CHANGE;
+
+    SaveSnapshot(pzl, snapshot);
+
+    while (removed && !budgetSpent && (result != PROPAGATE_CONTRADICTION)) {
+        unsigned int index = 0;
+
+        removed = false;
+
+        for (index = 0; (index < gridOrder * gridOrder) && !budgetSpent && (result != PROPAGATE_CONTRADICTION); ++index) {
+            GridSquare* square = &GetSquares(pzl->grid)[index];
+            Domain candidates = square->domain;
+
+            while ((square->value == VALUE_NONE) && !DomIsEmptyDomain(candidates)) {
+                const SquareValue value = DomPopLSValue(&candidates);
+                PropagateResult probeResult = PROPAGATE_NO_CHANGE;
+
+                budgetSpent = ((probeBudget.maxRuns > 0) && (GetEngineStats(engine).numRuns - startRuns >= probeBudget.maxRuns)) ||
+                    ((probeBudget.maxTime > 0) && (clock() - startTime >= probeBudget.maxTime)) || isSudokuCancelled(pzl);
+                if (budgetSpent) break;
+
+                DomSetEmpty(&square->domain);
+                DomAddElement(&square->domain, value);
+                ReportEngineChange(engine, (CellIndex)index);
+                probeResult = RunPropagationEngine(engine);
+
+                /* Lucky probe */
+                if ((probeResult != PROPAGATE_CONTRADICTION) && isSudokuComplete(pzl) && isSudokuValid(pzl)) {
+                    free(snapshot);
+                    return PROPAGATE_CHANGED;
+                }
+
+                RestoreSnapshot(pzl, snapshot);
+                ResetPropagationEngine(engine);
+
+                if (probeResult != PROPAGATE_CONTRADICTION) continue;
+
+                DomRemoveElement(&square->domain, value);
+                ReportEngineChange(engine, (CellIndex)index);
+                removed = true;
+                result = PROPAGATE_CHANGED;
+
+                if (RunPropagationEngine(engine) == PROPAGATE_CONTRADICTION) {
+                    result = PROPAGATE_CONTRADICTION;
+                    break;
+                }
+
+                SaveSnapshot(pzl, snapshot);
+                candidates = DomIntersection(candidates, square->domain);
+            }
+        }
+    }
+
+    free(snapshot);
+    return result;
+}
+
+/*
+** Implements the AC3 algorithm with the propagation engine. Arc consistency
+** and hidden singles are run to fixpoint before any of the additional
+** propagators, which are scheduled by cost tier. See PropagationEngine.h.
+** 9x9 puzzles get the specialised arc consistency and hidden singles of
+** AC3Solver9.c, chosen once here rather than on every run. Puzzles with
+** Killer cages also get the cage propagator.
+**
+** If probe is true, singleton arc consistency is then enforced within the
+** probe budget.
+*/
+static bool AC3(SudokuPuzzle* pzl, const PropagatorList* propagators, const bool probe, EngineStats* stats)
+{
+    PropagationEngine engine = NULL;
+    bool sudoku9 = false;
+    bool success = false;
+
+    assert(pzl != NULL);
+
+    InitializeDomains(pzl);
+
+    if (!CreatePropagationEngine(&engine, pzl)) return false;
+
+    sudoku9 = IsSudoku9(pzl);
+    if (AddPropagator(engine, sudoku9 ? &arcConsistency9Propagator : &arcConsistencyPropagator) &&
+        AddPropagator(engine, sudoku9 ? &hiddenSingles9Propagator : &hiddenSinglesPropagator) &&
+        ((pzl->cages == NULL) || AddPropagator(engine, &killerCagePropagator)) &&
+        ((propagators == NULL) || AddPropagators(engine, propagators))) {
+        /* Cage sums restrict domains before any square changes, so the cages are pruned once up front */
+        success = ((pzl->cages == NULL) || (KillerCages(pzl, NULL) != PROPAGATE_CONTRADICTION)) &&
+            (RunPropagationEngine(engine) != PROPAGATE_CONTRADICTION);
+        if (success && probe && !isSudokuComplete(pzl)) success = (Probe(pzl, engine) != PROPAGATE_CONTRADICTION);
+    }
+
+    if (stats != NULL) *stats = GetEngineStats(engine);
+
+    DestroyPropagationEngine(&engine);
     return success;
 }
 
+/* Propagators used by AC3SubsetSolver, cheapest first */
+static const Propagator* const subsetPropagatorDefs[] = { &lockedCandidatesPropagator, &nakedSubsetsPropagator, &hiddenSubsetsPropagator };
+static const PropagatorList subsetPropagators = { subsetPropagatorDefs, sizeof(subsetPropagatorDefs) / sizeof(subsetPropagatorDefs[0]) };
+
+/* Propagators used by AC3FishSolver, cheapest first */
+static const Propagator* const fishPropagatorDefs[] = { &lockedCandidatesPropagator, &nakedSubsetsPropagator, &hiddenSubsetsPropagator, &fishPropagator };
+static const PropagatorList fishPropagators = { fishPropagatorDefs, sizeof(fishPropagatorDefs) / sizeof(fishPropagatorDefs[0]) };
+
+/* Propagators used by AC3ChainSolver, cheapest first */
+static const Propagator* const chainPropagatorDefs[] = { &lockedCandidatesPropagator, &nakedSubsetsPropagator, &hiddenSubsetsPropagator, &fishPropagator,
+    &simpleColoringPropagator, &xyChainsPropagator, &forcingChainsPropagator };
+static const PropagatorList chainPropagators = { chainPropagatorDefs, sizeof(chainPropagatorDefs) / sizeof(chainPropagatorDefs[0]) };
+
+/* Propagators used by AC3AllDifferentSolver, cheapest first */
+static const Propagator* const allDifferentPropagatorDefs[] = { &lockedCandidatesPropagator, &allDifferentPropagator };
+static const PropagatorList allDifferentPropagators = { allDifferentPropagatorDefs, sizeof(allDifferentPropagatorDefs) / sizeof(allDifferentPropagatorDefs[0]) };
+
 bool AC3Solver(SudokuPuzzle* pzl)
 {
-    return AC3(pzl);
+    return AC3(pzl, NULL, false, NULL);
+}
+
+bool AC3PropagatorSolver(SudokuPuzzle* pzl, const PropagatorList* propagators, EngineStats* stats)
+{
+    return AC3(pzl, propagators, false, stats);
+}
+
+bool AC3SubsetSolver(SudokuPuzzle* pzl)
+{
+    return AC3(pzl, &subsetPropagators, false, NULL);
+}
+
+bool AC3FishSolver(SudokuPuzzle* pzl)
+{
+    return AC3(pzl, &fishPropagators, false, NULL);
+}
+
+bool AC3ChainSolver(SudokuPuzzle* pzl)
+{
+    return AC3(pzl, &chainPropagators, false, NULL);
+}
+
+bool AC3AllDifferentSolver(SudokuPuzzle* pzl)
+{
+    return AC3(pzl, &allDifferentPropagators, false, NULL);
+}
+
+bool AC3ProbeSolver(SudokuPuzzle* pzl)
+{
+    return AC3(pzl, &subsetPropagators, true, NULL);
 }
\ No newline at end of file
@@ -32,6 +32,9 @@
 #define AC3SOLVER_H
 
 #include "..\SudokuSolver.h"
+#include "../Propagators/PropagationEngine.h"
+
+#include <time.h>
 
 /*
 ** Solves a sudoku using the AC-3 (arc consistency) algorithm. This is a
@@ -41,4 +44,64 @@
 */
 bool AC3Solver(SudokuPuzzle* pzl);
 
+/*
+** As AC3Solver, with the propagators in the list added to the propagation
+** engine. Arc consistency and hidden singles run to fixpoint first; the
+** added propagators are then woken by the changes they subscribe to and run
+** cheapest tier first, until no propagator can reduce a domain.
+**
+** propagators may be NULL, in which case this is equivalent to AC3Solver.
+** If stats isn't NULL, it's set to the work done by the engine.
+*/
+bool AC3PropagatorSolver(SudokuPuzzle* pzl, const PropagatorList* propagators, EngineStats* stats);
+
+/*
+** AC3PropagatorSolver with the subset and intersection propagators in
+** SubsetPropagator.h.
+*/
+bool AC3SubsetSolver(SudokuPuzzle* pzl);
+
+/*
+** AC3SubsetSolver with the fish propagator in FishPropagator.h added.
+*/
+bool AC3FishSolver(SudokuPuzzle* pzl);
+
+/*
+** AC3FishSolver with the chain propagators in ChainPropagator.h added.
+*/
+bool AC3ChainSolver(SudokuPuzzle* pzl);
+
+/*
+** AC3PropagatorSolver with locked candidates and the all-different propagator
+** in AllDifferentPropagator.h, which prunes each region to generalized arc
+** consistency.
+*/
+bool AC3AllDifferentSolver(SudokuPuzzle* pzl);
+
+/*
+** Budget for singleton arc consistency probing. Zero means no limit.
+**
+**  maxRuns - Maximum number of propagator runs while probing.
+**
+**  maxTime - Maximum processor time spent probing, in clock ticks.
+*/
+typedef struct {
+    unsigned long maxRuns;
+    clock_t maxTime;
+} ProbeBudget;
+
+/*
+** Gets or sets the budget used by AC3ProbeSolver.
+*/
+ProbeBudget GetProbeBudget(void);
+void SetProbeBudget(const ProbeBudget budget);
+
+/*
+** AC3SubsetSolver followed by singleton arc consistency probing. Each value
+** of each open square is assigned in turn and propagated; values leading to
+** a contradiction are removed. Probing stops when a full pass removes
+** nothing, the probe budget is spent or the puzzle is cancelled.
+*/
+bool AC3ProbeSolver(SudokuPuzzle* pzl);
+
 #endif // !AC3SOLVER_H
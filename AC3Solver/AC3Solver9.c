@@ -0,0 +1,206 @@
+/*
+** AC3Solver9.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "AC3Solver9.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+enum {
+    ORDER9 = 9,
+    SQUARES9 = ORDER9 * ORDER9
+};
+
+/* Every value of a 9x9 domain, which fits in the first word */
+#define FULL9 ((DomWord)0x1FF)
+
+/* Domain bit of a square value */
+#define VALUE_BIT9(value) ((DomWord)0x1 << ((value) - VALUE_1))
+
+/*
+** A 9x9 domain uses only its first word, so the fast path works on that word
+** directly.
+*/
+#define MASK9(square) ((square)->domain.words[0])
+
+static bool IsSingleton9(const DomWord mask)
+{
+    return (mask != 0) && ((mask & (mask - 1)) == 0);
+}
+
+static SquareValue MaskValue9(const DomWord mask)
+{
+    SquareValue value = VALUE_1;
+
+    while (!(mask & VALUE_BIT9(value))) ++value;
+    return value;
+}
+
+bool IsSudoku9(const SudokuPuzzle* pzl)
+{
+    const ConstraintList* list = NULL;
+    unsigned int index = 0;
+
+    assert(pzl != NULL);
+
+    list = pzl->uniqueValue;
+    if ((GetGridOrder(pzl->grid) != ORDER9) || (list->peers == NULL)) return false;
+
+    /* Every region must hold each value once */
+    for (index = 0; index < list->numConstraints; ++index) {
+        if (list->constraints[index].region.regionSize != ORDER9) return false;
+        if (list->constraints[index].funcs.regionUpdate != GetUniqueValueFuncs().regionUpdate) return false;
+    }
+
+    return true;
+}
+
+PropagateResult ArcConsistency9(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    const unsigned int* peerStart = pzl->uniqueValue->peerStart;
+    const CellIndex* peers = pzl->uniqueValue->peers;
+    GridSquare* squares = GetSquares(pzl->grid);
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    CellIndex queue[SQUARES9];
+    bool queued[SQUARES9] = { false };
+    unsigned int numQueued = 0;
+    unsigned int index = 0;
+
+    assert(GetGridOrder(pzl->grid) == ORDER9);
+
+    if (delta != NULL) {
+        for (index = 0; index < delta->numFixed; ++index) {
+            const CellIndex cell = (CellIndex)(delta->fixed[index].row * ORDER9 + delta->fixed[index].col);
+
+            if (!queued[cell]) {
+                queued[cell] = true;
+                queue[numQueued++] = cell;
+            }
+        }
+    }
+    else {
+        for (index = 0; index < SQUARES9; ++index) {
+            if (IsSingleton9(MASK9(&squares[index]))) {
+                queued[index] = true;
+                queue[numQueued++] = (CellIndex)index;
+            }
+        }
+    }
+
+    while (numQueued > 0) {
+        const CellIndex cell = queue[--numQueued];
+        GridSquare* square = &squares[cell];
+        DomWord bit = 0;
+
+        queued[cell] = false;
+
+        /* If domain is empty, this square has no possible values */
+        if (MASK9(square) == 0) return PROPAGATE_CONTRADICTION;
+        if (!IsSingleton9(MASK9(square))) continue;
+
+        square->value = MaskValue9(MASK9(square));
+        bit = MASK9(square);
+
+        /* Remove the value from every open peer and queue the peers changed */
+        for (index = peerStart[cell]; index < peerStart[cell + 1]; ++index) {
+            const CellIndex peer = peers[index];
+            GridSquare* peerSquare = &squares[peer];
+
+            if ((peerSquare->value != VALUE_NONE) || !(MASK9(peerSquare) & bit)) continue;
+
+            MASK9(peerSquare) &= ~bit;
+            ReportChange(delta, peer);
+            result = PROPAGATE_CHANGED;
+
+            if (!queued[peer]) {
+                queued[peer] = true;
+                queue[numQueued++] = peer;
+            }
+        }
+    }
+
+    return result;
+}
+
+PropagateResult HiddenSingles9(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    const ConstraintList* list = pzl->uniqueValue;
+    GridSquare* squares = GetSquares(pzl->grid);
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int region = 0;
+
+    assert(GetGridOrder(pzl->grid) == ORDER9);
+
+    for (region = 0; region < list->numConstraints; ++region) {
+        const CellIndex* cells = list->constraints[region].region.cells;
+        DomWord seenOnce = 0;
+        DomWord seenTwice = 0;
+        DomWord hiddenSingles = 0;
+        unsigned int position = 0;
+
+        if ((delta != NULL) && !delta->changedRegions[region]) continue;
+
+        for (position = 0; position < ORDER9; ++position) {
+            const DomWord mask = MASK9(&squares[cells[position]]);
+
+            seenTwice |= seenOnce & mask;
+            seenOnce |= mask;
+        }
+
+        /* A value with no possible square means there's no solution */
+        if (seenOnce != FULL9) return PROPAGATE_CONTRADICTION;
+
+        hiddenSingles = seenOnce & ~seenTwice;
+
+        while (hiddenSingles != 0) {
+            const DomWord bit = hiddenSingles & (~hiddenSingles + 1);
+
+            hiddenSingles &= ~bit;
+
+            /* Find the one square that can hold the value */
+            for (position = 0; position < ORDER9; ++position) {
+                GridSquare* square = &squares[cells[position]];
+
+                if (!(MASK9(square) & bit)) continue;
+
+                /* Squares with a singleton domain are assigned or already fixed */
+                if (!IsSingleton9(MASK9(square))) {
+                    MASK9(square) = bit;
+                    ReportChange(delta, cells[position]);
+                    result = PROPAGATE_CHANGED;
+                }
+
+                break;
+            }
+        }
+    }
+
+    return result;
+}
\ No newline at end of file
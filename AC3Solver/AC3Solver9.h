@@ -0,0 +1,61 @@
+/*
+** AC3Solver9.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef AC3SOLVER9_H
+#define AC3SOLVER9_H
+
+#include "../Propagators/Propagator.h"
+
+#include <stdbool.h>
+
+/*
+** Arc consistency and hidden singles specialised for 9x9 sudoku. Loops over
+** region squares have constant trip counts, domains are read as a single
+** 9-bit mask, and the peers of each square come from the compiled constraint
+** list, so jigsaw layouts take the same path as the standard one.
+**
+** The results are the same as the generic propagators in AC3Solver.c. AC3
+** adds these in their place when IsSudoku9 is true.
+*/
+
+/*
+** Returns true if the puzzle is a 9x9 grid whose uniqueValue constraints are
+** all compiled unique value regions of 9 squares.
+*/
+bool IsSudoku9(const SudokuPuzzle* pzl);
+
+/*
+** Propagators for puzzles where IsSudoku9 is true. See ArcConsistency
+** and HiddenSingles in AC3Solver.c.
+*/
+PropagateResult ArcConsistency9(SudokuPuzzle* pzl, const PropagationDelta* delta);
+PropagateResult HiddenSingles9(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+#endif // !AC3SOLVER9_H
@@ -0,0 +1,155 @@
+/*
+** AdaptiveSolver.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "AdaptiveSolver.h"
+#include "../AC3Solver/AC3Solver.h"
+#include "../BacktrackSolver/BacktrackSolver.h"
+#include "../BackjumpSolver/BackjumpSolver.h"
+
+#include <assert.h>
+
+/* Largest grid order searched with BacktrackSolver and given the small grid thresholds */
+#define MAX_SMALL_GRID_ORDER 9
+
+enum {
+    SMALL_GRID_THRESHOLDS,
+    LARGE_GRID_THRESHOLDS,
+    NUM_GRID_THRESHOLDS
+};
+
+static AdaptiveThresholds adaptiveThresholds[NUM_GRID_THRESHOLDS] = {
+    /* On 9x9 grids: search at 29 open squares or fewer, probe at 40 or more, and search above 72 */
+    {
+        36,     /* searchOpen */
+        49,     /* probeOpen */
+        90      /* maxProbeOpen */
+    },
+    /* On 16x16 grids: search at 92 open squares or fewer, subsets and then probing from 93 to 115, and search above 115 */
+    {
+        36,     /* searchOpen */
+        100,    /* probeOpen */
+        45      /* maxProbeOpen */
+    }
+};
+
+/*
+** Returns the index of the thresholds for grids of gridOrder.
+*/
+static unsigned int ThresholdsIndex(const unsigned int gridOrder)
+{
+    return (gridOrder > MAX_SMALL_GRID_ORDER) ? LARGE_GRID_THRESHOLDS : SMALL_GRID_THRESHOLDS;
+}
+
+AdaptiveThresholds GetAdaptiveThresholds(const unsigned int gridOrder)
+{
+    return adaptiveThresholds[ThresholdsIndex(gridOrder)];
+}
+
+void SetAdaptiveThresholds(const unsigned int gridOrder, const AdaptiveThresholds thresholds)
+{
+    adaptiveThresholds[ThresholdsIndex(gridOrder)] = thresholds;
+}
+
+/*
+** Searches for whatever squares are still open. Large grids are searched
+** with BackjumpSolver, which doesn't stall in the dead ends BacktrackSolver
+** retries every decision to get out of.
+*/
+static bool SearchStage(SudokuPuzzle* pzl)
+{
+    if (GetGridOrder(pzl->grid) > MAX_SMALL_GRID_ORDER) return BackjumpSolver(pzl);
+
+    return BacktrackSolver(pzl);
+}
+
+/*
+** Returns the number of squares without a value.
+*/
+static unsigned int CountOpenSquares(const SudokuPuzzle* pzl)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const GridSquare* squares = GetSquares(pzl->grid);
+    unsigned int numOpen = 0;
+    unsigned int cell = 0;
+
+    for (cell = 0; cell < gridOrder * gridOrder; ++cell) {
+        if (squares[cell].value == VALUE_NONE) ++numOpen;
+    }
+
+    return numOpen;
+}
+
+bool AdaptiveStageSolver(SudokuPuzzle* pzl, AdaptiveStage* stage)
+{
+    AdaptiveThresholds thresholds;
+    unsigned int numSquares = 0;
+    unsigned int numOpen = 0;
+
+    assert((pzl != NULL) && (stage != NULL));
+
+    *stage = ADAPTIVE_STAGE_AC3;
+    if (!AC3Solver(pzl)) return false;
+    if (isSudokuComplete(pzl)) return true;
+
+    thresholds = GetAdaptiveThresholds(GetGridOrder(pzl->grid));
+
+    /* Open squares are compared as percentages of the grid, scaled by 100 to stay in integers */
+    numSquares = GetGridOrder(pzl->grid) * GetGridOrder(pzl->grid);
+    numOpen = CountOpenSquares(pzl) * 100;
+
+    if (numOpen > thresholds.maxProbeOpen * numSquares) {
+        *stage = ADAPTIVE_STAGE_SEARCH;
+        return SearchStage(pzl);
+    }
+
+    if ((numOpen > thresholds.searchOpen * numSquares) && (numOpen < thresholds.probeOpen * numSquares)) {
+        *stage = ADAPTIVE_STAGE_SUBSETS;
+        if (!AC3SubsetSolver(pzl)) return false;
+        if (isSudokuComplete(pzl)) return true;
+
+        numOpen = CountOpenSquares(pzl) * 100;
+    }
+
+    if (numOpen > thresholds.searchOpen * numSquares) {
+        *stage = ADAPTIVE_STAGE_PROBE;
+        if (!AC3ProbeSolver(pzl)) return false;
+        if (isSudokuComplete(pzl)) return true;
+    }
+
+    *stage = ADAPTIVE_STAGE_SEARCH;
+    return SearchStage(pzl);
+}
+
+bool AdaptiveSolver(SudokuPuzzle* pzl)
+{
+    AdaptiveStage stage = ADAPTIVE_STAGE_AC3;
+
+    return AdaptiveStageSolver(pzl, &stage);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+** AdaptiveSolver.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef ADAPTIVESOLVER_H
+#define ADAPTIVESOLVER_H
+
+#include "../SudokuSolver.h"
+
+#include <stdbool.h>
+
+/*
+** Solves a sudoku by escalating from cheap engines to expensive ones, only as
+** far as the puzzle needs:
+**
+**  1. AC3Solver. Puzzles it completes never pay for stronger propagation or
+**     search setup.
+**
+**  2. AC3SubsetSolver, if AC3 leaves more than searchOpen but fewer than
+**     probeOpen percent of the squares open.
+**
+**  3. AC3ProbeSolver, if more than searchOpen percent are still open. A puzzle
+**     AC3 leaves with probeOpen percent or more open comes here straight away.
+**
+**  4. BacktrackSolver for whatever squares are still open, or BackjumpSolver
+**     on grids larger than 9x9.
+**
+** A puzzle AC3 leaves with more than maxProbeOpen percent of its squares open
+** has so few clues that probing prunes little for what it costs, so it goes
+** straight to search. On large grids the search can run into dead ends deep
+** in the tree, which BackjumpSolver jumps back from instead of retrying every
+** decision in between.
+**
+** Escalation is decided from the open squares left by each stage, checked
+** with isSudokuComplete first, against the thresholds for the grid's order.
+*/
+bool AdaptiveSolver(SudokuPuzzle* pzl);
+
+/*
+** Stages of AdaptiveSolver, cheapest first.
+*/
+typedef enum {
+    ADAPTIVE_STAGE_AC3,
+    ADAPTIVE_STAGE_SUBSETS,
+    ADAPTIVE_STAGE_PROBE,
+    ADAPTIVE_STAGE_SEARCH,
+    NUM_ADAPTIVE_STAGES
+} AdaptiveStage;
+
+/*
+** As AdaptiveSolver, and sets stage to the last stage run. Used by the
+** benchmark harness to see where puzzles are solved.
+*/
+bool AdaptiveStageSolver(SudokuPuzzle* pzl, AdaptiveStage* stage);
+
+/*
+** Thresholds used by AdaptiveSolver, each a percentage of the grid's squares
+** left open.
+**
+**  searchOpen - Search starts once no more than this many squares are open.
+**
+**  probeOpen - If AC3 leaves at least this many squares open, subset
+**              propagation is skipped and probing starts straight away.
+**
+**  maxProbeOpen - If AC3 leaves more than this many squares open, search
+**                 starts straight away.
+**
+** 9x9 and smaller grids share one set of thresholds, and larger grids another:
+** probing a large grid costs far more, so it pays off on fewer puzzles. The
+** large grid probeOpen is above maxProbeOpen, so large grids never skip the
+** subset stage: a puzzle open enough to skip it goes straight to search. The
+** defaults come from the escalation report in main.c (ESCALATION).
+*/
+typedef struct {
+    unsigned int searchOpen;
+    unsigned int probeOpen;
+    unsigned int maxProbeOpen;
+} AdaptiveThresholds;
+
+/*
+** Gets or sets the thresholds used by AdaptiveSolver for grids of gridOrder.
+*/
+AdaptiveThresholds GetAdaptiveThresholds(const unsigned int gridOrder);
+void SetAdaptiveThresholds(const unsigned int gridOrder, const AdaptiveThresholds thresholds);
+
+#endif // !ADAPTIVESOLVER_H
@@ -0,0 +1,544 @@
+/*
+** BackjumpSolver.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "BackjumpSolver.h"
+
+#include "../common/Domain.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static BackjumpPolicy backjumpPolicy = {
+    3,          /* maxNogoodSize */
+    4096        /* maxNogoods */
+};
+
+BackjumpPolicy GetBackjumpPolicy(void)
+{
+    return backjumpPolicy;
+}
+
+void SetBackjumpPolicy(const BackjumpPolicy policy)
+{
+    backjumpPolicy = policy;
+}
+
+/* Results of BackjumpSearch other than the depth to jump back to */
+#define SEARCH_SOLVED UINT_MAX
+#define SEARCH_CANCELLED (UINT_MAX - 1)
+
+/* Marks the end of a list of nogood occurrences */
+#define NO_OCCURRENCE UINT_MAX
+
+/* Sets of decision depths have one bit per depth */
+typedef uint64_t DepthWord;
+#define DEPTH_WORD_BITS 64
+
+typedef struct {
+    CellIndex cell;
+    SquareValue value;
+} Assignment;
+
+/*
+** State of the search. Decisions are numbered by depth from 1; depth 0 stands
+** for the givens and anything deduced before the search.
+**
+**  openCells - Cells without a value when the search started.
+**
+**  domains - Values each cell may still take given the decisions so far.
+**
+**  prunedBy - Depth of the decision that removed value v from cell's domain
+**             is prunedBy[cell * numValues + v]. Only meaningful while v is
+**             missing from the domain.
+**
+**  trail, trailStart - Values removed from domains, in order. Those removed
+**                      by the decision at depth d start at trailStart[d].
+**
+**  deadEnds - Times each cell has been left with no values. Ties between
+**             cells with the fewest values go to the cell with the most.
+**
+**  decisions, depthOf - Cell assigned at each depth, and depth at which each
+**                       cell was assigned or 0.
+**
+**  conflicts - Earlier decisions blamed for the dead ends found below each
+**              depth, in sets of depthWords words.
+**
+**  nogoods, nogoodSizes - Recorded nogood n is nogoodSizes[n] assignments
+**                         from nogoods[n * policy.maxNogoodSize].
+**
+**  occurrenceStart, occurrenceNext, occurrenceNogood - The nogoods holding
+**      value v of cell form a list starting at occurrenceStart[cell *
+**      numValues + v].
+*/
+typedef struct {
+    SudokuPuzzle* pzl;
+    GridSquare* squares;
+    const ConstraintList* list;
+    unsigned int numValues;
+    CellIndex* openCells;
+    unsigned int numOpen;
+    unsigned int depthWords;
+    Domain* domains;
+    uint16_t* prunedBy;
+    Assignment* trail;
+    unsigned int trailSize;
+    unsigned int* trailStart;
+    unsigned long* deadEnds;
+    CellIndex* decisions;
+    uint16_t* depthOf;
+    DepthWord* conflicts;
+    BackjumpPolicy policy;
+    Assignment* nogoods;
+    unsigned int* nogoodSizes;
+    unsigned int numNogoods;
+    unsigned int* occurrenceStart;
+    unsigned int* occurrenceNext;
+    unsigned int* occurrenceNogood;
+    unsigned int numOccurrences;
+    unsigned long numNodes;
+} BackjumpInfo;
+
+/*
+** Returns the set of decisions blamed for the dead ends below depth.
+*/
+static DepthWord* ConflictSet(const BackjumpInfo* info, const unsigned int depth)
+{
+    return &info->conflicts[depth * info->depthWords];
+}
+
+static void AddDepth(DepthWord* set, const unsigned int depth)
+{
+    set[depth / DEPTH_WORD_BITS] |= (DepthWord)1 << (depth % DEPTH_WORD_BITS);
+}
+
+/*
+** Returns the deepest decision in set, or 0 if it's empty.
+*/
+static unsigned int LatestDepth(const BackjumpInfo* info, const DepthWord* set)
+{
+    unsigned int word = info->depthWords;
+
+    while (word-- > 0) {
+        DepthWord bits = set[word];
+        unsigned int depth = word * DEPTH_WORD_BITS;
+
+        if (bits == 0) continue;
+
+        while (bits >>= 1) ++depth;
+        return depth;
+    }
+
+    return 0;
+}
+
+/*
+** Adds to set the decisions that removed values from cell's domain, other
+** than the decision at depth.
+*/
+static void BlameRemovals(const BackjumpInfo* info, DepthWord* set, const CellIndex cell, const unsigned int depth)
+{
+    SquareValue value = VALUE_NONE;
+
+    for (value = VALUE_1; value < info->numValues; ++value) {
+        const unsigned int prunedBy = info->prunedBy[cell * info->numValues + value];
+
+        if (DomContainsElement(info->domains[cell], value) || (prunedBy == 0) || (prunedBy == depth)) continue;
+        AddDepth(set, prunedBy);
+    }
+}
+
+/*
+** Removes value from the domain of each blank peer of cell. If a peer is left
+** with no values, the decisions that removed them are blamed and false is
+** returned. Either way, the removals are undone by UndoRemovals.
+*/
+static bool ForwardCheck(BackjumpInfo* info, const CellIndex cell, const SquareValue value, const unsigned int depth)
+{
+    unsigned int index = 0;
+
+    for (index = info->list->peerStart[cell]; index < info->list->peerStart[cell + 1]; ++index) {
+        const CellIndex peer = info->list->peers[index];
+        Assignment* removal = NULL;
+
+        if ((info->squares[peer].value != VALUE_NONE) || !DomRemoveElement(&info->domains[peer], value)) continue;
+
+        info->prunedBy[peer * info->numValues + value] = (uint16_t)depth;
+        removal = &info->trail[info->trailSize++];
+        removal->cell = peer;
+        removal->value = value;
+
+        if (DomIsEmptyDomain(info->domains[peer])) {
+            ++info->deadEnds[peer];
+            BlameRemovals(info, ConflictSet(info, depth), peer, depth);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+** Restores the values removed by the decision at depth.
+*/
+static void UndoRemovals(BackjumpInfo* info, const unsigned int depth)
+{
+    while (info->trailSize > info->trailStart[depth]) {
+        const Assignment* removal = &info->trail[--info->trailSize];
+
+        DomAddElement(&info->domains[removal->cell], removal->value);
+    }
+}
+
+/*
+** Returns true if a Killer cage holding cell is broken by the value just given
+** to it, and blames the decisions that assigned the cage's other squares.
+*/
+static bool CageConflict(const BackjumpInfo* info, const CellIndex cell, const unsigned int depth)
+{
+    const ConstraintList* cages = info->pzl->cages;
+    unsigned int index = 0;
+
+    if (cages == NULL) return false;
+    assert(cages->regionStart != NULL);
+
+    for (index = cages->regionStart[cell]; index < cages->regionStart[cell + 1]; ++index) {
+        const Constraint* cage = &cages->constraints[cages->regionIndices[index]];
+        unsigned int position = 0;
+
+        if (cage->funcs.validationFunc(info->pzl->grid, cage)) continue;
+
+        for (position = 0; position < cage->region.regionSize; ++position) {
+            const CellIndex member = cage->region.cells[position];
+
+            if ((member != cell) && (info->depthOf[member] != 0)) AddDepth(ConflictSet(info, depth), info->depthOf[member]);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/*
+** Returns true if giving value to cell would complete a recorded nogood, and
+** blames the decisions that made its other assignments.
+*/
+static bool NogoodConflict(const BackjumpInfo* info, const CellIndex cell, const SquareValue value, const unsigned int depth)
+{
+    unsigned int occurrence = info->occurrenceStart[cell * info->numValues + value];
+
+    for (; occurrence != NO_OCCURRENCE; occurrence = info->occurrenceNext[occurrence]) {
+        const unsigned int nogood = info->occurrenceNogood[occurrence];
+        const Assignment* assignments = &info->nogoods[nogood * info->policy.maxNogoodSize];
+        unsigned int index = 0;
+
+        for (index = 0; index < info->nogoodSizes[nogood]; ++index) {
+            const CellIndex other = assignments[index].cell;
+
+            if (other == cell) continue;
+            if ((info->depthOf[other] == 0) || (info->squares[other].value != assignments[index].value)) break;
+        }
+
+        if (index < info->nogoodSizes[nogood]) continue;
+
+        for (index = 0; index < info->nogoodSizes[nogood]; ++index) {
+            if (assignments[index].cell != cell) AddDepth(ConflictSet(info, depth), info->depthOf[assignments[index].cell]);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/*
+** Records the decisions in set, which can't all hold in a solution, as a
+** nogood if it's small enough and there's room.
+*/
+static void RecordNogood(BackjumpInfo* info, const DepthWord* set)
+{
+    Assignment* assignments = NULL;
+    unsigned int size = 0;
+    unsigned int word = 0;
+
+    if (info->numNogoods >= info->policy.maxNogoods) return;
+
+    for (word = 0; word < info->depthWords; ++word) {
+        DepthWord bits = set[word];
+
+        for (; bits != 0; bits &= bits - 1) {
+            if (++size > info->policy.maxNogoodSize) return;
+        }
+    }
+
+    assignments = &info->nogoods[info->numNogoods * info->policy.maxNogoodSize];
+    size = 0;
+
+    for (word = 0; word < info->depthWords; ++word) {
+        unsigned int bit = 0;
+
+        for (bit = 0; bit < DEPTH_WORD_BITS; ++bit) {
+            CellIndex cell = 0;
+            unsigned int literal = 0;
+
+            if ((set[word] & ((DepthWord)1 << bit)) == 0) continue;
+
+            cell = info->decisions[word * DEPTH_WORD_BITS + bit];
+            assignments[size].cell = cell;
+            assignments[size].value = info->squares[cell].value;
+            ++size;
+
+            literal = cell * info->numValues + info->squares[cell].value;
+            info->occurrenceNogood[info->numOccurrences] = info->numNogoods;
+            info->occurrenceNext[info->numOccurrences] = info->occurrenceStart[literal];
+            info->occurrenceStart[literal] = info->numOccurrences++;
+        }
+    }
+
+    info->nogoodSizes[info->numNogoods++] = size;
+}
+
+/*
+** Assigns the blank square with the fewest values left at depth and searches
+** on from there.
+**
+** Returns SEARCH_SOLVED with the grid complete, SEARCH_CANCELLED, or the depth
+** to jump back to with the grid as it was. Depth 0 means there's no solution.
+*/
+static unsigned int BackjumpSearch(BackjumpInfo* info, const unsigned int depth)
+{
+    DepthWord* conflicts = ConflictSet(info, depth);
+    GridSquare* square = NULL;
+    Domain values = { 0 };
+    CellIndex cell = 0;
+    unsigned int fewest = UINT_MAX;
+    unsigned int jump = 0;
+    unsigned int index = 0;
+
+    /* Branch on the blank square with the fewest values left, then the most dead ends */
+    for (index = 0; index < info->numOpen; ++index) {
+        const CellIndex openCell = info->openCells[index];
+        unsigned int count = 0;
+
+        if (info->squares[openCell].value != VALUE_NONE) continue;
+
+        count = DomNumElements(info->domains[openCell]);
+        if ((count < fewest) || ((count == fewest) && (info->deadEnds[openCell] > info->deadEnds[cell]))) {
+            cell = openCell;
+            fewest = count;
+        }
+    }
+
+    /* Forward checking keeps peers apart and each value was checked against its cages */
+    if (fewest == UINT_MAX) return SEARCH_SOLVED;
+
+    for (index = 0; index < info->depthWords; ++index) conflicts[index] = 0;
+
+    square = &info->squares[cell];
+    values = info->domains[cell];
+    info->decisions[depth] = cell;
+    info->depthOf[cell] = (uint16_t)depth;
+    info->trailStart[depth] = info->trailSize;
+
+    while (!DomIsEmptyDomain(values)) {
+        const SquareValue value = DomPopLSValue(&values);
+
+        if (isSudokuCancelled(info->pzl)) {
+            info->depthOf[cell] = 0;
+            return SEARCH_CANCELLED;
+        }
+
+        ++info->numNodes;
+        if (NogoodConflict(info, cell, value, depth)) continue;
+
+        square->value = value;
+
+        if (!CageConflict(info, cell, depth) && ForwardCheck(info, cell, value, depth)) {
+            jump = BackjumpSearch(info, depth + 1);
+            if (jump == SEARCH_SOLVED) return SEARCH_SOLVED;
+        }
+        else {
+            jump = depth;
+        }
+
+        UndoRemovals(info, depth);
+        square->value = VALUE_NONE;
+
+        /* A deeper dead end was blamed on an earlier decision, so trying other values here can't help */
+        if (jump != depth) {
+            info->depthOf[cell] = 0;
+            return jump;
+        }
+    }
+
+    info->depthOf[cell] = 0;
+    ++info->deadEnds[cell];
+
+    /* Every value failed, so this square's dead end is down to the decisions that ruled each one out */
+    BlameRemovals(info, conflicts, cell, depth);
+    jump = LatestDepth(info, conflicts);
+
+    if (jump > 0) {
+        DepthWord* target = ConflictSet(info, jump);
+
+        RecordNogood(info, conflicts);
+
+        for (index = 0; index < info->depthWords; ++index) target[index] |= conflicts[index];
+        target[jump / DEPTH_WORD_BITS] &= ~((DepthWord)1 << (jump % DEPTH_WORD_BITS));
+    }
+
+    return jump;
+}
+
+/*
+** Frees the storage of the search state.
+*/
+static void FreeBackjumpInfo(BackjumpInfo* info)
+{
+    free(info->openCells);
+    free(info->domains);
+    free(info->prunedBy);
+    free(info->trail);
+    free(info->trailStart);
+    free(info->deadEnds);
+    free(info->decisions);
+    free(info->depthOf);
+    free(info->conflicts);
+    free(info->nogoods);
+    free(info->nogoodSizes);
+    free(info->occurrenceStart);
+    free(info->occurrenceNext);
+    free(info->occurrenceNogood);
+}
+
+/*
+** Allocates the search state and sets each blank square's domain to the
+** values its assigned peers leave it. Returns false if memory can't be
+** allocated.
+*/
+static bool InitBackjumpInfo(BackjumpInfo* info, SudokuPuzzle* pzl, const BackjumpPolicy* policy)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const unsigned int numSquares = gridOrder * gridOrder;
+    unsigned int maxOccurrences = 0;
+    unsigned int cell = 0;
+    unsigned int index = 0;
+
+    info->pzl = pzl;
+    info->squares = GetSquares(pzl->grid);
+    info->list = pzl->uniqueValue;
+    info->numValues = gridOrder + 1;
+    info->policy = *policy;
+    if (info->policy.maxNogoodSize == 0) info->policy.maxNogoods = 0;
+    maxOccurrences = info->policy.maxNogoods * info->policy.maxNogoodSize;
+
+    info->openCells = (CellIndex*)malloc(numSquares * sizeof(CellIndex));
+    if (info->openCells == NULL) return false;
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        if (info->squares[cell].value == VALUE_NONE) info->openCells[info->numOpen++] = (CellIndex)cell;
+    }
+
+    /* Depths run from 0 to one past the last blank square */
+    info->depthWords = (info->numOpen + 1) / DEPTH_WORD_BITS + 1;
+
+    info->domains = (Domain*)malloc(numSquares * sizeof(Domain));
+    info->prunedBy = (uint16_t*)calloc(numSquares * info->numValues, sizeof(uint16_t));
+    info->trail = (Assignment*)malloc(numSquares * gridOrder * sizeof(Assignment));
+    info->trailStart = (unsigned int*)malloc((info->numOpen + 2) * sizeof(unsigned int));
+    info->deadEnds = (unsigned long*)calloc(numSquares, sizeof(unsigned long));
+    info->decisions = (CellIndex*)malloc((info->numOpen + 2) * sizeof(CellIndex));
+    info->depthOf = (uint16_t*)calloc(numSquares, sizeof(uint16_t));
+    info->conflicts = (DepthWord*)malloc((info->numOpen + 2) * info->depthWords * sizeof(DepthWord));
+    info->nogoods = (Assignment*)malloc((maxOccurrences + 1) * sizeof(Assignment));
+    info->nogoodSizes = (unsigned int*)malloc((info->policy.maxNogoods + 1) * sizeof(unsigned int));
+    info->occurrenceStart = (unsigned int*)malloc(numSquares * info->numValues * sizeof(unsigned int));
+    info->occurrenceNext = (unsigned int*)malloc((maxOccurrences + 1) * sizeof(unsigned int));
+    info->occurrenceNogood = (unsigned int*)malloc((maxOccurrences + 1) * sizeof(unsigned int));
+
+    if ((info->domains == NULL) || (info->prunedBy == NULL) || (info->trail == NULL) || (info->trailStart == NULL) ||
+        (info->deadEnds == NULL) || (info->decisions == NULL) || (info->depthOf == NULL) || (info->conflicts == NULL) || (info->nogoods == NULL) ||
+        (info->nogoodSizes == NULL) || (info->occurrenceStart == NULL) || (info->occurrenceNext == NULL) || (info->occurrenceNogood == NULL)) {
+        return false;
+    }
+
+    for (index = 0; index < numSquares * info->numValues; ++index) info->occurrenceStart[index] = NO_OCCURRENCE;
+
+    /* Values ruled out by the givens are removed before the search, at depth 0 */
+    for (index = 0; index < info->numOpen; ++index) {
+        unsigned int peerIndex = 0;
+
+        cell = info->openCells[index];
+        info->domains[cell] = info->squares[cell].domain;
+
+        for (peerIndex = info->list->peerStart[cell]; peerIndex < info->list->peerStart[cell + 1]; ++peerIndex) {
+            const SquareValue value = info->squares[info->list->peers[peerIndex]].value;
+
+            if (value != VALUE_NONE) DomRemoveElement(&info->domains[cell], value);
+        }
+    }
+
+    return true;
+}
+
+/*
+** Initializes the search state and starts the search. If numNodes isn't NULL,
+** it's set to the number of values tried.
+*/
+static bool Backjump(SudokuPuzzle* pzl, unsigned long* numNodes)
+{
+    const BackjumpPolicy policy = backjumpPolicy;
+    BackjumpInfo info = { NULL };
+    bool success = false;
+
+    assert(pzl != NULL);
+
+    /* Givens that break a rule can't be fixed by the search */
+    if (InitBackjumpInfo(&info, pzl, &policy) && isSudokuValid(pzl)) {
+        success = (BackjumpSearch(&info, 1) == SEARCH_SOLVED);
+    }
+
+    if (numNodes != NULL) *numNodes = info.numNodes;
+    FreeBackjumpInfo(&info);
+    return success;
+}
+
+bool BackjumpSolver(SudokuPuzzle* pzl)
+{
+    return Backjump(pzl, NULL);
+}
+
+bool BackjumpCountingSolver(SudokuPuzzle* pzl, unsigned long* numNodes)
+{
+    assert(numNodes != NULL);
+    return Backjump(pzl, numNodes);
+}
\ No newline at end of file
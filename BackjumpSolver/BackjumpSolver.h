@@ -0,0 +1,86 @@
+/*
+** BackjumpSolver.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef BACKJUMPSOLVER_H
+#define BACKJUMPSOLVER_H
+
+#include "..\SudokuSolver.h"
+
+#include <stdbool.h>
+
+/*
+** Solves the Sudoku by backtracking with forward checking and conflict-directed
+** backjumping.
+**
+** Each assignment removes its value from the domains of the square's blank
+** peers, and the search branches on the blank square with the fewest values
+** left, breaking ties by the dead ends each square has caused. Every value
+** removed is tagged with the decision that removed it, so when a square runs
+** out of values the search knows which earlier decisions are to blame. It jumps
+** straight back to the deepest of them, skipping any decisions in between that
+** had nothing to do with the dead end. The set of blamed decisions is a nogood:
+** those assignments can't all hold in a solution. Small nogoods are recorded
+** and checked before each later assignment (see BackjumpPolicy).
+**
+** Only values remaining in each square's domain are tried, so domain
+** reduction performed before the search (e.g., by AC3Solver) prunes the
+** search tree.
+**
+** Returns false if the puzzle has no solution or is cancelled.
+*/
+bool BackjumpSolver(SudokuPuzzle* pzl);
+
+/*
+** As BackjumpSolver, and sets numNodes to the number of values tried during
+** the search.
+*/
+bool BackjumpCountingSolver(SudokuPuzzle* pzl, unsigned long* numNodes);
+
+/*
+** Nogood recording policy for BackjumpSolver.
+**
+**  maxNogoodSize - Largest nogood recorded, in assignments. Larger nogoods
+**                  are rarely met again and cost more to check. Zero
+**                  records none.
+**
+**  maxNogoods - Most nogoods recorded in one search. Later ones are dropped.
+*/
+typedef struct {
+    unsigned int maxNogoodSize;
+    unsigned int maxNogoods;
+} BackjumpPolicy;
+
+/*
+** Gets or sets the policy used by BackjumpSolver.
+*/
+BackjumpPolicy GetBackjumpPolicy(void);
+void SetBackjumpPolicy(const BackjumpPolicy policy);
+
+#endif // !BACKJUMPSOLVER_H
@@ -30,7 +30,12 @@
 
 #include "BacktrackSolver.h"
 
+#include "../common/Domain.h"
+
 #include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
 
 #define GET_GRID_ROW(squareIndex, gridOrder) ((squareIndex) / (gridOrder))
 #define GET_GRID_COL(squareIndex, gridOrder) ((squareIndex) % (gridOrder))
@@ -41,15 +46,90 @@ typedef struct {
     Grid grid;
     unsigned int gridOrder;
     unsigned int numSquares;
+    bool lcvOrdering;
+    unsigned long numNodes;
 } PuzzleInfo;
 
+/*
+** Counts the blank squares sharing a region with location whose domain still
+** contains value. Squares sharing more than one region are counted once per
+** region.
+*/
+static unsigned int CountConstrainedPeers(const PuzzleInfo* const pzlInfo, const GridLocation location, const SquareValue value)
+{
+    const ConstraintList* list = pzlInfo->pzl->uniqueValue;
+    const GridSquare* squares = GetSquares(pzlInfo->grid);
+    const CellIndex cell = (CellIndex)(location.row * pzlInfo->gridOrder + location.col);
+    unsigned int numPeers = 0;
+    unsigned int index = 0;
+
+    for (index = list->regionStart[cell]; index < list->regionStart[cell + 1]; ++index) {
+        const Region* region = &list->constraints[list->regionIndices[index]].region;
+        unsigned int regIndex = 0;
+
+        for (regIndex = 0; regIndex < region->regionSize; ++regIndex) {
+            const GridSquare* peer = NULL;
+
+            if (region->cells[regIndex] == cell) continue;
+
+            peer = &squares[region->cells[regIndex]];
+            if ((peer->value == VALUE_NONE) && DomContainsElement(peer->domain, value)) ++numPeers;
+        }
+    }
+
+    return numPeers;
+}
+
+/*
+** Fills values with the members of the square's domain in the order they
+** should be tried and returns the number of values.
+**
+** Values are in ascending order unless least-constraining-value ordering is
+** enabled, in which case values that rule out the fewest options for peer
+** squares are tried first.
+*/
+static unsigned int OrderValues(const PuzzleInfo* const pzlInfo, const unsigned int sqrDepth, const GridSquare* const square, SquareValue values[numSquareValues])
+{
+    const GridLocation location = { GET_GRID_ROW(sqrDepth, pzlInfo->gridOrder), GET_GRID_COL(sqrDepth, pzlInfo->gridOrder) };
+    unsigned int numConstrained[numSquareValues] = { 0 };
+    Domain candidates = square->domain;
+    unsigned int numValues = 0;
+    unsigned int index = 0;
+
+    while (!DomIsEmptyDomain(candidates)) {
+        values[numValues++] = DomPopLSValue(&candidates);
+    }
+
+    if (!pzlInfo->lcvOrdering || (numValues < 2)) return numValues;
+
+    /* Insertion sort by number of constrained peers, ties keep ascending order */
+    for (index = 0; index < numValues; ++index) {
+        const SquareValue value = values[index];
+        const unsigned int count = CountConstrainedPeers(pzlInfo, location, value);
+        unsigned int sortIndex = index;
+
+        while ((sortIndex > 0) && (numConstrained[sortIndex - 1] > count)) {
+            values[sortIndex] = values[sortIndex - 1];
+            numConstrained[sortIndex] = numConstrained[sortIndex - 1];
+            --sortIndex;
+        }
+
+        values[sortIndex] = value;
+        numConstrained[sortIndex] = count;
+    }
+
+    return numValues;
+}
+
 /*
 ** Accomplishes the work of the bactracking search.
 */
-static bool BacktrackSearch(const PuzzleInfo* const pzlInfo, const unsigned int sqrDepth)
+static bool BacktrackSearch(PuzzleInfo* const pzlInfo, const unsigned int sqrDepth)
 {
     GridSquare* square = NULL;
-    SquareValue testValue = VALUE_1;
+    SquareValue testValues[numSquareValues] = { VALUE_NONE };
+    unsigned int numValues = 0;
+    unsigned int index = 0;
 
     /* We've reached the end--time to test if we've found a solution! */
     if (sqrDepth >= pzlInfo->numSquares) {
@@ -57,17 +137,20 @@ static bool BacktrackSearch(const PuzzleInfo* const pzlInfo, const unsigned int
         return isSudokuValid(pzlInfo->pzl);
     }
 
-    square = GetSquare(pzlInfo->grid, GET_GRID_ROW(sqrDepth, pzlInfo->gridOrder), GET_GRID_COL(sqrDepth, pzlInfo->gridOrder));
-    assert(square != NULL);
+    square = &GetSquares(pzlInfo->grid)[sqrDepth];
 
     /* If this square already has a value, move to the next one */
     if (square->value != VALUE_NONE) {
         return BacktrackSearch(pzlInfo, sqrDepth + 1);
     }
 
-    /* Otherwise, we need to test each value in turn */
-    for (testValue = VALUE_1; testValue < numSquareValues; ++testValue) {
-        square->value = testValue;
+    if (isSudokuCancelled(pzlInfo->pzl)) return false;
+
+    /* Otherwise, we need to test each value remaining in the domain in turn */
+    numValues = OrderValues(pzlInfo, sqrDepth, square, testValues);
+    for (index = 0; index < numValues; ++index) {
+        square->value = testValues[index];
+        ++pzlInfo->numNodes;
 
         /* If grid is valid with testValue, move to next square */
         if (isSudokuValid(pzlInfo->pzl) && BacktrackSearch(pzlInfo, sqrDepth + 1)) return true;
@@ -78,9 +161,14 @@ static bool BacktrackSearch(const PuzzleInfo* const pzlInfo, const unsigned int
     return false;
 }
 
-bool BacktrackSolver(SudokuPuzzle* pzl)
+/*
+** Initializes the PuzzleInfo structure and starts the search. If numNodes
+** isn't NULL, it's set to the number of values tried.
+*/
+static bool Backtrack(SudokuPuzzle* pzl, const bool lcvOrdering, unsigned long* numNodes)
 {
     PuzzleInfo pzlInfo = { NULL };
+    bool success = false;
 
     assert(pzl != NULL);
 
@@ -88,6 +176,285 @@ bool BacktrackSolver(SudokuPuzzle* pzl)
     pzlInfo.grid = pzl->grid;
     pzlInfo.gridOrder = GetGridOrder(pzlInfo.grid);
     pzlInfo.numSquares = pzlInfo.gridOrder * pzlInfo.gridOrder;
+    pzlInfo.lcvOrdering = lcvOrdering;
+    pzlInfo.numNodes = 0;
+
+    success = BacktrackSearch(&pzlInfo, 0);
+
+    if (numNodes != NULL) *numNodes = pzlInfo.numNodes;
+    return success;
+}
+
+static RestartPolicy restartPolicy = {
+    RESTART_LUBY,   /* schedule */
+    1000,           /* baseNodes */
+    150,            /* growthPercent */
+    1,              /* seed */
+    true            /* keepConflicts */
+};
+
+RestartPolicy GetRestartPolicy(void)
+{
+    return restartPolicy;
+}
+
+void SetRestartPolicy(const RestartPolicy policy)
+{
+    assert(policy.baseNodes > 0);
+    assert((policy.schedule != RESTART_GEOMETRIC) || (policy.growthPercent > 100));
+
+    restartPolicy = policy;
+}
+
+/* Outcome of one run of the restart search */
+typedef enum {
+    SEARCH_SOLVED,
+    SEARCH_FAILED,
+    SEARCH_RESTART
+} SearchResult;
+
+/*
+** State of BacktrackRestartSolver.
+**
+**  openCells - Cells without a value when the search started.
+**
+**  conflicts - Dead ends caused by each cell: times it was left with no
+**              values.
+**
+**  random - State of the xorshift random number generator.
+*/
+typedef struct {
+    SudokuPuzzle* pzl;
+    GridSquare* squares;
+    const ConstraintList* list;
+    CellIndex* openCells;
+    unsigned int numOpen;
+    unsigned long* conflicts;
+    unsigned long numNodes;
+    unsigned long nodeLimit;
+    uint64_t random;
+} RestartInfo;
+
+/*
+** Returns the next number from the xorshift64* generator.
+*/
+static uint64_t NextRandom(RestartInfo* info)
+{
+    info->random ^= info->random >> 12;
+    info->random ^= info->random << 25;
+    info->random ^= info->random >> 27;
+    return info->random * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+** Returns element i (from 1) of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+*/
+static unsigned long Luby(unsigned long i)
+{
+    unsigned long size = 1;
+
+    /* Find the smallest complete subsequence, of length 2^k - 1, holding i */
+    while (size < i) size = size * 2 + 1;
+
+    /* i ends the subsequence, or lies in the copy of the previous one before it */
+    while (size != i) {
+        size /= 2;
+        if (i > size) i -= size;
+    }
+
+    return (size + 1) / 2;
+}
+
+/*
+** Returns the budget of values tried before restart number run (from 1).
+*/
+static unsigned long RestartBudget(const RestartPolicy* policy, const unsigned long run, const unsigned long lastBudget)
+{
+    if (policy->schedule == RESTART_LUBY) {
+        const unsigned long luby = Luby(run);
+        return (luby > ULONG_MAX / policy->baseNodes) ? ULONG_MAX : luby * policy->baseNodes;
+    }
 
-    return BacktrackSearch(&pzlInfo, 0);
+    if (run == 1) return policy->baseNodes;
+    if (lastBudget > ULONG_MAX / policy->growthPercent) return ULONG_MAX;
+
+    /* Always grow by at least one, so small budgets don't stall */
+    return (lastBudget * policy->growthPercent / 100 > lastBudget) ? lastBudget * policy->growthPercent / 100 : lastBudget + 1;
+}
+
+/*
+** Returns the values of cell's domain not held by any of its peers.
+*/
+static Domain CellCandidates(const RestartInfo* info, const CellIndex cell)
+{
+    Domain candidates = info->squares[cell].domain;
+    unsigned int index = 0;
+
+    for (index = info->list->peerStart[cell]; index < info->list->peerStart[cell + 1]; ++index) {
+        const SquareValue value = info->squares[info->list->peers[index]].value;
+
+        if (value != VALUE_NONE) DomRemoveElement(&candidates, value);
+    }
+
+    return candidates;
+}
+
+/*
+** One run of the restart search, from the current grid.
+**
+** Returns SEARCH_SOLVED with the grid complete, SEARCH_FAILED with the grid
+** unchanged if there's no solution from here, or SEARCH_RESTART with the grid
+** unchanged if the run's budget is spent or the puzzle is cancelled.
+*/
+static SearchResult RestartSearch(RestartInfo* info)
+{
+    SquareValue values[numSquareValues] = { VALUE_NONE };
+    Domain candidates = { 0 };
+    GridSquare* square = NULL;
+    CellIndex bestCell = 0;
+    unsigned int bestCount = UINT_MAX;
+    unsigned int numTies = 0;
+    unsigned int numValues = 0;
+    unsigned int index = 0;
+
+    /* Choose the open cell with the fewest candidates, then the most conflicts, then at random */
+    for (index = 0; index < info->numOpen; ++index) {
+        const CellIndex cell = info->openCells[index];
+        Domain cellCandidates = { 0 };
+        unsigned int count = 0;
+
+        if (info->squares[cell].value != VALUE_NONE) continue;
+
+        cellCandidates = CellCandidates(info, cell);
+        count = DomNumElements(cellCandidates);
+
+        if (count == 0) {
+            ++info->conflicts[cell];
+            return SEARCH_FAILED;
+        }
+
+        if ((count < bestCount) || ((count == bestCount) && (info->conflicts[cell] > info->conflicts[bestCell]))) {
+            bestCell = cell;
+            bestCount = count;
+            candidates = cellCandidates;
+            numTies = 1;
+        }
+        else if ((count == bestCount) && (info->conflicts[cell] == info->conflicts[bestCell]) && (NextRandom(info) % ++numTies == 0)) {
+            bestCell = cell;
+            candidates = cellCandidates;
+        }
+    }
+
+    /* Every cell has a value, and peers never share one, so only cages are left to check */
+    if (bestCount == UINT_MAX) return ((info->pzl->cages == NULL) || ConstraintsMet(info->pzl->cages, info->pzl->grid)) ? SEARCH_SOLVED : SEARCH_FAILED;
+
+    while (!DomIsEmptyDomain(candidates)) values[numValues++] = DomPopLSValue(&candidates);
+
+    /* Shuffle the values */
+    for (index = numValues; index > 1; --index) {
+        const unsigned int swapIndex = (unsigned int)(NextRandom(info) % index);
+        const SquareValue value = values[index - 1];
+
+        values[index - 1] = values[swapIndex];
+        values[swapIndex] = value;
+    }
+
+    square = &info->squares[bestCell];
+    for (index = 0; index < numValues; ++index) {
+        SearchResult result = SEARCH_FAILED;
+
+        if ((++info->numNodes > info->nodeLimit) || isSudokuCancelled(info->pzl)) {
+            square->value = VALUE_NONE;
+            return SEARCH_RESTART;
+        }
+
+        square->value = values[index];
+
+        if ((info->pzl->cages == NULL) || ConstraintsMet(info->pzl->cages, info->pzl->grid)) {
+            result = RestartSearch(info);
+
+            if (result == SEARCH_SOLVED) return SEARCH_SOLVED;
+            if (result == SEARCH_RESTART) {
+                square->value = VALUE_NONE;
+                return SEARCH_RESTART;
+            }
+        }
+    }
+
+    square->value = VALUE_NONE;
+    return SEARCH_FAILED;
+}
+
+/*
+** Runs the restart search with budgets from the policy until a run solves
+** the puzzle or proves it has no solution.
+*/
+static bool BacktrackRestart(SudokuPuzzle* pzl, const RestartPolicy* policy)
+{
+    const unsigned int numSquares = GetGridOrder(pzl->grid) * GetGridOrder(pzl->grid);
+    RestartInfo info = { NULL };
+    SearchResult result = SEARCH_RESTART;
+    unsigned long run = 0;
+    unsigned int cell = 0;
+
+    info.pzl = pzl;
+    info.squares = GetSquares(pzl->grid);
+    info.list = pzl->uniqueValue;
+    info.openCells = (CellIndex*)malloc(numSquares * sizeof(CellIndex));
+    info.conflicts = (unsigned long*)calloc(numSquares, sizeof(unsigned long));
+
+    /* A zero state would only ever give zeros */
+    info.random = ((uint64_t)policy->seed * 0x9E3779B97F4A7C15ULL) | 1;
+
+    if ((info.openCells == NULL) || (info.conflicts == NULL)) {
+        free(info.openCells);
+        free(info.conflicts);
+        return false;
+    }
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        if (info.squares[cell].value == VALUE_NONE) info.openCells[info.numOpen++] = (CellIndex)cell;
+    }
+
+    /* Givens that break a rule can't be fixed by the search */
+    if (!isSudokuValid(pzl)) result = SEARCH_FAILED;
+
+    while ((result == SEARCH_RESTART) && !isSudokuCancelled(pzl)) {
+        info.nodeLimit = RestartBudget(policy, ++run, info.nodeLimit);
+        info.numNodes = 0;
+
+        if (!policy->keepConflicts) {
+            for (cell = 0; cell < numSquares; ++cell) info.conflicts[cell] = 0;
+        }
+
+        result = RestartSearch(&info);
+    }
+
+    free(info.openCells);
+    free(info.conflicts);
+    return (result == SEARCH_SOLVED);
+}
+
+bool BacktrackSolver(SudokuPuzzle* pzl)
+{
+    return Backtrack(pzl, false, NULL);
+}
+
+bool BacktrackLCVSolver(SudokuPuzzle* pzl)
+{
+    return Backtrack(pzl, true, NULL);
+}
+
+bool BacktrackCountingSolver(SudokuPuzzle* pzl, unsigned long* numNodes)
+{
+    assert(numNodes != NULL);
+    return Backtrack(pzl, false, numNodes);
+}
+
+bool BacktrackRestartSolver(SudokuPuzzle* pzl)
+{
+    const RestartPolicy policy = restartPolicy;
+
+    assert(pzl != NULL);
+    return BacktrackRestart(pzl, &policy);
 }
\ No newline at end of file
@@ -36,8 +36,80 @@
 #include <stdbool.h>
 
 /*
-** Solves the Sudoku using a backtracking algorithm.
+** Solves the Sudoku using a backtracking algorithm. Only values remaining in
+** each square's domain are tried, so any domain reduction performed before
+** the search (e.g., by AC3Solver) prunes the search tree.
+**
+** Returns false if the puzzle is cancelled before a solution is found.
 */
 bool BacktrackSolver(SudokuPuzzle* pzl);
 
+/*
+** As BacktrackSolver, but values are tried in least-constraining-value order:
+** values that remain in the fewest domains of blank squares sharing a region
+** are tried first.
+*/
+bool BacktrackLCVSolver(SudokuPuzzle* pzl);
+
+/*
+** As BacktrackSolver, and sets numNodes to the number of values tried during
+** the search. Used to measure how much search a propagator saves.
+*/
+bool BacktrackCountingSolver(SudokuPuzzle* pzl, unsigned long* numNodes);
+
+/*
+** Searches with randomised restarts, to cut off the long runs a fixed search
+** order takes on some puzzles.
+**
+** Each square is chosen by the fewest values left after removing those of
+** its peers, then by the most dead ends it has caused, with remaining ties
+** broken at random. Its values are tried in random order. The search restarts
+** from the initial grid whenever it has tried a budget of values, set by the
+** restart policy's schedule. Budgets grow without bound, so the search is
+** still complete: it returns false only if the puzzle has no solution or is
+** cancelled.
+*/
+bool BacktrackRestartSolver(SudokuPuzzle* pzl);
+
+/*
+** Schedules of restart budgets.
+**
+**  RESTART_LUBY - baseNodes times the Luby sequence 1, 1, 2, 1, 1, 2, 4, 1,
+**                 ... which wastes at most a logarithmic factor over the
+**                 best fixed budget for any puzzle.
+**
+**  RESTART_GEOMETRIC - baseNodes, growing by growthPercent each restart.
+*/
+typedef enum {
+    RESTART_LUBY,
+    RESTART_GEOMETRIC
+} RestartSchedule;
+
+/*
+** Restart policy for BacktrackRestartSolver.
+**
+**  schedule, baseNodes, growthPercent - Budget of values tried between
+**                                       restarts; see RestartSchedule.
+**                                       growthPercent must be over 100.
+**
+**  seed - Seed for the random choices. The same seed gives the same search.
+**
+**  keepConflicts - If true, the dead ends each square has caused are kept
+**                  across restarts, so later runs branch on the squares
+**                  found hard earlier. Otherwise each run starts afresh.
+*/
+typedef struct {
+    RestartSchedule schedule;
+    unsigned long baseNodes;
+    unsigned int growthPercent;
+    unsigned long seed;
+    bool keepConflicts;
+} RestartPolicy;
+
+/*
+** Gets or sets the policy used by BacktrackRestartSolver.
+*/
+RestartPolicy GetRestartPolicy(void);
+void SetRestartPolicy(const RestartPolicy policy);
+
 #endif // !BACKTRACKSOLVER_H
@@ -0,0 +1,496 @@
+/*
+** CanonicalForm.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "CanonicalForm.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    CANON_BOX_ORDER = 3,
+    NUM_COLUMN_ORDERS = 6 * 6 * 6 * 6,
+    BLANK_RANK = CANON_ORDER + 1,
+    INITIAL_BEAM_SIZE = 64,
+    MAX_BEAM_SIZE = 8192
+};
+
+/* The orders of three things */
+static const uint8_t orders3[6][CANON_BOX_ORDER] = {
+    { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+};
+
+/* Every order of the columns keeping stacks together, created when first needed */
+static uint8_t columnOrders[NUM_COLUMN_ORDERS][CANON_ORDER];
+static bool columnOrdersBuilt = false;
+
+/*
+** A partial transform: the first rows of the canonical form have been chosen
+** from the puzzle, and its column order is fixed. labels numbers the values
+** read so far, and nextLabel is the number of the next new value.
+*/
+typedef struct {
+    bool transposed;
+    uint8_t rows[CANON_ORDER];
+    uint16_t columnOrder;
+    uint8_t labels[CANON_ORDER + 1];
+    uint8_t nextLabel;
+} CanonState;
+
+/*
+** The partial transforms giving the least rows found so far.
+*/
+typedef struct {
+    CanonState* states;
+    unsigned int numStates;
+    unsigned int capacity;
+} CanonBeam;
+
+/*****************************************************************************/
+/* Helper functions                                                          */
+/*****************************************************************************/
+
+/*
+** Fills in columnOrders: each order of the stacks with each order of the
+** columns within each stack. Not thread safe.
+*/
+static void BuildColumnOrders(void)
+{
+    unsigned int index = 0;
+    unsigned int stacks = 0;
+    unsigned int within = 0;
+
+    for (stacks = 0; stacks < 6; ++stacks) {
+        for (within = 0; within < 6 * 6 * 6; ++within) {
+            const unsigned int withinStack[CANON_BOX_ORDER] = { within / 36, (within / 6) % 6, within % 6 };
+            unsigned int stack = 0;
+            unsigned int position = 0;
+
+            for (stack = 0; stack < CANON_BOX_ORDER; ++stack) {
+                for (position = 0; position < CANON_BOX_ORDER; ++position) {
+                    columnOrders[index][stack * CANON_BOX_ORDER + position] = (uint8_t)(orders3[stacks][stack] * CANON_BOX_ORDER + orders3[withinStack[stack]][position]);
+                }
+            }
+
+            ++index;
+        }
+    }
+
+    columnOrdersBuilt = true;
+}
+
+/*
+** Returns the value at row, col of the puzzle, or of its transpose.
+*/
+static uint8_t SourceValue(const uint8_t puzzle[CANON_SQUARES], const bool transposed, const unsigned int row, const unsigned int col)
+{
+    return transposed ? puzzle[col * CANON_ORDER + row] : puzzle[row * CANON_ORDER + col];
+}
+
+/*
+** Returns true if no value repeats in a row, column or box, and every value is
+** in range.
+*/
+static bool ValuesUnique(const uint8_t puzzle[CANON_SQUARES])
+{
+    unsigned int line = 0;
+
+    for (line = 0; line < CANON_ORDER; ++line) {
+        unsigned int seen[3] = { 0 };
+        unsigned int position = 0;
+
+        for (position = 0; position < CANON_ORDER; ++position) {
+            const uint8_t values[3] = {
+                puzzle[line * CANON_ORDER + position],
+                puzzle[position * CANON_ORDER + line],
+                puzzle[((line / CANON_BOX_ORDER) * CANON_BOX_ORDER + position / CANON_BOX_ORDER) * CANON_ORDER + (line % CANON_BOX_ORDER) * CANON_BOX_ORDER + position % CANON_BOX_ORDER]
+            };
+            unsigned int kind = 0;
+
+            /* Row, column and box; blanks may repeat */
+            for (kind = 0; kind < 3; ++kind) {
+                if (values[kind] > CANON_ORDER) return false;
+                if (values[kind] == 0) continue;
+                if (seen[kind] & (1u << values[kind])) return false;
+
+                seen[kind] |= 1u << values[kind];
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+** Returns the least blank pattern any column order gives a row of the puzzle,
+** with bit 8 - n set if column n is blank: stacks with more values first, and
+** values before blanks within each stack.
+*/
+static unsigned int LeastBlankPattern(const uint8_t puzzle[CANON_SQUARES], const bool transposed, const unsigned int row)
+{
+    unsigned int counts[CANON_BOX_ORDER] = { 0 };
+    unsigned int pattern = 0;
+    unsigned int stack = 0;
+    unsigned int col = 0;
+
+    for (col = 0; col < CANON_ORDER; ++col) {
+        if (SourceValue(puzzle, transposed, row, col) != 0) ++counts[col / CANON_BOX_ORDER];
+    }
+
+    /* Sort the stack counts, most values first */
+    for (stack = 1; stack < CANON_BOX_ORDER; ++stack) {
+        unsigned int position = stack;
+
+        while ((position > 0) && (counts[position - 1] < counts[position])) {
+            const unsigned int swap = counts[position];
+
+            counts[position] = counts[position - 1];
+            counts[position - 1] = swap;
+            --position;
+        }
+    }
+
+    for (col = 0; col < CANON_ORDER; ++col) {
+        pattern = (pattern << 1) | ((col % CANON_BOX_ORDER >= counts[col / CANON_BOX_ORDER]) ? 1u : 0u);
+    }
+
+    return pattern;
+}
+
+/*
+** Reads a row of the puzzle in the state's column order, numbering values not
+** yet labelled, and writes the rank of each square to ranks: its label, or
+** BLANK_RANK for a blank.
+*/
+static void RankRow(const uint8_t puzzle[CANON_SQUARES], CanonState* state, const unsigned int row, uint8_t ranks[CANON_ORDER])
+{
+    const uint8_t* columns = columnOrders[state->columnOrder];
+    unsigned int col = 0;
+
+    for (col = 0; col < CANON_ORDER; ++col) {
+        const uint8_t value = SourceValue(puzzle, state->transposed, row, columns[col]);
+
+        if (value == 0) {
+            ranks[col] = BLANK_RANK;
+            continue;
+        }
+
+        if (state->labels[value] == 0) state->labels[value] = state->nextLabel++;
+        ranks[col] = state->labels[value];
+    }
+}
+
+/*
+** Offers a state whose latest row has the given ranks. A row less than the
+** beam's best replaces every state; an equal row joins them. best holds the
+** beam's least row.
+**
+** Returns false if the beam would grow too large or memory can't be allocated.
+*/
+static bool OfferState(CanonBeam* beam, const CanonState* state, const uint8_t ranks[CANON_ORDER], uint8_t best[CANON_ORDER])
+{
+    if (beam->numStates > 0) {
+        const int order = memcmp(ranks, best, CANON_ORDER);
+
+        if (order > 0) return true;
+        if (order < 0) beam->numStates = 0;
+    }
+
+    if (beam->numStates == 0) memcpy(best, ranks, CANON_ORDER);
+
+    if (beam->numStates == beam->capacity) {
+        CanonState* states = NULL;
+
+        if (beam->capacity == MAX_BEAM_SIZE) return false;
+
+        states = (CanonState*)realloc(beam->states, 2 * beam->capacity * sizeof(CanonState));
+        if (states == NULL) return false;
+
+        beam->states = states;
+        beam->capacity *= 2;
+    }
+
+    beam->states[beam->numStates++] = *state;
+    return true;
+}
+
+/*
+** Returns true if no blank comes before a value when the columns of a stack
+** of a row are read in the given order.
+*/
+static bool ValuesFirst(const uint8_t puzzle[CANON_SQUARES], const bool transposed, const unsigned int row, const unsigned int stack, const unsigned int within)
+{
+    bool blankFound = false;
+    unsigned int position = 0;
+
+    for (position = 0; position < CANON_BOX_ORDER; ++position) {
+        const bool blank = (SourceValue(puzzle, transposed, row, stack * CANON_BOX_ORDER + orders3[within][position]) == 0);
+
+        if (blankFound && !blank) return false;
+        blankFound = blankFound || blank;
+    }
+
+    return true;
+}
+
+/*
+** Offers a first row in every column order giving it the least blank pattern:
+** stacks with more values first, and values before blanks within each stack.
+*/
+static bool OfferFirstRow(const uint8_t puzzle[CANON_SQUARES], CanonState* state, CanonBeam* beam, uint8_t best[CANON_ORDER])
+{
+    const unsigned int row = state->rows[0];
+    unsigned int counts[CANON_BOX_ORDER] = { 0 };
+    unsigned int stacks = 0;
+    unsigned int col = 0;
+
+    for (col = 0; col < CANON_ORDER; ++col) {
+        if (SourceValue(puzzle, state->transposed, row, col) != 0) ++counts[col / CANON_BOX_ORDER];
+    }
+
+    for (stacks = 0; stacks < 6; ++stacks) {
+        const uint8_t* stackOrder = orders3[stacks];
+        unsigned int allowed[CANON_BOX_ORDER][6];
+        unsigned int numAllowed[CANON_BOX_ORDER] = { 0 };
+        unsigned int position = 0;
+        unsigned int index = 0;
+
+        if ((counts[stackOrder[0]] < counts[stackOrder[1]]) || (counts[stackOrder[1]] < counts[stackOrder[2]])) continue;
+
+        for (position = 0; position < CANON_BOX_ORDER; ++position) {
+            unsigned int within = 0;
+
+            for (within = 0; within < 6; ++within) {
+                if (ValuesFirst(puzzle, state->transposed, row, stackOrder[position], within)) allowed[position][numAllowed[position]++] = within;
+            }
+        }
+
+        /* Column orders are numbered as BuildColumnOrders lists them */
+        for (index = 0; index < numAllowed[0] * numAllowed[1] * numAllowed[2]; ++index) {
+            const unsigned int first = allowed[0][index / (numAllowed[1] * numAllowed[2])];
+            const unsigned int second = allowed[1][(index / numAllowed[2]) % numAllowed[1]];
+            const unsigned int third = allowed[2][index % numAllowed[2]];
+            uint8_t ranks[CANON_ORDER];
+
+            state->columnOrder = (uint16_t)(stacks * 216 + first * 36 + second * 6 + third);
+            memset(state->labels, 0, sizeof(state->labels));
+            state->nextLabel = 1;
+
+            RankRow(puzzle, state, row, ranks);
+            if (!OfferState(beam, state, ranks, best)) return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+** Finds the least first row from the rows of the puzzle and its transpose with
+** the least blank pattern.
+*/
+static bool FirstRows(const uint8_t puzzle[CANON_SQUARES], CanonBeam* beam, uint8_t best[CANON_ORDER])
+{
+    unsigned int patterns[2][CANON_ORDER];
+    unsigned int leastPattern = ~0u;
+    unsigned int transposed = 0;
+    unsigned int row = 0;
+
+    for (transposed = 0; transposed < 2; ++transposed) {
+        for (row = 0; row < CANON_ORDER; ++row) {
+            patterns[transposed][row] = LeastBlankPattern(puzzle, transposed != 0, row);
+            if (patterns[transposed][row] < leastPattern) leastPattern = patterns[transposed][row];
+        }
+    }
+
+    for (transposed = 0; transposed < 2; ++transposed) {
+        for (row = 0; row < CANON_ORDER; ++row) {
+            CanonState state;
+
+            if (patterns[transposed][row] != leastPattern) continue;
+
+            memset(&state, 0, sizeof(state));
+            state.transposed = (transposed != 0);
+            state.rows[0] = (uint8_t)row;
+
+            if (!OfferFirstRow(puzzle, &state, beam, best)) return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+** Extends every state of from with each row that may come next in the
+** canonical form, keeping those giving the least row in to.
+*/
+static bool NextRows(const uint8_t puzzle[CANON_SQUARES], const CanonBeam* from, CanonBeam* to, const unsigned int position, uint8_t best[CANON_ORDER])
+{
+    unsigned int index = 0;
+
+    to->numStates = 0;
+
+    for (index = 0; index < from->numStates; ++index) {
+        const CanonState* state = &from->states[index];
+        unsigned int usedRows = 0;
+        unsigned int row = 0;
+
+        for (row = 0; row < position; ++row) usedRows |= 1u << state->rows[row];
+
+        for (row = 0; row < CANON_ORDER; ++row) {
+            CanonState next = *state;
+            uint8_t ranks[CANON_ORDER];
+
+            if (usedRows & (1u << row)) continue;
+
+            /* A new band starts every third row; otherwise the band continues */
+            if (position % CANON_BOX_ORDER == 0) {
+                if (usedRows & (0x7u << (row / CANON_BOX_ORDER * CANON_BOX_ORDER))) continue;
+            }
+            else if (row / CANON_BOX_ORDER != state->rows[position - 1] / CANON_BOX_ORDER) continue;
+
+            next.rows[position] = (uint8_t)row;
+            RankRow(puzzle, &next, row, ranks);
+            if (!OfferState(to, &next, ranks, best)) return false;
+        }
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+/* Canonical forms                                                           */
+/*****************************************************************************/
+
+/*
+** Chooses the rows of the canonical form one at a time; every state in a beam
+** has the same rows so far. Returns a state giving the canonical form, or NULL
+** if the beam grows too large.
+*/
+static const CanonState* SearchCanonicalForm(const uint8_t puzzle[CANON_SQUARES], CanonBeam beams[2], uint8_t canonical[CANON_SQUARES])
+{
+    unsigned int position = 0;
+
+    if (!FirstRows(puzzle, &beams[0], canonical)) return NULL;
+
+    for (position = 1; position < CANON_ORDER; ++position) {
+        if (!NextRows(puzzle, &beams[(position - 1) % 2], &beams[position % 2], position, &canonical[position * CANON_ORDER])) return NULL;
+    }
+
+    return &beams[(CANON_ORDER - 1) % 2].states[0];
+}
+
+bool GetCanonicalForm(const uint8_t puzzle[CANON_SQUARES], uint8_t canonical[CANON_SQUARES], CanonTransform* transform)
+{
+    CanonBeam beams[2] = { { NULL, 0, INITIAL_BEAM_SIZE }, { NULL, 0, INITIAL_BEAM_SIZE } };
+    const CanonState* result = NULL;
+
+    assert((puzzle != NULL) && (canonical != NULL) && (transform != NULL));
+
+    if (!ValuesUnique(puzzle)) return false;
+    if (!columnOrdersBuilt) BuildColumnOrders();
+
+    beams[0].states = (CanonState*)malloc(INITIAL_BEAM_SIZE * sizeof(CanonState));
+    beams[1].states = (CanonState*)malloc(INITIAL_BEAM_SIZE * sizeof(CanonState));
+
+    if ((beams[0].states != NULL) && (beams[1].states != NULL)) result = SearchCanonicalForm(puzzle, beams, canonical);
+
+    if (result != NULL) {
+        unsigned int nextLabel = result->nextLabel;
+        unsigned int value = 0;
+        unsigned int position = 0;
+
+        transform->transposed = result->transposed;
+        memcpy(transform->rows, result->rows, CANON_ORDER);
+        memcpy(transform->cols, columnOrders[result->columnOrder], CANON_ORDER);
+        memcpy(transform->labels, result->labels, CANON_ORDER + 1);
+
+        /* Values missing from the puzzle take the remaining labels */
+        for (value = 1; value <= CANON_ORDER; ++value) {
+            if (transform->labels[value] == 0) transform->labels[value] = (uint8_t)nextLabel++;
+        }
+
+        /* Ranks put blanks last; the canonical form holds them as 0 */
+        for (position = 0; position < CANON_SQUARES; ++position) {
+            if (canonical[position] == BLANK_RANK) canonical[position] = 0;
+        }
+    }
+
+    free(beams[0].states);
+    free(beams[1].states);
+    return result != NULL;
+}
+
+void ApplyCanonTransform(const CanonTransform* transform, const uint8_t grid[CANON_SQUARES], uint8_t out[CANON_SQUARES])
+{
+    unsigned int row = 0;
+    unsigned int col = 0;
+
+    assert((transform != NULL) && (grid != NULL) && (out != NULL));
+
+    for (row = 0; row < CANON_ORDER; ++row) {
+        for (col = 0; col < CANON_ORDER; ++col) {
+            out[row * CANON_ORDER + col] = transform->labels[SourceValue(grid, transform->transposed, transform->rows[row], transform->cols[col])];
+        }
+    }
+}
+
+void InvertCanonTransform(const CanonTransform* transform, const uint8_t grid[CANON_SQUARES], uint8_t out[CANON_SQUARES])
+{
+    uint8_t values[CANON_ORDER + 1] = { 0 };
+    unsigned int value = 0;
+    unsigned int row = 0;
+    unsigned int col = 0;
+
+    assert((transform != NULL) && (grid != NULL) && (out != NULL));
+
+    for (value = 1; value <= CANON_ORDER; ++value) values[transform->labels[value]] = (uint8_t)value;
+
+    for (row = 0; row < CANON_ORDER; ++row) {
+        for (col = 0; col < CANON_ORDER; ++col) {
+            const unsigned int sourceRow = transform->transposed ? transform->cols[col] : transform->rows[row];
+            const unsigned int sourceCol = transform->transposed ? transform->rows[row] : transform->cols[col];
+
+            out[sourceRow * CANON_ORDER + sourceCol] = values[grid[row * CANON_ORDER + col]];
+        }
+    }
+}
+
+uint64_t HashCanonicalForm(const uint8_t canonical[CANON_SQUARES])
+{
+    uint64_t hash = 14695981039346656037ull;
+    unsigned int position = 0;
+
+    for (position = 0; position < CANON_SQUARES; ++position) {
+        hash ^= canonical[position];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+/*
+** CanonicalForm.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef CANONICAL_FORM_H
+#define CANONICAL_FORM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+** Canonical forms of 9x9 Sudoku puzzles. Relabelling the values, reordering
+** the bands and stacks, reordering the rows within a band or the columns
+** within a stack, and transposing the grid all turn a puzzle into one with the
+** same solutions, transformed the same way. Every puzzle related by these
+** transforms has the same canonical form.
+**
+** The canonical form is the transform of the puzzle that is least when read
+** row-wise, comparing blank squares as greater than every value. Values are
+** numbered in the order they are first read, so 1 is always the first value.
+**
+** Grids here are arrays of CANON_SQUARES values, row-wise, with 0 for a blank.
+*/
+
+enum {
+    CANON_ORDER = 9,
+    CANON_SQUARES = CANON_ORDER * CANON_ORDER
+};
+
+/*
+** A transform from a puzzle to its canonical form. The square at row, col of
+** the canonical form is the square at rows[row], cols[col] of the puzzle, or of
+** its transpose if transposed is set, with its value replaced by
+** labels[value]. labels[0] is 0.
+*/
+typedef struct {
+    bool transposed;
+    uint8_t rows[CANON_ORDER];
+    uint8_t cols[CANON_ORDER];
+    uint8_t labels[CANON_ORDER + 1];
+} CanonTransform;
+
+/*
+** Finds the canonical form of a 9x9 puzzle and the transform to it.
+**
+** Returns false if the canonical form isn't found: a value repeats in a row,
+** column or box, or the puzzle has so many symmetries the search would be
+** slow, e.g. a nearly blank puzzle.
+*/
+bool GetCanonicalForm(const uint8_t puzzle[CANON_SQUARES], uint8_t canonical[CANON_SQUARES], CanonTransform* transform);
+
+/*
+** Applies the transform to a grid of the puzzle it was found for, e.g. a
+** solution of the puzzle, giving the same grid for the canonical form.
+*/
+void ApplyCanonTransform(const CanonTransform* transform, const uint8_t grid[CANON_SQUARES], uint8_t out[CANON_SQUARES]);
+
+/*
+** Reverses ApplyCanonTransform, giving a grid of the puzzle from a grid of its
+** canonical form.
+*/
+void InvertCanonTransform(const CanonTransform* transform, const uint8_t grid[CANON_SQUARES], uint8_t out[CANON_SQUARES]);
+
+/*
+** Returns a 64-bit hash (FNV-1a) of a canonical form.
+*/
+uint64_t HashCanonicalForm(const uint8_t canonical[CANON_SQUARES]);
+
+#endif // !CANONICAL_FORM_H
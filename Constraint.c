@@ -32,10 +32,14 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <stdlib.h>
 
 bool ConstraintsMet(ConstraintList* list, Grid grid)
 {
+    const GridSquare* squares = GetSquares(grid);
+    const unsigned int numSquares = GetGridOrder(grid) * GetGridOrder(grid);
     unsigned int index = 0;
+    unsigned int cell = 0;
 
     assert(list != NULL);
 
@@ -43,8 +47,183 @@ bool ConstraintsMet(ConstraintList* list, Grid grid)
         Constraint* constraint = &list->constraints[index];
         ValidationFunction isRegionValid = constraint->funcs.validationFunc;
 
-        if (!isRegionValid(grid, &constraint->region)) return false;
+        if (!isRegionValid(grid, constraint)) return false;
     }
 
+    if (list->neighbours == NULL) return true;
+
+    /* Neighbours are listed both ways, so only later neighbours are checked */
+    for (cell = 0; cell < numSquares; ++cell) {
+        if (squares[cell].value == VALUE_NONE) continue;
+
+        for (index = list->neighbourStart[cell]; index < list->neighbourStart[cell + 1]; ++index) {
+            if ((list->neighbours[index] > cell) && (squares[list->neighbours[index]].value == squares[cell].value)) return false;
+        }
+    }
+
+    return true;
+}
+
+static int CompareCells(const void* a, const void* b)
+{
+    return (int)*(const CellIndex*)a - (int)*(const CellIndex*)b;
+}
+
+/*
+** Fills regionStart and regionIndices from the compiled regions.
+*/
+static void IndexRegions(ConstraintList* list, const unsigned int numSquares)
+{
+    unsigned int index = 0;
+
+    for (index = 0; index <= numSquares; ++index) {
+        list->regionStart[index] = 0;
+    }
+
+    /* Count the regions of each cell one cell ahead, then accumulate into starting positions */
+    for (index = 0; index < list->numConstraints; ++index) {
+        const Region* region = &list->constraints[index].region;
+        unsigned int position = 0;
+
+        for (position = 0; position < region->regionSize; ++position) {
+            ++list->regionStart[region->cells[position] + 1];
+        }
+    }
+
+    for (index = 0; index < numSquares; ++index) {
+        list->regionStart[index + 1] += list->regionStart[index];
+    }
+
+    /* Place each region, advancing its cells' starts, then shift the starts back */
+    for (index = 0; index < list->numConstraints; ++index) {
+        const Region* region = &list->constraints[index].region;
+        unsigned int position = 0;
+
+        for (position = 0; position < region->regionSize; ++position) {
+            list->regionIndices[list->regionStart[region->cells[position]]++] = index;
+        }
+    }
+
+    for (index = numSquares; index > 0; --index) {
+        list->regionStart[index] = list->regionStart[index - 1];
+    }
+    list->regionStart[0] = 0;
+}
+
+/*
+** Fills peerStart and peers from the region index and the neighbours. Each
+** cell's peers are appended from its regions and neighbours, then sorted and
+** stripped of duplicates in place.
+*/
+static void IndexPeers(ConstraintList* list, const unsigned int numSquares)
+{
+    unsigned int numPeers = 0;
+    unsigned int cell = 0;
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        CellIndex* peers = &list->peers[numPeers];
+        unsigned int numAdded = 0;
+        unsigned int numUnique = 0;
+        unsigned int index = 0;
+
+        list->peerStart[cell] = numPeers;
+
+        for (index = list->regionStart[cell]; index < list->regionStart[cell + 1]; ++index) {
+            const Region* region = &list->constraints[list->regionIndices[index]].region;
+            unsigned int position = 0;
+
+            for (position = 0; position < region->regionSize; ++position) {
+                if (region->cells[position] != cell) peers[numAdded++] = region->cells[position];
+            }
+        }
+
+        if (list->neighbours != NULL) {
+            for (index = list->neighbourStart[cell]; index < list->neighbourStart[cell + 1]; ++index) {
+                peers[numAdded++] = list->neighbours[index];
+            }
+        }
+
+        qsort(peers, numAdded, sizeof(CellIndex), CompareCells);
+
+        for (index = 0; index < numAdded; ++index) {
+            if ((numUnique == 0) || (peers[index] != peers[numUnique - 1])) peers[numUnique++] = peers[index];
+        }
+
+        numPeers += numUnique;
+    }
+
+    list->peerStart[numSquares] = numPeers;
+}
+
+bool CompileConstraints(ConstraintList* list, unsigned int gridOrder)
+{
+    const unsigned int numSquares = gridOrder * gridOrder;
+    unsigned int numCells = 0;
+    unsigned int peerBound = 0;
+    unsigned int index = 0;
+    CellIndex* cells = NULL;
+    char* block = NULL;
+
+    assert(list != NULL);
+
+    if ((list->cells != NULL) && (list->gridOrder == gridOrder)) return true;
+
+    /* Each region adds at most its other squares to the peers of each of its squares */
+    for (index = 0; index < list->numConstraints; ++index) {
+        const unsigned int regionSize = list->constraints[index].region.regionSize;
+
+        numCells += regionSize;
+        peerBound += regionSize * (regionSize > 0 ? regionSize - 1 : 0);
+    }
+
+    if (list->neighbours != NULL) peerBound += list->neighbourStart[numSquares];
+
+    /* Widest types first, so every array is aligned */
+    block = (char*)malloc((2 * (numSquares + 1) + numCells) * sizeof(unsigned int) + (numCells + peerBound + 1) * sizeof(CellIndex));
+    if (block == NULL) return false;
+
+    FreeCompiledConstraints(list);
+
+    list->regionStart = (unsigned int*)block;           block += (numSquares + 1) * sizeof(unsigned int);
+    list->peerStart = (unsigned int*)block;             block += (numSquares + 1) * sizeof(unsigned int);
+    list->regionIndices = (unsigned int*)block;         block += numCells * sizeof(unsigned int);
+    list->cells = (CellIndex*)block;                    block += numCells * sizeof(CellIndex);
+    list->peers = (CellIndex*)block;
+    list->gridOrder = gridOrder;
+
+    cells = list->cells;
+    for (index = 0; index < list->numConstraints; ++index) {
+        CompileRegion(&list->constraints[index].region, gridOrder, cells);
+        cells += list->constraints[index].region.regionSize;
+    }
+
+    IndexRegions(list, numSquares);
+    IndexPeers(list, numSquares);
+
     return true;
+}
+
+void FreeCompiledConstraints(ConstraintList* list)
+{
+    assert(list != NULL);
+
+    /* Every compiled array shares the allocation starting at regionStart */
+    free(list->regionStart);
+
+    list->cells = NULL;
+    list->gridOrder = 0;
+    list->regionStart = NULL;
+    list->regionIndices = NULL;
+    list->peerStart = NULL;
+    list->peers = NULL;
+}
+
+void DestroyConstraintList(ConstraintList** list)
+{
+    if ((list != NULL) && (*list != NULL)) {
+        FreeCompiledConstraints(*list);
+        free(*list);
+
+        *list = NULL;
+    }
 }
\ No newline at end of file
@@ -40,21 +40,79 @@
 /*
 ** A constraint consists of a region and an associated validation function. The
 ** constraint is satisfied when the validation function returns true.
+**
+** target is a value the region's squares must meet for constraints that have
+** one, e.g. the sum of a Killer cage. It's zero otherwise.
 */
-typedef struct {
+typedef struct _ConstraintType {
     Region region;
     ConstraintFuncs funcs;
+    unsigned int target;
 } Constraint;
 
+/*
+** A list of constraints. Every field after neighbours is set when the list is
+** compiled, and is NULL or zero before then.
+**
+**  neighbourStart, neighbours - Cells that must hold a different value from
+**                               cell n by a rule other than the regions, e.g.
+**                               a king's move away in anti-king Sudoku, are
+**                               neighbours[neighbourStart[n]] up to
+**                               neighbours[neighbourStart[n + 1]]. Both are
+**                               NULL if the list has no such rule. They're
+**                               set by the list's creator and compiling adds
+**                               them to the peers.
+**
+**  cells - Storage for the cell indices of every region, shared by the
+**          regions once the list is compiled.
+**
+**  gridOrder - Grid order the list was compiled for, or zero.
+**
+**  regionStart, regionIndices - The constraints whose regions contain cell n
+**                               are regionIndices[regionStart[n]] up to
+**                               regionIndices[regionStart[n + 1]].
+**
+**  peerStart, peers - The other cells sharing a region with cell n or
+**                     neighbouring it, in ascending order, are
+**                     peers[peerStart[n]] up to peers[peerStart[n + 1]].
+*/
 typedef struct {
     Constraint* constraints;
     unsigned int numConstraints;
+    const unsigned int* neighbourStart;
+    const CellIndex* neighbours;
+    CellIndex* cells;
+    unsigned int gridOrder;
+    unsigned int* regionStart;
+    unsigned int* regionIndices;
+    unsigned int* peerStart;
+    CellIndex* peers;
 } ConstraintList;
 
+/*
+** Compiles the region of each constraint for a grid of the given order (see
+** CompileRegion), and indexes the regions and peers of each cell. Compiling a
+** list already compiled for gridOrder does nothing.
+**
+** Returns false if the storage can't be allocated.
+*/
+bool CompileConstraints(ConstraintList* list, unsigned int gridOrder);
+
+/*
+** Frees the storage of a compiled list. The list's constraints aren't freed.
+*/
+void FreeCompiledConstraints(ConstraintList* list);
+
+/*
+** Destroys a list allocated in one block with its constraints and their
+** locations, e.g. by CreateJigsawConstraints, and its compiled storage.
+*/
+void DestroyConstraintList(ConstraintList** list);
+
 /*
 ** Evaluates each constraint in the constraint list against the given grid.
 ** Returns true if all constraints are satisfied (i.e. the validation function
-** returns true).
+** returns true) and no square shares its value with a neighbour.
 */
 bool ConstraintsMet(ConstraintList* list, Grid grid);
 
@@ -37,13 +37,17 @@
 #include "common/Domain.h"
 
 #include <stdbool.h>
+#include <stdint.h>
+
+/* See Constraint.h */
+struct _ConstraintType;
 
 /*
 ** Type for constraint validation functions.
 **
-** Returns true if the given region of the grid is valid.
+** Returns true if the constraint's region of the grid is valid.
 */
-typedef bool (*ValidationFunction)(Grid, Region*);
+typedef bool (*ValidationFunction)(Grid, const struct _ConstraintType*);
 
 /*
 ** Function type for updating binary arc constraints. Updates the domain of
@@ -56,9 +60,30 @@ typedef bool (*ValidationFunction)(Grid, Region*);
 */
 typedef bool (*BinaryConstraintUpdate)(Grid grid, GridLocation a, const GridLocation b);
 
+/*
+** Set of positions within a region. Bit n represents region->locations[n].
+*/
+typedef uint64_t RegionMask;
+
+/*
+** Function type for region-wide constraint updates. Updates the domain of
+** every square in the region given the value of the square at modified, which
+** must be in the region. This is equivalent to calling the region's
+** BinaryConstraintUpdate for every square of the region, but a single pass
+** allows the update to be specialised for the constraint.
+**
+** Returns the positions of the squares whose domains were changed.
+*/
+typedef RegionMask (*RegionConstraintUpdate)(Grid grid, const Region* region, const GridLocation modified);
+
+/*
+** regionUpdate may be NULL, in which case binaryConstraint is called for each
+** square of the region.
+*/
 typedef struct {
     ValidationFunction validationFunc;
     BinaryConstraintUpdate binaryConstraint;
+    RegionConstraintUpdate regionUpdate;
 } ConstraintFuncs;
 
 #endif // !CONSTRAINT_FUNCTION_H
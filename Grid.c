@@ -46,6 +46,7 @@ bool CreateGrid(Grid* grid, unsigned int gridOrder)
     const unsigned int numSquares = gridOrder * gridOrder;
 
     assert(grid != NULL);
+    assert((gridOrder > 0) && (gridOrder <= MAX_SQUARE_VALUE));
 
     if (newGrid == NULL) return false;
     
@@ -59,7 +60,7 @@ bool CreateGrid(Grid* grid, unsigned int gridOrder)
         unsigned int index = 0;
 
         newGrid->grid[0].value = VALUE_NONE;
-        newGrid->grid[0].domain = DomCreate(VALUE_1, numSquareValues - VALUE_1, true);
+        newGrid->grid[0].domain = DomCreate(VALUE_1, gridOrder, true);
 
         for (index = 1; index < numSquares; ++index) {
             newGrid->grid[index] = newGrid->grid[0];
@@ -102,6 +103,12 @@ GridSquare* GetSquare(Grid grid, unsigned int row, unsigned int col)
     return (GridSquare*)&grid->grid[squareIndex];
 }
 
+GridSquare* GetSquares(Grid grid)
+{
+    assert((grid != NULL) && (grid->grid != NULL));
+    return grid->grid;
+}
+
 GridSquare* GetRow(Grid grid, unsigned int row)
 {
     return GetSquare(grid, row, 0);
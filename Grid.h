@@ -39,7 +39,9 @@ typedef struct _GridType* Grid;
 
 /*
 ** Creates a grid of GridSquares with dimensions gridOrder x gridOrder. All
-** grid squares are initialized to 0 (VALUE_NONE) with a full domain.
+** grid squares are initialized to 0 (VALUE_NONE) with a full domain of the
+** values VALUE_1 through gridOrder. gridOrder must not exceed
+** MAX_SQUARE_VALUE.
 **
 ** If successful, the grid parameter is updated to point to the newly created
 ** grid and true is returned.
@@ -67,6 +69,12 @@ unsigned int GetGridOrder(Grid grid);
 */
 GridSquare* GetSquare(Grid grid, unsigned int row, unsigned int col);
 
+/*
+** Returns pointer to the grid's square array. The square at row, col is at
+** index row * gridOrder + col, the cell index used by compiled regions.
+*/
+GridSquare* GetSquares(Grid grid);
+
 /*
 ** Returns pointer to first (left) grid square in the given row. Rows are zero
 ** indexed from the top left. row must be less than grid order.
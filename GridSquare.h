@@ -33,6 +33,13 @@
 
 #include "common/Domain.h"
 
+/*
+** Square values run from VALUE_1 to the grid order. Values above VALUE_9 are
+** only used by grids larger than nine-by-nine and aren't named.
+**
+** numSquareValues bounds arrays indexed by value for the largest supported
+** grid. Loops over values should stop at the grid order instead.
+*/
 typedef enum {
     VALUE_NONE,
     VALUE_1,
@@ -44,6 +51,7 @@ typedef enum {
     VALUE_7,
     VALUE_8,
     VALUE_9,
+    MAX_SQUARE_VALUE = 64,
     numSquareValues
 };
 
@@ -0,0 +1,302 @@
+/*
+** KillerConstraints.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "KillerConstraints.h"
+#include "SudokuConstraints.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+/*
+** Every non-empty set of values of an order, grouped by size and sum. The
+** sets of size and sum are masks[start[slot]] up to masks[start[slot + 1]],
+** where slot is size * (maxSum + 1) + sum.
+*/
+typedef struct {
+    unsigned int maxSum;
+    unsigned int* start;
+    DomWord* masks;
+} CombinationTable;
+
+static CombinationTable* combinationTables[MAX_CAGE_COMBINATION_ORDER + 1] = { NULL };
+
+/*
+** Smallest and largest sums of size different values from 1 to gridOrder.
+*/
+#define MIN_CAGE_SUM(size) ((size) * ((size) + 1) / 2)
+#define MAX_CAGE_SUM(size, gridOrder) ((size) * (2 * (gridOrder) - (size) + 1) / 2)
+
+/*****************************************************************************/
+/* Constraint functions                                                      */
+/*****************************************************************************/
+
+/*
+** Validation function. Returns false if any square values are repeated in the
+** cage, if a complete cage doesn't add up to its sum, or if the open squares
+** of an incomplete cage can't make up the difference.
+*/
+static bool CageSum(Grid grid, const Constraint* constraint)
+{
+    const unsigned int gridOrder = GetGridOrder(grid);
+    const Region* region = NULL;
+    const GridSquare* squares = NULL;
+    bool valueFound[numSquareValues] = { false };
+    unsigned int sum = 0;
+    unsigned int numOpen = 0;
+    unsigned int position = 0;
+
+    assert((constraint != NULL) && (constraint->region.cells != NULL));
+    region = &constraint->region;
+    squares = GetSquares(grid);
+
+    for (position = 0; position < region->regionSize; ++position) {
+        const GridSquare* const square = &squares[region->cells[position]];
+
+        if (square->value == VALUE_NONE) {
+            ++numOpen;
+            continue;
+        }
+
+        if (valueFound[square->value]) return false;
+
+        valueFound[square->value] = true;
+        sum += square->value;
+    }
+
+    /* Open squares hold different values, so add at least 1 + 2 + ... and at most gridOrder + (gridOrder - 1) + ... */
+    return (sum + MIN_CAGE_SUM(numOpen) <= constraint->target) && (sum + MAX_CAGE_SUM(numOpen, gridOrder) >= constraint->target);
+}
+
+/*****************************************************************************/
+/* Combination tables                                                        */
+/*****************************************************************************/
+
+/*
+** Generates the combination table for gridOrder. Returns NULL if memory can't
+** be allocated.
+*/
+static CombinationTable* CreateCombinationTable(const unsigned int gridOrder)
+{
+    const unsigned int maxSum = MAX_CAGE_SUM(gridOrder, gridOrder);
+    const unsigned int numSlots = (gridOrder + 1) * (maxSum + 1);
+    const unsigned long numMasks = (1UL << gridOrder) - 1;
+    CombinationTable* table = NULL;
+    unsigned long mask = 0;
+    unsigned int slot = 0;
+
+    assert(gridOrder <= MAX_CAGE_COMBINATION_ORDER);
+
+    table = (CombinationTable*)malloc(sizeof(CombinationTable) + numMasks * sizeof(DomWord) + (numSlots + 1) * sizeof(unsigned int));
+    if (table == NULL) return NULL;
+
+    table->maxSum = maxSum;
+    table->masks = (DomWord*)(table + 1);
+    table->start = (unsigned int*)(table->masks + numMasks);
+
+    for (slot = 0; slot <= numSlots; ++slot) {
+        table->start[slot] = 0;
+    }
+
+    /* Count the sets of each slot one slot ahead, then accumulate into starting positions */
+    for (mask = 1; mask <= numMasks; ++mask) {
+        unsigned int size = 0;
+        unsigned int sum = 0;
+        unsigned int bit = 0;
+
+        for (bit = 0; bit < gridOrder; ++bit) {
+            if (mask & (1UL << bit)) {
+                ++size;
+                sum += bit + 1;
+            }
+        }
+
+        ++table->start[size * (maxSum + 1) + sum + 1];
+    }
+
+    for (slot = 1; slot <= numSlots; ++slot) {
+        table->start[slot] += table->start[slot - 1];
+    }
+
+    /* Place each set, advancing its slot's start to the next slot's start */
+    for (mask = 1; mask <= numMasks; ++mask) {
+        unsigned int size = 0;
+        unsigned int sum = 0;
+        unsigned int bit = 0;
+
+        for (bit = 0; bit < gridOrder; ++bit) {
+            if (mask & (1UL << bit)) {
+                ++size;
+                sum += bit + 1;
+            }
+        }
+
+        table->masks[table->start[size * (maxSum + 1) + sum]++] = (DomWord)mask;
+    }
+
+    for (slot = numSlots; slot > 0; --slot) {
+        table->start[slot] = table->start[slot - 1];
+    }
+    table->start[0] = 0;
+
+    return table;
+}
+
+bool GetCageCombinations(const unsigned int gridOrder, const unsigned int size, const unsigned int sum, CageCombinations* combinations)
+{
+    const CombinationTable* table = NULL;
+    unsigned int slot = 0;
+
+    assert(combinations != NULL);
+
+    if (gridOrder > MAX_CAGE_COMBINATION_ORDER) return false;
+
+    table = combinationTables[gridOrder];
+    if (table == NULL) return false;
+
+    if ((size > gridOrder) || (sum > table->maxSum)) {
+        combinations->masks = table->masks;
+        combinations->numMasks = 0;
+        return true;
+    }
+
+    slot = size * (table->maxSum + 1) + sum;
+    combinations->masks = &table->masks[table->start[slot]];
+    combinations->numMasks = table->start[slot + 1] - table->start[slot];
+
+    return true;
+}
+
+void ReleaseCageCombinations(void)
+{
+    unsigned int gridOrder = 0;
+
+    for (gridOrder = 0; gridOrder <= MAX_CAGE_COMBINATION_ORDER; ++gridOrder) {
+        free(combinationTables[gridOrder]);
+        combinationTables[gridOrder] = NULL;
+    }
+}
+
+/*****************************************************************************/
+/* Cage lists                                                                */
+/*****************************************************************************/
+
+bool CreateCageConstraints(ConstraintList** list, const unsigned int gridOrder, const unsigned int* cageOfCell, const unsigned int* sums,
+    const unsigned int numCages)
+{
+    const unsigned int numSquares = gridOrder * gridOrder;
+    const ConstraintFuncs uniqueFuncs = GetUniqueValueFuncs();
+    ConstraintList* newList = NULL;
+    GridLocation* storage = NULL;
+    unsigned int numCaged = 0;
+    unsigned int cell = 0;
+    unsigned int cage = 0;
+
+    assert((list != NULL) && (cageOfCell != NULL) && (sums != NULL));
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        if (cageOfCell[cell] > numCages) return false;
+        if (cageOfCell[cell] != 0) ++numCaged;
+    }
+
+    newList = (ConstraintList*)malloc(sizeof(ConstraintList) + numCages * sizeof(Constraint) + numCaged * sizeof(GridLocation));
+    if (newList == NULL) return false;
+
+    newList->constraints = (Constraint*)(newList + 1);
+    newList->numConstraints = numCages;
+    newList->neighbourStart = NULL;
+    newList->neighbours = NULL;
+    newList->cells = NULL;
+    newList->gridOrder = 0;
+    newList->regionStart = NULL;
+    newList->regionIndices = NULL;
+    newList->peerStart = NULL;
+    newList->peers = NULL;
+    storage = (GridLocation*)(newList->constraints + numCages);
+
+    for (cage = 0; cage < numCages; ++cage) {
+        Constraint* constraint = &newList->constraints[cage];
+
+        constraint->region.locations = NULL;
+        constraint->region.regionSize = 0;
+        constraint->region.cells = NULL;
+        constraint->region.rowMask = 0;
+        constraint->region.colMask = 0;
+        constraint->funcs = uniqueFuncs;
+        constraint->funcs.validationFunc = CageSum;
+        constraint->target = sums[cage];
+    }
+
+    /* Size each cage, then give each its run of the location storage */
+    for (cell = 0; cell < numSquares; ++cell) {
+        if (cageOfCell[cell] != 0) ++newList->constraints[cageOfCell[cell] - 1].region.regionSize;
+    }
+
+    for (cage = 0; cage < numCages; ++cage) {
+        Region* region = &newList->constraints[cage].region;
+
+        if ((region->regionSize == 0) || (region->regionSize > gridOrder) || (sums[cage] < MIN_CAGE_SUM(region->regionSize)) ||
+            (sums[cage] > MAX_CAGE_SUM(region->regionSize, gridOrder))) {
+            free(newList);
+            return false;
+        }
+
+        region->locations = storage;
+        storage += region->regionSize;
+        region->regionSize = 0;
+    }
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        if (cageOfCell[cell] != 0) {
+            Region* region = &newList->constraints[cageOfCell[cell] - 1].region;
+
+            region->locations[region->regionSize].row = cell / gridOrder;
+            region->locations[region->regionSize].col = cell % gridOrder;
+            ++region->regionSize;
+        }
+    }
+
+    if (!CompileConstraints(newList, gridOrder)) {
+        free(newList);
+        return false;
+    }
+
+    /* A missing table only loses combination pruning, so allocation failure isn't an error */
+    if ((gridOrder <= MAX_CAGE_COMBINATION_ORDER) && (combinationTables[gridOrder] == NULL)) {
+        combinationTables[gridOrder] = CreateCombinationTable(gridOrder);
+    }
+
+    *list = newList;
+    return true;
+}
+
+void DestroyCageConstraints(ConstraintList** list)
+{
+    DestroyConstraintList(list);
+}
\ No newline at end of file
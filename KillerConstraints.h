@@ -0,0 +1,91 @@
+/*
+** KillerConstraints.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef KILLER_CONSTRAINTS_H
+#define KILLER_CONSTRAINTS_H
+
+#include "Constraint.h"
+
+/*
+** Killer Sudoku adds cages to the standard constraints. A cage is a region
+** whose values must all be different and must add up to the cage's sum, held
+** as the constraint's target. Squares need not be in a cage.
+*/
+
+/* Largest grid order with precomputed cage combinations */
+enum {
+    MAX_CAGE_COMBINATION_ORDER = 16
+};
+
+/*
+** Sets of values a cage can hold. Each mask has bit n set for value n + 1,
+** the layout of the first word of a square's domain.
+*/
+typedef struct {
+    const DomWord* masks;
+    unsigned int numMasks;
+} CageCombinations;
+
+/*
+** Creates a compiled list of cage constraints for a grid of gridOrder.
+**
+** cageOfCell holds the cage of each square by cell index: 1 through numCages,
+** or 0 for a square outside any cage. sums holds the sum of each cage, the
+** first entry for cage 1.
+**
+** Returns false and leaves list unmodified if a cage is empty, is larger than
+** the grid order, has a sum its squares can't reach, or memory can't be
+** allocated.
+*/
+bool CreateCageConstraints(ConstraintList** list, const unsigned int gridOrder, const unsigned int* cageOfCell, const unsigned int* sums,
+    const unsigned int numCages);
+
+/*
+** Destroys a list created by CreateCageConstraints.
+*/
+void DestroyCageConstraints(ConstraintList** list);
+
+/*
+** Gets every set of size different values from 1 to gridOrder that adds up to
+** sum. The table for an order is generated when cages of that order are first
+** created, so lookups while solving don't modify it.
+**
+** Returns false if there's no table for gridOrder, in which case combinations
+** isn't modified. There's never a table for orders larger than
+** MAX_CAGE_COMBINATION_ORDER.
+*/
+bool GetCageCombinations(const unsigned int gridOrder, const unsigned int size, const unsigned int sum, CageCombinations* combinations);
+
+/*
+** Frees every combination table. No cage constraints may remain.
+*/
+void ReleaseCageCombinations(void);
+
+#endif // !KILLER_CONSTRAINTS_H
@@ -0,0 +1,193 @@
+/*
+** PortfolioSolver.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "PortfolioSolver.h"
+#include "../AC3Backtrack/AC3Backtrack.h"
+#include "../AdaptiveSolver/AdaptiveSolver.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+/* Portfolio used by PortfolioSolver, roughly fastest first */
+static const PortfolioEntry defaultPortfolio[] = {
+    {   AdaptiveSolver,                 "AdaptiveSolver"        },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack"     },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack"     },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack"   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack"    },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV"       },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack"   },
+    {   AC3BackjumpSolver,              "AC3Backjump"           },
+};
+
+/* How often a race checks the puzzle's own cancel flag, in nanoseconds */
+#define CANCEL_POLL_INTERVAL 1000000
+
+/*
+** State shared by the racing solvers.
+**
+**  winner - Index of the first solver to finish, or -1.
+**
+**  cancel - Set by the winner to stop the others, or when the puzzle raced
+**           is cancelled.
+**
+**  numFinished - Number of solvers that have finished.
+*/
+typedef struct {
+    atomic_int winner;
+    atomic_bool cancel;
+    atomic_uint numFinished;
+} Race;
+
+/*
+** A solver's thread, racing on its own copy of the puzzle.
+*/
+typedef struct {
+    Race* race;
+    SolverFunction solver;
+    SudokuPuzzle copy;
+    int index;
+    bool result;
+    thrd_t thread;
+} Racer;
+
+/*
+** Thread function running one solver. The first to finish claims the race
+** and cancels the rest.
+*/
+static int RunRacer(void* arg)
+{
+    Racer* racer = (Racer*)arg;
+    const bool result = racer->solver(&racer->copy);
+    int noWinner = -1;
+
+    if (atomic_compare_exchange_strong(&racer->race->winner, &noWinner, racer->index)) {
+        racer->result = result;
+        atomic_store(&racer->race->cancel, true);
+    }
+
+    atomic_fetch_add(&racer->race->numFinished, 1);
+    return 0;
+}
+
+const PortfolioEntry* GetDefaultPortfolio(unsigned int* numSolvers)
+{
+    assert(numSolvers != NULL);
+
+    *numSolvers = sizeof(defaultPortfolio) / sizeof(defaultPortfolio[0]);
+    return defaultPortfolio;
+}
+
+bool PortfolioRaceSolver(SudokuPuzzle* pzl, const PortfolioEntry* portfolio, const unsigned int numSolvers, int* winner)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const size_t gridSize = gridOrder * gridOrder * sizeof(GridSquare);
+    Racer racers[MAX_PORTFOLIO_SOLVERS];
+    Race race;
+    unsigned int numStarted = 0;
+    unsigned int index = 0;
+    bool result = false;
+
+    assert((pzl != NULL) && (portfolio != NULL) && (winner != NULL));
+    assert((numSolvers > 0) && (numSolvers <= MAX_PORTFOLIO_SOLVERS));
+
+    atomic_init(&race.winner, -1);
+    atomic_init(&race.cancel, false);
+    atomic_init(&race.numFinished, 0);
+
+    /* Each copy has its own grid but shares the puzzle's constraints */
+    for (index = 0; index < numSolvers; ++index) {
+        Racer* racer = &racers[numStarted];
+
+        racer->race = &race;
+        racer->solver = portfolio[index].solver;
+        racer->index = (int)index;
+        racer->result = false;
+        racer->copy = *pzl;
+        racer->copy.cancel = &race.cancel;
+
+        if (!CreateGrid(&racer->copy.grid, gridOrder)) break;
+        memcpy(GetSquares(racer->copy.grid), GetSquares(pzl->grid), gridSize);
+
+        if (thrd_create(&racer->thread, RunRacer, racer) != thrd_success) {
+            DestroyGrid(&racer->copy.grid);
+            break;
+        }
+
+        ++numStarted;
+    }
+
+    /* Solvers that couldn't be started don't race; if none could, the first solver runs here */
+    if (numStarted == 0) {
+        *winner = 0;
+        return portfolio[0].solver(pzl);
+    }
+
+    /* The racers poll only the race's flag, so the puzzle's own is forwarded to it */
+    if (pzl->cancel != NULL) {
+        const struct timespec interval = { 0, CANCEL_POLL_INTERVAL };
+
+        while ((atomic_load(&race.numFinished) < numStarted) && !atomic_load(&race.cancel)) {
+            if (isSudokuCancelled(pzl)) {
+                atomic_store(&race.cancel, true);
+            }
+            else {
+                thrd_sleep(&interval, NULL);
+            }
+        }
+    }
+
+    for (index = 0; index < numStarted; ++index) thrd_join(racers[index].thread, NULL);
+
+    *winner = atomic_load(&race.winner);
+
+    for (index = 0; index < numStarted; ++index) {
+        if (racers[index].index == *winner) {
+            memcpy(GetSquares(pzl->grid), GetSquares(racers[index].copy.grid), gridSize);
+            result = racers[index].result;
+        }
+
+        DestroyGrid(&racers[index].copy.grid);
+    }
+
+    return result;
+}
+
+bool PortfolioSolver(SudokuPuzzle* pzl)
+{
+    unsigned int numSolvers = 0;
+    const PortfolioEntry* portfolio = GetDefaultPortfolio(&numSolvers);
+    int winner = -1;
+
+    return PortfolioRaceSolver(pzl, portfolio, numSolvers, &winner);
+}
\ No newline at end of file
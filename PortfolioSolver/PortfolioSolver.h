@@ -0,0 +1,90 @@
+/*
+** PortfolioSolver.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef PORTFOLIOSOLVER_H
+#define PORTFOLIOSOLVER_H
+
+#include "../SudokuSolver.h"
+
+#include <stdbool.h>
+
+/*
+** Races several solvers on one puzzle. Each solver runs in its own thread on
+** a copy of the puzzle, sharing the puzzle's constraints. The first solver to
+** finish wins: its grid is copied to the puzzle and the other solvers are
+** cancelled through the copies' cancel flags, which they poll as they search.
+** Cancelling the puzzle raced cancels every solver.
+**
+** Search times are heavy-tailed and no one solver is best on every hard
+** puzzle, so a portfolio is rarely much slower than its best solver on a
+** puzzle, and often much faster than any fixed choice. Every solver in a
+** portfolio should be able to solve any puzzle, or a solver that gives up
+** early with a partial solution may win.
+*/
+
+/* Maximum number of solvers in a portfolio */
+enum {
+    MAX_PORTFOLIO_SOLVERS = 8
+};
+
+/*
+** A solver in a portfolio and the name it's reported by.
+*/
+typedef struct {
+    SolverFunction solver;
+    const char* name;
+} PortfolioEntry;
+
+/*
+** Races the solvers in portfolio on the puzzle.
+**
+** Returns the winning solver's result, and sets winner to its index in
+** portfolio. The puzzle holds the winner's grid. If no thread can be
+** started, the first solver is run on the puzzle and wins.
+*/
+bool PortfolioRaceSolver(SudokuPuzzle* pzl, const PortfolioEntry* portfolio, const unsigned int numSolvers, int* winner);
+
+/*
+** Gets the default portfolio used by PortfolioSolver, and sets numSolvers to
+** the number of solvers in it.
+*/
+const PortfolioEntry* GetDefaultPortfolio(unsigned int* numSolvers);
+
+/*
+** Races the default portfolio on the puzzle: AdaptiveSolver, the
+** backtracking search in ascending and least-constraining-value order after
+** AC3Solver, and after the subset, chain, all-different and probing
+** propagators, and the randomised restart and backjumping searches after
+** AC3Solver. The benchmark harness reports which of them wins (PORTFOLIO in
+** main.c).
+*/
+bool PortfolioSolver(SudokuPuzzle* pzl);
+
+#endif // !PORTFOLIOSOLVER_H
@@ -0,0 +1,299 @@
+/*
+** AllDifferentPropagator.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "AllDifferentPropagator.h"
+
+#include "../common/Domain.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+/* Graph nodes: squares first, then values */
+#define VALUE_NODE(graph, value) ((graph)->numSquares + (value) - VALUE_1)
+#define MAX_NODES (2 * MAX_SQUARE_VALUE)
+
+enum {
+    NO_MATCH = -1
+};
+
+/*
+** Value graph of a region. Each square is linked to the values in its
+** domain.
+**
+**  numValues - Number of square values, and the most squares in a region.
+**
+**  squareMatch - Value matched to each square, or VALUE_NONE.
+**
+**  valueMatch - Square matched to each value, or NO_MATCH.
+**
+**  index, lowLink, onStack, stack - Tarjan's strongly connected components.
+**
+**  component - Component of each node.
+**
+**  reachable - True for value nodes reachable from an unmatched value by an
+**              alternating path.
+*/
+typedef struct {
+    GridSquare* squares[MAX_SQUARE_VALUE];
+    unsigned int numSquares;
+    unsigned int numValues;
+    SquareValue squareMatch[MAX_SQUARE_VALUE];
+    int valueMatch[numSquareValues];
+    int index[MAX_NODES];
+    int lowLink[MAX_NODES];
+    bool onStack[MAX_NODES];
+    unsigned int stack[MAX_NODES];
+    unsigned int stackSize;
+    int nextIndex;
+    unsigned int component[MAX_NODES];
+    unsigned int numComponents;
+    bool reachable[MAX_NODES];
+} ValueGraph;
+
+/*****************************************************************************/
+/* Matching                                                                  */
+/*****************************************************************************/
+
+/*
+** Looks for an augmenting path from square, updating the matching if one is
+** found.
+*/
+static bool Augment(ValueGraph* graph, const unsigned int square, bool visited[numSquareValues])
+{
+    Domain values = graph->squares[square]->domain;
+
+    while (!DomIsEmptyDomain(values)) {
+        const SquareValue value = DomPopLSValue(&values);
+
+        if (visited[value]) continue;
+        visited[value] = true;
+
+        if ((graph->valueMatch[value] == NO_MATCH) || Augment(graph, (unsigned int)graph->valueMatch[value], visited)) {
+            graph->squareMatch[square] = value;
+            graph->valueMatch[value] = (int)square;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+** Finds a maximum matching. Returns false if it doesn't cover every square.
+*/
+static bool MatchSquares(ValueGraph* graph)
+{
+    SquareValue value = VALUE_1;
+    unsigned int square = 0;
+
+    for (value = VALUE_1; value <= graph->numValues; ++value) {
+        graph->valueMatch[value] = NO_MATCH;
+    }
+
+    for (square = 0; square < graph->numSquares; ++square) {
+        bool visited[numSquareValues] = { false };
+
+        graph->squareMatch[square] = VALUE_NONE;
+        if (!Augment(graph, square, visited)) return false;
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+/* Alternating graph                                                         */
+/*                                                                           */
+/* Matched edges run from square to value, unmatched edges from value to     */
+/* square.                                                                   */
+/*****************************************************************************/
+
+/*
+** Tarjan's algorithm from node.
+*/
+static void Connect(ValueGraph* graph, const unsigned int node)
+{
+    graph->index[node] = graph->nextIndex;
+    graph->lowLink[node] = graph->nextIndex;
+    ++graph->nextIndex;
+    graph->stack[graph->stackSize++] = node;
+    graph->onStack[node] = true;
+
+    if (node < graph->numSquares) {
+        const unsigned int next = VALUE_NODE(graph, graph->squareMatch[node]);
+
+        if (graph->index[next] < 0) {
+            Connect(graph, next);
+            if (graph->lowLink[next] < graph->lowLink[node]) graph->lowLink[node] = graph->lowLink[next];
+        }
+        else if (graph->onStack[next] && (graph->index[next] < graph->lowLink[node])) {
+            graph->lowLink[node] = graph->index[next];
+        }
+    }
+    else {
+        const SquareValue value = node - graph->numSquares + VALUE_1;
+        unsigned int next = 0;
+
+        for (next = 0; next < graph->numSquares; ++next) {
+            if ((graph->squareMatch[next] == value) || !DomContainsElement(graph->squares[next]->domain, value)) continue;
+
+            if (graph->index[next] < 0) {
+                Connect(graph, next);
+                if (graph->lowLink[next] < graph->lowLink[node]) graph->lowLink[node] = graph->lowLink[next];
+            }
+            else if (graph->onStack[next] && (graph->index[next] < graph->lowLink[node])) {
+                graph->lowLink[node] = graph->index[next];
+            }
+        }
+    }
+
+    /* node is the root of a component */
+    if (graph->lowLink[node] == graph->index[node]) {
+        unsigned int member = 0;
+
+        do {
+            member = graph->stack[--graph->stackSize];
+            graph->onStack[member] = false;
+            graph->component[member] = graph->numComponents;
+        } while (member != node);
+
+        ++graph->numComponents;
+    }
+}
+
+/*
+** Marks the value nodes reachable from value along alternating paths.
+*/
+static void MarkReachable(ValueGraph* graph, const SquareValue value)
+{
+    unsigned int square = 0;
+
+    graph->reachable[VALUE_NODE(graph, value)] = true;
+
+    for (square = 0; square < graph->numSquares; ++square) {
+        const SquareValue next = graph->squareMatch[square];
+
+        if ((next == value) || !DomContainsElement(graph->squares[square]->domain, value)) continue;
+        if (!graph->reachable[VALUE_NODE(graph, next)]) MarkReachable(graph, next);
+    }
+}
+
+/*
+** Removes each value that no maximum matching assigns to the square: the
+** edge isn't matched, doesn't lie within a component, and can't be reached
+** from an unmatched value. Each square reduced is reported to the delta.
+*/
+static PropagateResult FilterRegion(ValueGraph* graph, const Region* region, const PropagationDelta* delta)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    const unsigned int numNodes = graph->numSquares + graph->numValues;
+    SquareValue value = VALUE_1;
+    unsigned int node = 0;
+    unsigned int square = 0;
+
+    for (node = 0; node < numNodes; ++node) {
+        graph->index[node] = -1;
+        graph->onStack[node] = false;
+        graph->reachable[node] = false;
+    }
+
+    graph->stackSize = 0;
+    graph->nextIndex = 0;
+    graph->numComponents = 0;
+
+    for (node = 0; node < numNodes; ++node) {
+        if (graph->index[node] < 0) Connect(graph, node);
+    }
+
+    for (value = VALUE_1; value <= graph->numValues; ++value) {
+        if ((graph->valueMatch[value] == NO_MATCH) && !graph->reachable[VALUE_NODE(graph, value)]) MarkReachable(graph, value);
+    }
+
+    for (square = 0; (square < graph->numSquares) && (result != PROPAGATE_CONTRADICTION); ++square) {
+        GridSquare* gridSquare = graph->squares[square];
+        Domain values = gridSquare->domain;
+
+        if (gridSquare->value != VALUE_NONE) continue;
+
+        while (!DomIsEmptyDomain(values)) {
+            const unsigned int valueNode = VALUE_NODE(graph, (value = DomPopLSValue(&values)));
+
+            if (value == graph->squareMatch[square]) continue;
+            if (graph->component[square] == graph->component[valueNode]) continue;
+            if (graph->reachable[valueNode]) continue;
+
+            DomRemoveElement(&gridSquare->domain, value);
+            ReportChange(delta, region->cells[square]);
+            result = PROPAGATE_CHANGED;
+        }
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+/* Propagator                                                                */
+/*****************************************************************************/
+
+PropagateResult AllDifferent(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    const Constraint* constraints = NULL;
+    GridSquare* squares = NULL;
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int index = 0;
+
+    assert(pzl != NULL);
+    constraints = pzl->uniqueValue->constraints;
+    squares = GetSquares(pzl->grid);
+
+    for (index = 0; (index < pzl->uniqueValue->numConstraints) && (result != PROPAGATE_CONTRADICTION); ++index) {
+        const Region* region = &constraints[index].region;
+        ValueGraph graph;
+        unsigned int position = 0;
+
+        if ((delta != NULL) && !delta->changedRegions[index]) continue;
+
+        graph.numValues = GetGridOrder(pzl->grid);
+        assert(region->regionSize <= graph.numValues);
+
+        graph.numSquares = region->regionSize;
+        for (position = 0; position < region->regionSize; ++position) {
+            graph.squares[position] = &squares[region->cells[position]];
+        }
+
+        /* More squares than the values they can hold */
+        if (!MatchSquares(&graph)) return PROPAGATE_CONTRADICTION;
+
+        result = MergeResult(result, FilterRegion(&graph, region, delta));
+    }
+
+    return result;
+}
+
+const Propagator allDifferentPropagator = { AllDifferent, EVENT_REGION_CHANGED, PROPAGATOR_COST_MEDIUM, false, NULL, NULL };
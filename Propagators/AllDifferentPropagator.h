@@ -0,0 +1,59 @@
+/*
+** AllDifferentPropagator.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef ALL_DIFFERENT_PROPAGATOR_H
+#define ALL_DIFFERENT_PROPAGATOR_H
+
+#include "Propagator.h"
+
+/*
+** All-different propagator (Regin filtering). Evaluates the regions of the
+** puzzle's uniqueValue constraint list that changed since it last ran. See
+** Propagator.h.
+*/
+
+/*
+** Generalized arc consistency for each region. A maximum matching between
+** the region's squares and values is found; if it doesn't cover every
+** square, the puzzle has no solution. A value is removed from a square's
+** domain if no maximum matching assigns it to that square, found with the
+** strongly connected components of the matching's alternating graph.
+**
+** This subsumes naked and hidden subsets of any size within a region.
+*/
+PropagateResult AllDifferent(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Scheduling for AllDifferent. Woken when a region changes; in the medium
+** cost tier.
+*/
+extern const Propagator allDifferentPropagator;
+
+#endif // !ALL_DIFFERENT_PROPAGATOR_H
@@ -0,0 +1,772 @@
+/*
+** ChainPropagator.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "ChainPropagator.h"
+
+#include "../common/Domain.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+/* Maximum number of regions containing every value that may share a square */
+enum {
+    MAX_CELL_REGIONS = 8
+};
+
+static ChainBudget chainBudget = {
+    5000,       /* coloringMaxSteps */
+    8,          /* xyChainMaxLength */
+    20000,      /* xyChainMaxSteps */
+    8,          /* forcingChainMaxDepth */
+    100000      /* forcingChainMaxSteps */
+};
+
+/*
+** Flattened view of the puzzle used by the chain searches. Cells are indexed
+** row-wise from the top left. Arrays are sized for the puzzle's grid and
+** share one allocation, so memory grows with the number of cells. Each chain
+** propagator's grid is kept by the engine between runs; work arrays are set
+** up by the search using them.
+**
+**  squares - The grid's square array.
+**
+**  numValues - Number of square values. Regions of this size contain every
+**              value once.
+**
+**  regionCells - Cells of each region containing every value, numValues
+**                cells per region.
+**
+**  cellRegions - For each cell, MAX_CELL_REGIONS slots holding the regions in
+**                regionCells containing it.
+**
+**  peerStart, peers - The compiled peers of the puzzle's uniqueValue list.
+**                     See Constraint.h.
+**
+**  links, numLinks, members, color, colored - Simple coloring work arrays.
+**
+**  chain, inChain - XY-chain work arrays.
+**
+**  queue, depth, fixed, domainsA, domainsB - Forcing chain work arrays.
+**
+**  steps - Steps remaining in the budget of the current search.
+**
+**  delta - Delta of the current run, to which reductions are reported.
+*/
+typedef struct {
+    unsigned int numCells;
+    unsigned int numValues;
+    GridSquare* squares;
+    CellIndex* regionCells;
+    unsigned int numRegions;
+    unsigned int* cellRegions;
+    unsigned int* numCellRegions;
+    const unsigned int* peerStart;
+    const CellIndex* peers;
+    CellIndex* links;
+    unsigned int* numLinks;
+    CellIndex* members;
+    unsigned int* color;
+    bool* colored;
+    CellIndex* chain;
+    bool* inChain;
+    CellIndex* queue;
+    unsigned int* depth;
+    bool* fixed;
+    Domain* domainsA;
+    Domain* domainsB;
+    unsigned int steps;
+    const PropagationDelta* delta;
+} ChainGrid;
+
+/*****************************************************************************/
+/* Budget                                                                    */
+/*****************************************************************************/
+
+ChainBudget GetChainBudget(void)
+{
+    return chainBudget;
+}
+
+void SetChainBudget(const ChainBudget budget)
+{
+    chainBudget = budget;
+}
+
+/*****************************************************************************/
+/* Helper functions                                                          */
+/*****************************************************************************/
+
+static void DestroyChainGrid(void* chainGrid)
+{
+    if (chainGrid != NULL) {
+        free(((ChainGrid*)chainGrid)->domainsA);
+        free(chainGrid);
+    }
+}
+
+/*
+** Allocates the arrays of cg in one block.
+*/
+static bool AllocateChainGrid(ChainGrid* cg, const unsigned int numConstraints)
+{
+    const unsigned int numCells = cg->numCells;
+    size_t size = 0;
+    char* block = NULL;
+
+    /* Widest types first, so every array is aligned */
+    size = 2 * numCells * sizeof(Domain)
+         + (numCells * MAX_CELL_REGIONS + 4 * numCells) * sizeof(unsigned int)
+         + (numConstraints * cg->numValues + numCells * MAX_CELL_REGIONS + 3 * numCells) * sizeof(CellIndex)
+         + 3 * numCells * sizeof(bool);
+
+    block = (char*)calloc(1, size);
+    if (block == NULL) return false;
+
+    cg->domainsA = (Domain*)block;                      block += numCells * sizeof(Domain);
+    cg->domainsB = (Domain*)block;                      block += numCells * sizeof(Domain);
+    cg->cellRegions = (unsigned int*)block;             block += numCells * MAX_CELL_REGIONS * sizeof(unsigned int);
+    cg->numCellRegions = (unsigned int*)block;          block += numCells * sizeof(unsigned int);
+    cg->numLinks = (unsigned int*)block;                block += numCells * sizeof(unsigned int);
+    cg->color = (unsigned int*)block;                   block += numCells * sizeof(unsigned int);
+    cg->depth = (unsigned int*)block;                   block += numCells * sizeof(unsigned int);
+    cg->regionCells = (CellIndex*)block;                block += numConstraints * cg->numValues * sizeof(CellIndex);
+    cg->links = (CellIndex*)block;                      block += numCells * MAX_CELL_REGIONS * sizeof(CellIndex);
+    cg->members = (CellIndex*)block;                    block += numCells * sizeof(CellIndex);
+    cg->chain = (CellIndex*)block;                      block += numCells * sizeof(CellIndex);
+    cg->queue = (CellIndex*)block;                      block += numCells * sizeof(CellIndex);
+    cg->colored = (bool*)block;                         block += numCells * sizeof(bool);
+    cg->inChain = (bool*)block;                         block += numCells * sizeof(bool);
+    cg->fixed = (bool*)block;
+
+    return true;
+}
+
+/*
+** Builds the flattened view of the puzzle. The view only depends on the
+** puzzle's structure, so the engine keeps it between runs. Returns NULL if
+** memory can't be allocated.
+*/
+static void* CreateChainGrid(SudokuPuzzle* pzl)
+{
+    const Constraint* constraints = pzl->uniqueValue->constraints;
+    const unsigned int numConstraints = pzl->uniqueValue->numConstraints;
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    ChainGrid* newGrid = (ChainGrid*)calloc(1, sizeof(ChainGrid));
+    unsigned int index = 0;
+
+    if (newGrid == NULL) return NULL;
+
+    newGrid->numCells = gridOrder * gridOrder;
+    newGrid->numValues = gridOrder;
+    newGrid->squares = GetSquares(pzl->grid);
+
+    newGrid->peerStart = pzl->uniqueValue->peerStart;
+    newGrid->peers = pzl->uniqueValue->peers;
+
+    if (!AllocateChainGrid(newGrid, numConstraints)) {
+        DestroyChainGrid(newGrid);
+        return NULL;
+    }
+
+    for (index = 0; index < numConstraints; ++index) {
+        const Region* region = &constraints[index].region;
+        unsigned int a = 0;
+
+        /* Bilocal values and hidden singles only apply to regions containing every value */
+        if (region->regionSize == newGrid->numValues) {
+            for (a = 0; a < newGrid->numValues; ++a) {
+                const CellIndex cellA = region->cells[a];
+
+                newGrid->regionCells[newGrid->numRegions * newGrid->numValues + a] = cellA;
+
+                assert(newGrid->numCellRegions[cellA] < MAX_CELL_REGIONS);
+                newGrid->cellRegions[cellA * MAX_CELL_REGIONS + newGrid->numCellRegions[cellA]++] = newGrid->numRegions;
+            }
+
+            ++newGrid->numRegions;
+        }
+    }
+
+    return newGrid;
+}
+
+/*
+** Returns the peers of cell, NumPeers(cg, cell) cells in ascending order.
+*/
+static const CellIndex* CellPeers(const ChainGrid* cg, const CellIndex cell)
+{
+    return &cg->peers[cg->peerStart[cell]];
+}
+
+static unsigned int NumPeers(const ChainGrid* cg, const CellIndex cell)
+{
+    return cg->peerStart[cell + 1] - cg->peerStart[cell];
+}
+
+/*
+** Returns true if two different cells share any region.
+*/
+static bool IsPeer(const ChainGrid* cg, const CellIndex a, const CellIndex b)
+{
+    const CellIndex* peers = CellPeers(cg, a);
+    unsigned int low = 0;
+    unsigned int high = NumPeers(cg, a);
+
+    while (low < high) {
+        const unsigned int middle = (low + high) / 2;
+
+        if (peers[middle] == b) return true;
+
+        if (peers[middle] < b) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return false;
+}
+
+/*
+** Uses one step of the current budget. Returns false if the budget is spent.
+*/
+static bool TakeStep(ChainGrid* cg)
+{
+    if (cg->steps == 0) return false;
+
+    --cg->steps;
+    return true;
+}
+
+static bool IsOpen(const ChainGrid* cg, const CellIndex cell)
+{
+    return (cg->squares[cell].value == VALUE_NONE);
+}
+
+static bool IsBivalue(const ChainGrid* cg, const CellIndex cell)
+{
+    return IsOpen(cg, cell) && (DomNumElements(cg->squares[cell].domain) == 2);
+}
+
+/*
+** Returns the value of a bivalue domain that isn't value.
+*/
+static SquareValue OtherValue(const Domain domain, const SquareValue value)
+{
+    Domain other = domain;
+
+    DomRemoveElement(&other, value);
+    assert(DomIsSingletonDomain(other));
+
+    return DomGetLSValue(other);
+}
+
+/*
+** Removes value from the domain of an open cell.
+*/
+static PropagateResult RemoveCandidate(ChainGrid* cg, const CellIndex cell, const SquareValue value)
+{
+    GridSquare* square = &cg->squares[cell];
+
+    if ((square->value != VALUE_NONE) || !DomRemoveElement(&square->domain, value)) return PROPAGATE_NO_CHANGE;
+    ReportChange(cg->delta, cell);
+
+    return DomIsEmptyDomain(square->domain) ? PROPAGATE_CONTRADICTION : PROPAGATE_CHANGED;
+}
+
+/*
+** Sets the domain of an open cell to newDomain if it's a reduction.
+*/
+static PropagateResult ReduceDomain(ChainGrid* cg, const CellIndex cell, const Domain newDomain)
+{
+    GridSquare* square = &cg->squares[cell];
+
+    if ((square->value != VALUE_NONE) || (DomNumElements(newDomain) == DomNumElements(square->domain))) return PROPAGATE_NO_CHANGE;
+
+    square->domain = newDomain;
+    ReportChange(cg->delta, cell);
+    return DomIsEmptyDomain(newDomain) ? PROPAGATE_CONTRADICTION : PROPAGATE_CHANGED;
+}
+
+/*****************************************************************************/
+/* Simple coloring                                                           */
+/*****************************************************************************/
+
+/*
+** Colors and evaluates each connected group of bilocal links for value.
+*/
+static PropagateResult ColorValue(ChainGrid* cg, const SquareValue value)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    CellIndex* links = cg->links;
+    unsigned int* numLinks = cg->numLinks;
+    bool* colored = cg->colored;
+    CellIndex* members = cg->members;
+    unsigned int* color = cg->color;
+    unsigned int region = 0;
+    unsigned int start = 0;
+
+    for (start = 0; start < cg->numCells; ++start) {
+        numLinks[start] = 0;
+        colored[start] = false;
+    }
+
+    /* Link the two possible cells of value in each region */
+    for (region = 0; region < cg->numRegions; ++region) {
+        const CellIndex* cells = &cg->regionCells[region * cg->numValues];
+        CellIndex ends[2] = { 0 };
+        unsigned int numEnds = 0;
+        unsigned int position = 0;
+
+        for (position = 0; (position < cg->numValues) && (numEnds <= 2); ++position) {
+            if (IsOpen(cg, cells[position]) && DomContainsElement(cg->squares[cells[position]].domain, value)) {
+                if (numEnds < 2) ends[numEnds] = cells[position];
+                ++numEnds;
+            }
+        }
+
+        if (numEnds == 2) {
+            links[ends[0] * MAX_CELL_REGIONS + numLinks[ends[0]]++] = ends[1];
+            links[ends[1] * MAX_CELL_REGIONS + numLinks[ends[1]]++] = ends[0];
+        }
+    }
+
+    for (start = 0; (start < cg->numCells) && (result != PROPAGATE_CONTRADICTION); ++start) {
+        unsigned int numMembers = 0;
+        unsigned int visited = 0;
+        unsigned int falseColor = 2;    /* Neither color */
+        unsigned int a = 0;
+
+        if (colored[start] || (numLinks[start] == 0)) continue;
+
+        /* Breadth first search, alternating colors */
+        members[numMembers++] = (CellIndex)start;
+        colored[start] = true;
+        color[start] = 0;
+
+        while (visited < numMembers) {
+            const CellIndex cell = members[visited++];
+            unsigned int link = 0;
+
+            for (link = 0; link < numLinks[cell]; ++link) {
+                const CellIndex next = links[cell * MAX_CELL_REGIONS + link];
+
+                if (!TakeStep(cg)) return result;
+                if (colored[next]) continue;
+
+                colored[next] = true;
+                color[next] = 1 - color[cell];
+                members[numMembers++] = next;
+            }
+        }
+
+        /* Two squares of the same color sharing a region means that color is false */
+        for (a = 0; (a < numMembers) && (falseColor == 2); ++a) {
+            unsigned int b = 0;
+
+            for (b = a + 1; b < numMembers; ++b) {
+                if (!TakeStep(cg)) return result;
+
+                if ((color[members[a]] == color[members[b]]) && IsPeer(cg, members[a], members[b])) {
+                    falseColor = color[members[a]];
+                    break;
+                }
+            }
+        }
+
+        if (falseColor != 2) {
+            for (a = 0; (a < numMembers) && (result != PROPAGATE_CONTRADICTION); ++a) {
+                if (color[members[a]] == falseColor) result = MergeResult(result, RemoveCandidate(cg, members[a], value));
+            }
+
+            continue;
+        }
+
+        /* Squares sharing regions with both colors can't hold value */
+        for (a = 0; (a < cg->numCells) && (result != PROPAGATE_CONTRADICTION); ++a) {
+            bool seesColor[2] = { false, false };
+            unsigned int b = 0;
+
+            if (colored[a] || !IsOpen(cg, (CellIndex)a) || !DomContainsElement(cg->squares[a].domain, value)) continue;
+
+            for (b = 0; b < numMembers; ++b) {
+                if (!TakeStep(cg)) return result;
+                if (IsPeer(cg, (CellIndex)a, members[b])) seesColor[color[members[b]]] = true;
+            }
+
+            if (seesColor[0] && seesColor[1]) result = MergeResult(result, RemoveCandidate(cg, (CellIndex)a, value));
+        }
+    }
+
+    return result;
+}
+
+PropagateResult SimpleColoring(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    ChainGrid* cg = NULL;
+    SquareValue value = VALUE_1;
+
+    assert(pzl != NULL);
+
+    /* Run on its own, without the grid there's no deduction to make */
+    cg = (ChainGrid*)((delta != NULL) ? delta->state : CreateChainGrid(pzl));
+    if (cg == NULL) return PROPAGATE_NO_CHANGE;
+    cg->steps = chainBudget.coloringMaxSteps;
+    cg->delta = delta;
+
+    for (value = VALUE_1; (value <= cg->numValues) && (result != PROPAGATE_CONTRADICTION) && (cg->steps > 0); ++value) {
+        result = MergeResult(result, ColorValue(cg, value));
+    }
+
+    if (delta == NULL) DestroyChainGrid(cg);
+    return result;
+}
+
+/*****************************************************************************/
+/* XY-chains                                                                 */
+/*****************************************************************************/
+
+/*
+** State of an XY-chain search. If chain[0] isn't startValue, each following
+** square of the chain is forced to a value.
+*/
+typedef struct {
+    ChainGrid* cg;
+    CellIndex* chain;
+    bool* inChain;
+    unsigned int length;
+    SquareValue startValue;
+    PropagateResult result;
+} XYChainSearch;
+
+/*
+** Either the first or last square of the chain is startValue. Removes
+** startValue from squares sharing a region with both.
+*/
+static void ApplyXYChain(XYChainSearch* search)
+{
+    ChainGrid* cg = search->cg;
+    const CellIndex first = search->chain[0];
+    const CellIndex last = search->chain[search->length - 1];
+    unsigned int index = 0;
+
+    for (index = 0; (index < NumPeers(cg, first)) && (search->result != PROPAGATE_CONTRADICTION); ++index) {
+        const CellIndex peer = CellPeers(cg, first)[index];
+
+        if ((peer != last) && IsPeer(cg, last, peer)) {
+            search->result = MergeResult(search->result, RemoveCandidate(cg, peer, search->startValue));
+        }
+    }
+}
+
+/*
+** Extends the chain with each bivalue square that shares a region with the
+** last square of the chain and contains forcedValue, the value the last
+** square is forced to.
+*/
+static void ExtendXYChain(XYChainSearch* search, const SquareValue forcedValue)
+{
+    ChainGrid* cg = search->cg;
+    const CellIndex last = search->chain[search->length - 1];
+    unsigned int index = 0;
+
+    for (index = 0; index < NumPeers(cg, last); ++index) {
+        const CellIndex next = CellPeers(cg, last)[index];
+        SquareValue nextValue = VALUE_NONE;
+
+        if ((search->result == PROPAGATE_CONTRADICTION) || !TakeStep(cg)) return;
+        if (search->inChain[next] || !IsBivalue(cg, next)) continue;
+        if (!DomContainsElement(cg->squares[next].domain, forcedValue)) continue;
+
+        /* next can't be forcedValue, so it must be its other value */
+        nextValue = OtherValue(cg->squares[next].domain, forcedValue);
+
+        search->chain[search->length++] = next;
+        search->inChain[next] = true;
+
+        if (nextValue == search->startValue) ApplyXYChain(search);
+
+        if (search->length < chainBudget.xyChainMaxLength) ExtendXYChain(search, nextValue);
+
+        search->inChain[next] = false;
+        --search->length;
+    }
+}
+
+PropagateResult XYChains(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    XYChainSearch search = { NULL };
+    CellIndex start = 0;
+
+    assert(pzl != NULL);
+
+    /* Run on its own, without the grid there's no deduction to make */
+    search.cg = (ChainGrid*)((delta != NULL) ? delta->state : CreateChainGrid(pzl));
+    if (search.cg == NULL) return PROPAGATE_NO_CHANGE;
+    search.cg->steps = chainBudget.xyChainMaxSteps;
+    search.cg->delta = delta;
+    search.chain = search.cg->chain;
+    search.inChain = search.cg->inChain;
+    search.result = PROPAGATE_NO_CHANGE;
+
+    for (start = 0; (start < search.cg->numCells) && (search.result != PROPAGATE_CONTRADICTION) && (search.cg->steps > 0); ++start) {
+        Domain startValues = { 0 };
+
+        if (!IsBivalue(search.cg, start)) continue;
+
+        startValues = search.cg->squares[start].domain;
+        while (!DomIsEmptyDomain(startValues) && IsBivalue(search.cg, start)) {
+            search.startValue = DomPopLSValue(&startValues);
+            search.chain[0] = start;
+            search.inChain[start] = true;
+            search.length = 1;
+
+            ExtendXYChain(&search, OtherValue(search.cg->squares[start].domain, search.startValue));
+
+            search.inChain[start] = false;
+        }
+    }
+
+    if (delta == NULL) DestroyChainGrid(search.cg);
+    return search.result;
+}
+
+/*****************************************************************************/
+/* Forcing chains                                                            */
+/*****************************************************************************/
+
+typedef enum {
+    PREMISE_CONSISTENT,         /* No contradiction found within the depth limit */
+    PREMISE_CONTRADICTION,      /* The premise is false */
+    PREMISE_ABANDONED           /* The budget was spent */
+} PremiseResult;
+
+/*
+** Copies the domain of each square into domains.
+*/
+static void LoadDomains(const ChainGrid* cg, Domain* domains)
+{
+    unsigned int cell = 0;
+
+    for (cell = 0; cell < cg->numCells; ++cell) {
+        domains[cell] = cg->squares[cell].domain;
+    }
+}
+
+/*
+** Assigns value to cell in domains and follows the implications: values are
+** removed from squares sharing a region with an assigned square, squares with
+** one remaining value are assigned, and values with one remaining square in a
+** region are assigned. Implications more than forcingChainMaxDepth steps from
+** the premise aren't followed.
+*/
+static PremiseResult FollowPremise(ChainGrid* cg, Domain* domains, const CellIndex cell, const SquareValue value)
+{
+    CellIndex* queue = cg->queue;
+    unsigned int* depth = cg->depth;
+    bool* fixed = cg->fixed;
+    unsigned int head = 0;
+    unsigned int tail = 0;
+    unsigned int index = 0;
+
+    for (index = 0; index < cg->numCells; ++index) {
+        fixed[index] = !IsOpen(cg, (CellIndex)index);
+    }
+
+    DomSetEmpty(&domains[cell]);
+    DomAddElement(&domains[cell], value);
+    fixed[cell] = true;
+    queue[tail] = cell;
+    depth[tail++] = 0;
+
+    while (head < tail) {
+        const CellIndex assigned = queue[head];
+        const unsigned int nextDepth = depth[head++] + 1;
+        const SquareValue assignedValue = DomGetLSValue(domains[assigned]);
+
+        for (index = 0; index < NumPeers(cg, assigned); ++index) {
+            const CellIndex peer = CellPeers(cg, assigned)[index];
+            unsigned int region = 0;
+
+            if (!TakeStep(cg)) return PREMISE_ABANDONED;
+            if (!DomRemoveElement(&domains[peer], assignedValue)) continue;
+            if (DomIsEmptyDomain(domains[peer])) return PREMISE_CONTRADICTION;
+            if (nextDepth >= chainBudget.forcingChainMaxDepth) continue;
+
+            /* Square with one remaining value */
+            if (!fixed[peer] && DomIsSingletonDomain(domains[peer])) {
+                fixed[peer] = true;
+                queue[tail] = peer;
+                depth[tail++] = nextDepth;
+            }
+
+            /* Value with one remaining square in a region not containing the assigned square */
+            for (region = 0; region < cg->numCellRegions[peer]; ++region) {
+                const CellIndex* cells = &cg->regionCells[cg->cellRegions[peer * MAX_CELL_REGIONS + region] * cg->numValues];
+                CellIndex remaining = 0;
+                unsigned int numRemaining = 0;
+                unsigned int position = 0;
+
+                for (position = 0; position < cg->numValues; ++position) {
+                    if (cells[position] == assigned) break;
+
+                    if (DomContainsElement(domains[cells[position]], assignedValue)) {
+                        remaining = cells[position];
+                        ++numRemaining;
+                    }
+                }
+
+                if (position < cg->numValues) continue;
+                if (numRemaining == 0) return PREMISE_CONTRADICTION;
+
+                if ((numRemaining == 1) && !fixed[remaining]) {
+                    DomSetEmpty(&domains[remaining]);
+                    DomAddElement(&domains[remaining], assignedValue);
+                    fixed[remaining] = true;
+                    queue[tail] = remaining;
+                    depth[tail++] = nextDepth;
+                }
+            }
+        }
+    }
+
+    return PREMISE_CONSISTENT;
+}
+
+/*
+** Exactly one of two premises is true. Follows both and applies what they
+** have in common.
+*/
+static PropagateResult ApplyPremises(ChainGrid* cg, const CellIndex cellA, const SquareValue valueA, const CellIndex cellB, const SquareValue valueB)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    Domain* domainsA = cg->domainsA;
+    Domain* domainsB = cg->domainsB;
+    PremiseResult resultA = PREMISE_CONSISTENT;
+    PremiseResult resultB = PREMISE_CONSISTENT;
+    unsigned int cell = 0;
+
+    LoadDomains(cg, domainsA);
+    LoadDomains(cg, domainsB);
+
+    resultA = FollowPremise(cg, domainsA, cellA, valueA);
+    if (resultA == PREMISE_ABANDONED) return PROPAGATE_NO_CHANGE;
+
+    resultB = FollowPremise(cg, domainsB, cellB, valueB);
+    if (resultB == PREMISE_ABANDONED) return PROPAGATE_NO_CHANGE;
+
+    if ((resultA == PREMISE_CONTRADICTION) && (resultB == PREMISE_CONTRADICTION)) return PROPAGATE_CONTRADICTION;
+
+    if (resultA == PREMISE_CONTRADICTION) {
+        Domain domain = cg->squares[cellB].domain;
+
+        DomSetEmpty(&domain);
+        DomAddElement(&domain, valueB);
+        return ReduceDomain(cg, cellB, domain);
+    }
+
+    if (resultB == PREMISE_CONTRADICTION) {
+        Domain domain = cg->squares[cellA].domain;
+
+        DomSetEmpty(&domain);
+        DomAddElement(&domain, valueA);
+        return ReduceDomain(cg, cellA, domain);
+    }
+
+    /* Values removed by both premises */
+    for (cell = 0; (cell < cg->numCells) && (result != PROPAGATE_CONTRADICTION); ++cell) {
+        const Domain possible = DomUnion(domainsA[cell], domainsB[cell]);
+        result = MergeResult(result, ReduceDomain(cg, (CellIndex)cell, DomIntersection(cg->squares[cell].domain, possible)));
+    }
+
+    return result;
+}
+
+PropagateResult ForcingChains(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    ChainGrid* cg = NULL;
+    unsigned int index = 0;
+
+    assert(pzl != NULL);
+
+    /* Run on its own, without the grid there's no deduction to make */
+    cg = (ChainGrid*)((delta != NULL) ? delta->state : CreateChainGrid(pzl));
+    if (cg == NULL) return PROPAGATE_NO_CHANGE;
+    cg->steps = chainBudget.forcingChainMaxSteps;
+    cg->delta = delta;
+
+    /* Bivalue squares */
+    for (index = 0; (index < cg->numCells) && (result != PROPAGATE_CONTRADICTION) && (cg->steps > 0); ++index) {
+        const CellIndex cell = (CellIndex)index;
+        Domain values = { 0 };
+        SquareValue valueA = VALUE_NONE;
+
+        if (!IsBivalue(cg, cell)) continue;
+
+        values = cg->squares[cell].domain;
+        valueA = DomPopLSValue(&values);
+        result = MergeResult(result, ApplyPremises(cg, cell, valueA, cell, DomGetLSValue(values)));
+    }
+
+    /* Bilocal values */
+    for (index = 0; (index < cg->numRegions) && (result != PROPAGATE_CONTRADICTION) && (cg->steps > 0); ++index) {
+        const CellIndex* cells = &cg->regionCells[index * cg->numValues];
+        SquareValue value = VALUE_1;
+
+        for (value = VALUE_1; (value <= cg->numValues) && (result != PROPAGATE_CONTRADICTION); ++value) {
+            CellIndex ends[2] = { 0 };
+            unsigned int numEnds = 0;
+            unsigned int position = 0;
+
+            for (position = 0; (position < cg->numValues) && (numEnds <= 2); ++position) {
+                if (IsOpen(cg, cells[position]) && DomContainsElement(cg->squares[cells[position]].domain, value)) {
+                    if (numEnds < 2) ends[numEnds] = cells[position];
+                    ++numEnds;
+                }
+            }
+
+            if (numEnds == 2) result = MergeResult(result, ApplyPremises(cg, ends[0], value, ends[1], value));
+        }
+    }
+
+    if (delta == NULL) DestroyChainGrid(cg);
+    return result;
+}
+
+/*****************************************************************************/
+/* Scheduling                                                                */
+/*****************************************************************************/
+
+const Propagator simpleColoringPropagator = { SimpleColoring, EVENT_DOMAIN_SHRANK, PROPAGATOR_COST_VERY_HIGH, false, CreateChainGrid, DestroyChainGrid };
+const Propagator xyChainsPropagator = { XYChains, EVENT_DOMAIN_SHRANK, PROPAGATOR_COST_VERY_HIGH, false, CreateChainGrid, DestroyChainGrid };
+const Propagator forcingChainsPropagator = { ForcingChains, EVENT_DOMAIN_SHRANK, PROPAGATOR_COST_VERY_HIGH, false, CreateChainGrid, DestroyChainGrid };
@@ -0,0 +1,111 @@
+/*
+** ChainPropagator.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef CHAIN_PROPAGATOR_H
+#define CHAIN_PROPAGATOR_H
+
+#include "Propagator.h"
+
+/*
+** Chain propagators. Chains follow the implication graph of the puzzle:
+**
+**   - A bivalue square (a square with two values in its domain) that isn't
+**     one value must be the other.
+**
+**   - A bilocal value (a value with two possible squares in a region) that
+**     isn't in one square must be in the other.
+**
+** Chain searches can be expensive, so each chain type has a budget. A search
+** that exceeds its budget is abandoned; deductions made before then are kept.
+** See Propagator.h.
+*/
+
+/*
+** Budgets for each chain type. Steps count squares visited or values removed
+** during a single call to the propagator.
+**
+**  coloringMaxSteps - Budget for SimpleColoring.
+**
+**  xyChainMaxLength - Maximum number of squares in an XY-chain.
+**
+**  xyChainMaxSteps - Budget for XYChains.
+**
+**  forcingChainMaxDepth - Maximum number of implications followed from each
+**                         premise.
+**
+**  forcingChainMaxSteps - Budget for ForcingChains.
+*/
+typedef struct {
+    unsigned int coloringMaxSteps;
+    unsigned int xyChainMaxLength;
+    unsigned int xyChainMaxSteps;
+    unsigned int forcingChainMaxDepth;
+    unsigned int forcingChainMaxSteps;
+} ChainBudget;
+
+/*
+** Gets or sets the budgets used by all chain propagators.
+*/
+ChainBudget GetChainBudget(void);
+void SetChainBudget(const ChainBudget budget);
+
+/*
+** Simple coloring. The squares of each value's bilocal links are colored
+** alternately. If two squares of the same color share a region, that color is
+** false and the value is removed from all squares of that color. A square
+** sharing regions with squares of both colors can't hold the value.
+*/
+PropagateResult SimpleColoring(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** XY-chains. A chain of bivalue squares, each sharing a region with the next,
+** in which each link shares a value. If the first square isn't value x, the
+** chain forces the last square to be x. A square sharing regions with both
+** ends of the chain can't hold x.
+*/
+PropagateResult XYChains(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Forcing chains. Each bivalue square and bilocal value gives two premises,
+** one of which must be true. The implications of each premise are followed
+** to a limited depth. If a premise leads to a contradiction, the other premise
+** is applied. Otherwise, values removed by both premises are removed.
+*/
+PropagateResult ForcingChains(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Scheduling for the propagators above. Each is woken when a domain shrinks
+** and is in the very high cost tier.
+*/
+extern const Propagator simpleColoringPropagator;
+extern const Propagator xyChainsPropagator;
+extern const Propagator forcingChainsPropagator;
+
+#endif // !CHAIN_PROPAGATOR_H
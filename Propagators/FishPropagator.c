@@ -0,0 +1,306 @@
+/*
+** FishPropagator.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "FishPropagator.h"
+
+#include "../common/Domain.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+/* Masks of value and line, for values VALUE_1 through gridOrder */
+#define VALUE_MASKS(masks, info, value) (&(masks)[((value) - VALUE_1) * (info)->gridOrder])
+
+/*
+** Per-value occurrence masks, kept by the engine between runs and updated
+** from the squares shrunk since. The grid order is both the number of values
+** and the number of lines.
+**
+**  rowMasks - For each value and row, the columns of squares without a value
+**             whose domain contains the value.
+**
+**  colMasks - For each value and column, the rows of squares without a value
+**             whose domain contains the value.
+**
+**  delta - Delta of the current run, to which reductions are reported.
+*/
+typedef struct {
+    Grid grid;
+    unsigned int gridOrder;
+    Domain* rowMasks;
+    Domain* colMasks;
+    const PropagationDelta* delta;
+} FishInfo;
+
+/*
+** A fish search over one value and orientation. Base lines are rows and cover
+** lines are columns, or the other way round.
+**
+**  baseMasks - For each base line, the cover lines holding the value.
+**
+**  transposed - True if base lines are columns.
+*/
+typedef struct {
+    FishInfo* info;
+    SquareValue value;
+    Domain* baseMasks;
+    bool transposed;
+    unsigned int fishSize;
+} FishSearch;
+
+/*
+** Allocates a FishInfo for the puzzle's grid, with its masks in the same
+** block. The masks are built by LoadMasks. Returns NULL if memory can't be
+** allocated.
+*/
+static void* CreateFishInfo(SudokuPuzzle* pzl)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const unsigned int numMasks = gridOrder * gridOrder;
+    FishInfo* info = (FishInfo*)malloc(sizeof(FishInfo) + 2 * numMasks * sizeof(Domain));
+
+    if (info == NULL) return NULL;
+
+    info->grid = pzl->grid;
+    info->gridOrder = gridOrder;
+    info->rowMasks = (Domain*)(info + 1);
+    info->colMasks = info->rowMasks + numMasks;
+    info->delta = NULL;
+
+    return info;
+}
+
+static void DestroyFishInfo(void* info)
+{
+    free(info);
+}
+
+/*
+** Builds the occurrence masks with a single pass over the grid.
+*/
+static void LoadMasks(FishInfo* info)
+{
+    const Domain noLines = DomCreate(0, info->gridOrder, false);
+    const unsigned int numMasks = info->gridOrder * info->gridOrder;
+    SquareValue value = VALUE_1;
+    unsigned int index = 0;
+    unsigned int row = 0;
+
+    for (index = 0; index < 2 * numMasks; ++index) {
+        info->rowMasks[index] = noLines;
+    }
+
+    for (row = 0; row < info->gridOrder; ++row) {
+        GridSquare* square = GetRow(info->grid, row);
+        unsigned int col = 0;
+
+        do {
+            assert(square != NULL);
+
+            if (square->value == VALUE_NONE) {
+                Domain candidates = square->domain;
+
+                while (!DomIsEmptyDomain(candidates)) {
+                    value = DomPopLSValue(&candidates);
+                    DomAddElement(&VALUE_MASKS(info->rowMasks, info, value)[row], col);
+                    DomAddElement(&VALUE_MASKS(info->colMasks, info, value)[col], row);
+                }
+            }
+
+            ++col;
+        } while (GetNextColumn(info->grid, &square));
+    }
+}
+
+/*
+** Brings the masks up to date with the squares shrunk since the last run.
+** Domains only shrink between resets, so only bits of the shrunk squares are
+** cleared.
+*/
+static void UpdateMasks(FishInfo* info, const PropagationDelta* delta)
+{
+    unsigned int index = 0;
+
+    for (index = 0; index < delta->numShrunk; ++index) {
+        const unsigned int row = delta->shrunk[index].row;
+        const unsigned int col = delta->shrunk[index].col;
+        const GridSquare* square = GetSquare(info->grid, row, col);
+        SquareValue value = VALUE_1;
+
+        assert(square != NULL);
+
+        for (value = VALUE_1; value <= info->gridOrder; ++value) {
+            if ((square->value == VALUE_NONE) && DomContainsElement(square->domain, value)) continue;
+
+            DomRemoveElement(&VALUE_MASKS(info->rowMasks, info, value)[row], col);
+            DomRemoveElement(&VALUE_MASKS(info->colMasks, info, value)[col], row);
+        }
+    }
+}
+
+/*
+** Removes value from the square at row, col and updates the masks.
+*/
+static PropagateResult RemoveCandidate(FishInfo* info, const SquareValue value, const unsigned int row, const unsigned int col)
+{
+    GridSquare* square = GetSquare(info->grid, row, col);
+    assert(square != NULL);
+    assert(square->value == VALUE_NONE);
+
+    DomRemoveElement(&VALUE_MASKS(info->rowMasks, info, value)[row], col);
+    DomRemoveElement(&VALUE_MASKS(info->colMasks, info, value)[col], row);
+
+    if (!DomRemoveElement(&square->domain, value)) return PROPAGATE_NO_CHANGE;
+    ReportChange(info->delta, (CellIndex)(row * info->gridOrder + col));
+
+    return DomIsEmptyDomain(square->domain) ? PROPAGATE_CONTRADICTION : PROPAGATE_CHANGED;
+}
+
+/*
+** The value must be placed within the cover lines of the base lines in
+** members. Removes the value from cover lines in every other base line.
+*/
+static PropagateResult ApplyFish(FishSearch* search, const Domain members, const Domain covers)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int line = 0;
+
+    /* N lines that need the value with fewer than N places to put it */
+    if (DomNumElements(covers) < DomNumElements(members)) return PROPAGATE_CONTRADICTION;
+
+    for (line = 0; (line < search->info->gridOrder) && (result != PROPAGATE_CONTRADICTION); ++line) {
+        Domain eliminations = DomIntersection(search->baseMasks[line], covers);
+
+        if (DomContainsElement(members, line)) continue;
+
+        while (!DomIsEmptyDomain(eliminations) && (result != PROPAGATE_CONTRADICTION)) {
+            const unsigned int cover = DomPopLSValue(&eliminations);
+
+            if (search->transposed) {
+                result = MergeResult(result, RemoveCandidate(search->info, search->value, cover, line));
+            }
+            else {
+                result = MergeResult(result, RemoveCandidate(search->info, search->value, line, cover));
+            }
+        }
+    }
+
+    return result;
+}
+
+/*
+** Recursively builds combinations of base lines. candidates are the lines
+** that may still be added to members; covers is the union of the members'
+** masks.
+*/
+static PropagateResult FishSearchLines(FishSearch* search, Domain candidates, const Domain members, const Domain covers)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+
+    while (!DomIsEmptyDomain(candidates) && (result != PROPAGATE_CONTRADICTION)) {
+        const unsigned int line = DomPopLSValue(&candidates);
+        const Domain newCovers = DomUnion(covers, search->baseMasks[line]);
+        Domain newMembers = members;
+
+        if (DomNumElements(newCovers) > search->fishSize) continue;
+
+        DomAddElement(&newMembers, line);
+
+        if (DomNumElements(newMembers) == search->fishSize) {
+            result = MergeResult(result, ApplyFish(search, newMembers, newCovers));
+        }
+        else {
+            result = MergeResult(result, FishSearchLines(search, candidates, newMembers, newCovers));
+        }
+    }
+
+    return result;
+}
+
+/*
+** Searches for fish of each size for one value and orientation.
+*/
+static PropagateResult FindFish(FishInfo* info, const SquareValue value, const bool transposed)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    FishSearch search = { NULL };
+    const Domain noLines = DomCreate(0, info->gridOrder, false);
+    Domain openLines = noLines;
+    unsigned int line = 0;
+
+    search.info = info;
+    search.value = value;
+    search.baseMasks = transposed ? VALUE_MASKS(info->colMasks, info, value) : VALUE_MASKS(info->rowMasks, info, value);
+    search.transposed = transposed;
+
+    /* Lines where the value has already been placed have empty masks */
+    for (line = 0; line < info->gridOrder; ++line) {
+        if (!DomIsEmptyDomain(search.baseMasks[line])) DomAddElement(&openLines, line);
+    }
+
+    /* A fish containing every open line doesn't eliminate anything */
+    for (search.fishSize = 2; (search.fishSize <= MAX_FISH_SIZE) && (search.fishSize < DomNumElements(openLines)); ++search.fishSize) {
+        result = MergeResult(result, FishSearchLines(&search, openLines, noLines, noLines));
+        if (result == PROPAGATE_CONTRADICTION) break;
+    }
+
+    return result;
+}
+
+PropagateResult Fish(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    FishInfo* info = NULL;
+    SquareValue value = VALUE_1;
+
+    assert(pzl != NULL);
+
+    /* Run on its own, without masks there's no deduction to make */
+    info = (FishInfo*)((delta != NULL) ? delta->state : CreateFishInfo(pzl));
+    if (info == NULL) return PROPAGATE_NO_CHANGE;
+    info->delta = delta;
+
+    if ((delta == NULL) || delta->restored) LoadMasks(info);
+    else UpdateMasks(info, delta);
+
+    for (value = VALUE_1; (value <= info->gridOrder) && (result != PROPAGATE_CONTRADICTION); ++value) {
+
+        /* Fish for a value depend only on its possible squares */
+        if ((delta != NULL) && !DomContainsElement(delta->removedValues, value)) continue;
+
+        result = MergeResult(result, FindFish(info, value, false));
+        if (result != PROPAGATE_CONTRADICTION) result = MergeResult(result, FindFish(info, value, true));
+    }
+
+    if (delta == NULL) DestroyFishInfo(info);
+    return result;
+}
+
+const Propagator fishPropagator = { Fish, EVENT_DOMAIN_SHRANK, PROPAGATOR_COST_HIGH, false, CreateFishInfo, DestroyFishInfo };
@@ -0,0 +1,63 @@
+/*
+** FishPropagator.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef FISH_PROPAGATOR_H
+#define FISH_PROPAGATOR_H
+
+#include "Propagator.h"
+
+/*
+** Fish propagator. Evaluates the rows and columns of the grid, which must
+** each contain every value exactly once (as in standard Sudoku). See
+** Propagator.h.
+*/
+
+/* Largest fish considered by Fish */
+enum {
+    MAX_FISH_SIZE = 4
+};
+
+/*
+** X-Wing (size 2), Swordfish (size 3), and Jellyfish (size 4). If the possible
+** squares for a value in N rows all lie within the same N columns, the value
+** must be placed in those columns within those rows. It's removed from the
+** domains of the other squares in the N columns. The same applies with rows
+** and columns exchanged.
+**
+** Only values removed from a domain since the last run are searched.
+*/
+PropagateResult Fish(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Scheduling for Fish. Woken when a domain shrinks; in the high cost tier.
+*/
+extern const Propagator fishPropagator;
+
+#endif // !FISH_PROPAGATOR_H
@@ -0,0 +1,490 @@
+/*
+** KillerPropagator.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "KillerPropagator.h"
+
+#include "../common/Domain.h"
+#include "../KillerConstraints.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+/*
+** Orders with combination tables fit in the first word of a domain, so
+** combinations are applied to that word directly.
+*/
+#define DOMAIN_MASK(square) ((square)->domain.words[0])
+
+/*
+** Squares whose values add up to sum: a cage, or the innies or outies of a
+** region.
+**
+**  allDifferent - True if the squares can't share a value.
+**
+**  delta - Delta of the current run, to which reductions are reported.
+*/
+typedef struct {
+    GridSquare* squares;
+    const CellIndex* cells;
+    unsigned int numCells;
+    unsigned int sum;
+    bool allDifferent;
+    const PropagationDelta* delta;
+} SumGroup;
+
+/*
+** Work space for innies and outies, sized for the grid and kept by the engine
+** between runs.
+**
+**  cages - Cages cageOf was built from.
+**
+**  cageOf - Cage of each square by cell index, 1 through numCages, or 0.
+**
+**  numInRegion - For each cage, the number of its squares in the region.
+**
+**  counted - For each cage, true once its sum has been counted.
+**
+**  groupCells - Cells of the innies or outies.
+**
+**  changed - For each cage, true if the domain of one of its squares was
+**            reduced since the last run.
+*/
+typedef struct {
+    const ConstraintList* cages;
+    unsigned int* cageOf;
+    unsigned int* numInRegion;
+    bool* counted;
+    CellIndex* groupCells;
+    bool* changed;
+} CageInfo;
+
+/*
+** Reduces the domain of a group's square to its values in allowed. A square
+** with a value isn't modified, but is a contradiction if allowed doesn't hold
+** it.
+*/
+static PropagateResult RestrictDomain(const SumGroup* group, const CellIndex cell, const Domain allowed)
+{
+    GridSquare* square = &group->squares[cell];
+    Domain restricted = DomIntersection(square->domain, allowed);
+
+    if (DomIsEmptyDomain(restricted)) return PROPAGATE_CONTRADICTION;
+    if ((square->value != VALUE_NONE) || (DomNumElements(restricted) == DomNumElements(square->domain))) return PROPAGATE_NO_CHANGE;
+
+    square->domain = restricted;
+    ReportChange(group->delta, cell);
+    return PROPAGATE_CHANGED;
+}
+
+/*
+** Removes values fixed in a group from the domains of its other squares.
+*/
+static PropagateResult RemoveFixedValues(const SumGroup* group)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int fixedIndex = 0;
+
+    for (fixedIndex = 0; (fixedIndex < group->numCells) && (result != PROPAGATE_CONTRADICTION); ++fixedIndex) {
+        const GridSquare* fixed = &group->squares[group->cells[fixedIndex]];
+        DomElementValue value = 0;
+        unsigned int index = 0;
+
+        if (!DomIsSingletonDomain(fixed->domain)) continue;
+        value = DomGetLSValue(fixed->domain);
+
+        for (index = 0; index < group->numCells; ++index) {
+            GridSquare* square = &group->squares[group->cells[index]];
+
+            if ((index == fixedIndex) || !DomContainsElement(square->domain, value)) continue;
+
+            /* Two squares fixed to the same value */
+            if (DomIsSingletonDomain(square->domain)) return PROPAGATE_CONTRADICTION;
+
+            if (square->value == VALUE_NONE) {
+                DomRemoveElement(&square->domain, value);
+                ReportChange(group->delta, group->cells[index]);
+                result = PROPAGATE_CHANGED;
+            }
+        }
+    }
+
+    return result;
+}
+
+/*
+** Keeps the values of each square within the bounds of the group's sum: the
+** sum less the largest and smallest values the other squares could hold.
+*/
+static PropagateResult PruneBounds(const SumGroup* group)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int minTotal = 0;
+    unsigned int maxTotal = 0;
+    unsigned int index = 0;
+
+    for (index = 0; index < group->numCells; ++index) {
+        const GridSquare* square = &group->squares[group->cells[index]];
+
+        if (DomIsEmptyDomain(square->domain)) return PROPAGATE_CONTRADICTION;
+
+        minTotal += DomGetLSValue(square->domain);
+        maxTotal += DomGetMSValue(square->domain);
+    }
+
+    if ((minTotal > group->sum) || (maxTotal < group->sum)) return PROPAGATE_CONTRADICTION;
+
+    for (index = 0; (index < group->numCells) && (result != PROPAGATE_CONTRADICTION); ++index) {
+        GridSquare* square = &group->squares[group->cells[index]];
+        const unsigned int othersMin = minTotal - DomGetLSValue(square->domain);
+        const unsigned int othersMax = maxTotal - DomGetMSValue(square->domain);
+        Domain candidates = square->domain;
+        Domain allowed = square->domain;
+
+        while (!DomIsEmptyDomain(candidates)) {
+            const DomElementValue value = DomPopLSValue(&candidates);
+
+            if ((value + othersMin > group->sum) || (value + othersMax < group->sum)) DomRemoveElement(&allowed, value);
+        }
+
+        result = MergeResult(result, RestrictDomain(group, group->cells[index], allowed));
+    }
+
+    return result;
+}
+
+/*
+** Keeps the values of each square that are in a combination the group can
+** hold: every value of the combination is in some square's domain, and every
+** square's domain holds a value of the combination. A value every such
+** combination needs, with one possible square, is placed in that square.
+*/
+static PropagateResult PruneCombinations(const SumGroup* group, const CageCombinations* combinations, const unsigned int gridOrder)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    DomWord available = 0;
+    DomWord allowedMask = 0;
+    DomWord required = ~(DomWord)0;
+    Domain allowed = DomCreate(VALUE_1, gridOrder, false);
+    unsigned int combination = 0;
+    unsigned int index = 0;
+
+    for (index = 0; index < group->numCells; ++index) {
+        available |= DOMAIN_MASK(&group->squares[group->cells[index]]);
+    }
+
+    for (combination = 0; combination < combinations->numMasks; ++combination) {
+        const DomWord mask = combinations->masks[combination];
+
+        if (mask & ~available) continue;
+
+        for (index = 0; index < group->numCells; ++index) {
+            if (!(DOMAIN_MASK(&group->squares[group->cells[index]]) & mask)) break;
+        }
+
+        if (index < group->numCells) continue;
+
+        allowedMask |= mask;
+        required &= mask;
+    }
+
+    if (allowedMask == 0) return PROPAGATE_CONTRADICTION;
+
+    allowed.words[0] = allowedMask;
+    for (index = 0; (index < group->numCells) && (result != PROPAGATE_CONTRADICTION); ++index) {
+        result = MergeResult(result, RestrictDomain(group, group->cells[index], allowed));
+    }
+
+    while ((required != 0) && (result != PROPAGATE_CONTRADICTION)) {
+        const DomWord bit = required & (~required + 1);
+        GridSquare* only = NULL;
+        CellIndex onlyCell = 0;
+        unsigned int numSquares = 0;
+
+        required &= ~bit;
+
+        for (index = 0; index < group->numCells; ++index) {
+            GridSquare* square = &group->squares[group->cells[index]];
+
+            if (DOMAIN_MASK(square) & bit) {
+                only = square;
+                onlyCell = group->cells[index];
+                ++numSquares;
+            }
+        }
+
+        if (numSquares == 0) return PROPAGATE_CONTRADICTION;
+
+        if ((numSquares == 1) && (only->value == VALUE_NONE) && !DomIsSingletonDomain(only->domain)) {
+            DOMAIN_MASK(only) = bit;
+            ReportChange(group->delta, onlyCell);
+            result = PROPAGATE_CHANGED;
+        }
+    }
+
+    return result;
+}
+
+/*
+** Prunes a group with the combination table if it has one, or the bounds of
+** its sum otherwise.
+*/
+static PropagateResult PruneSumGroup(const SumGroup* group, const unsigned int gridOrder)
+{
+    CageCombinations combinations = { NULL, 0 };
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+
+    if (group->numCells == 0) return (group->sum == 0) ? PROPAGATE_NO_CHANGE : PROPAGATE_CONTRADICTION;
+
+    if (group->allDifferent) {
+        result = RemoveFixedValues(group);
+        if (result == PROPAGATE_CONTRADICTION) return result;
+
+        if (GetCageCombinations(gridOrder, group->numCells, group->sum, &combinations)) {
+            return MergeResult(result, PruneCombinations(group, &combinations, gridOrder));
+        }
+    }
+
+    return MergeResult(result, PruneBounds(group));
+}
+
+/*
+** Prunes the innies and outies of a region holding every value once. See
+** KillerCages.
+*/
+static PropagateResult PruneRegion(SudokuPuzzle* pzl, CageInfo* info, const Region* region, const PropagationDelta* delta)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const Constraint* cages = pzl->cages->constraints;
+    const unsigned int regionSum = gridOrder * (gridOrder + 1) / 2;
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    SumGroup group = { NULL };
+    unsigned int insideSum = 0;
+    unsigned int touchingSum = 0;
+    bool covered = true;
+    unsigned int position = 0;
+
+    group.squares = GetSquares(pzl->grid);
+    group.cells = info->groupCells;
+    group.delta = delta;
+
+    for (position = 0; position < region->regionSize; ++position) {
+        const unsigned int cage = info->cageOf[region->cells[position]];
+
+        if (cage == 0) continue;
+        ++info->numInRegion[cage - 1];
+        info->counted[cage - 1] = false;
+    }
+
+    /* Innies: squares not in a cage wholly inside the region */
+    for (position = 0; position < region->regionSize; ++position) {
+        const CellIndex cell = region->cells[position];
+        const unsigned int cage = info->cageOf[cell];
+
+        if (cage == 0) covered = false;
+
+        if ((cage != 0) && (info->numInRegion[cage - 1] == cages[cage - 1].region.regionSize)) {
+            if (!info->counted[cage - 1]) insideSum += cages[cage - 1].target;
+            info->counted[cage - 1] = true;
+        }
+        else {
+            info->groupCells[group.numCells++] = cell;
+        }
+    }
+
+    if ((group.numCells > 0) && (group.numCells < region->regionSize)) {
+        group.sum = (insideSum <= regionSum) ? (regionSum - insideSum) : 0;
+        group.allDifferent = true;
+        result = (insideSum <= regionSum) ? PruneSumGroup(&group, gridOrder) : PROPAGATE_CONTRADICTION;
+    }
+
+    /* Outies: squares outside the region of the cages covering it */
+    if (covered && (result != PROPAGATE_CONTRADICTION)) {
+        group.numCells = 0;
+        touchingSum = insideSum;
+
+        for (position = 0; position < region->regionSize; ++position) {
+            const unsigned int cage = info->cageOf[region->cells[position]];
+            const Region* cageRegion = &cages[cage - 1].region;
+            unsigned int cagePosition = 0;
+
+            if (info->counted[cage - 1]) continue;
+            info->counted[cage - 1] = true;
+            touchingSum += cages[cage - 1].target;
+
+            for (cagePosition = 0; cagePosition < cageRegion->regionSize; ++cagePosition) {
+                if (!RegionContainsCell(region, cageRegion->cells[cagePosition])) info->groupCells[group.numCells++] = cageRegion->cells[cagePosition];
+            }
+        }
+
+        if (group.numCells > 0) {
+            group.sum = (touchingSum >= regionSum) ? (touchingSum - regionSum) : 0;
+            group.allDifferent = false;
+            result = (touchingSum >= regionSum) ? PruneSumGroup(&group, gridOrder) : PROPAGATE_CONTRADICTION;
+        }
+    }
+
+    for (position = 0; position < region->regionSize; ++position) {
+        const unsigned int cage = info->cageOf[region->cells[position]];
+        if (cage != 0) info->numInRegion[cage - 1] = 0;
+    }
+
+    return result;
+}
+
+/*
+** Allocates a CageInfo for the puzzle's cages, with its arrays in the same
+** block, and maps each square to its cage. Returns NULL if memory can't be
+** allocated.
+*/
+static void* CreateCageInfo(SudokuPuzzle* pzl)
+{
+    const unsigned int numSquares = GetGridOrder(pzl->grid) * GetGridOrder(pzl->grid);
+    const unsigned int numCages = (pzl->cages != NULL) ? pzl->cages->numConstraints : 0;
+    CageInfo* info = (CageInfo*)calloc(1, sizeof(CageInfo) + (numSquares + numCages) * sizeof(unsigned int) + numSquares * sizeof(CellIndex)
+        + 2 * numCages * sizeof(bool));
+    unsigned int index = 0;
+
+    if (info == NULL) return NULL;
+
+    info->cages = pzl->cages;
+    info->cageOf = (unsigned int*)(info + 1);
+    info->numInRegion = info->cageOf + numSquares;
+    info->groupCells = (CellIndex*)(info->numInRegion + numCages);
+    info->counted = (bool*)(info->groupCells + numSquares);
+    info->changed = info->counted + numCages;
+
+    for (index = 0; index < numCages; ++index) {
+        const Region* region = &pzl->cages->constraints[index].region;
+        unsigned int position = 0;
+
+        for (position = 0; position < region->regionSize; ++position) {
+            info->cageOf[region->cells[position]] = index + 1;
+        }
+    }
+
+    return info;
+}
+
+static void DestroyCageInfo(void* info)
+{
+    free(info);
+}
+
+/*
+** Marks the cages with a square shrunk since the last run. Every cage is
+** marked if the propagator is run on its own, or if domains may have grown
+** since it last ran.
+*/
+static void MarkChangedCages(const ConstraintList* cages, const PropagationDelta* delta, const unsigned int gridOrder, bool* changed)
+{
+    unsigned int index = 0;
+
+    for (index = 0; index < cages->numConstraints; ++index) {
+        changed[index] = (delta == NULL) || delta->restored;
+    }
+
+    if ((delta == NULL) || delta->restored) return;
+
+    for (index = 0; index < delta->numShrunk; ++index) {
+        const CellIndex cell = (CellIndex)(delta->shrunk[index].row * gridOrder + delta->shrunk[index].col);
+        unsigned int cage = 0;
+
+        for (cage = cages->regionStart[cell]; cage < cages->regionStart[cell + 1]; ++cage) {
+            changed[cages->regionIndices[cage]] = true;
+        }
+    }
+}
+
+/*
+** Returns true if a cage meeting the region was changed. The outies of the
+** region come from those cages, so may have changed outside the region.
+*/
+static bool RegionCagesChanged(const CageInfo* info, const Region* region)
+{
+    unsigned int position = 0;
+
+    for (position = 0; position < region->regionSize; ++position) {
+        const unsigned int cage = info->cageOf[region->cells[position]];
+        if ((cage != 0) && info->changed[cage - 1]) return true;
+    }
+
+    return false;
+}
+
+PropagateResult KillerCages(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    CageInfo* info = NULL;
+    SumGroup group = { NULL };
+    unsigned int numCages = 0;
+    unsigned int index = 0;
+
+    assert(pzl != NULL);
+
+    if (pzl->cages == NULL) return PROPAGATE_NO_CHANGE;
+    numCages = pzl->cages->numConstraints;
+
+    /* Run on its own, without work space there's no deduction to make */
+    info = (CageInfo*)((delta != NULL) ? delta->state : CreateCageInfo(pzl));
+    if (info == NULL) return PROPAGATE_NO_CHANGE;
+    assert(info->cages == pzl->cages);
+
+    MarkChangedCages(pzl->cages, delta, gridOrder, info->changed);
+
+    group.squares = GetSquares(pzl->grid);
+    group.allDifferent = true;
+    group.delta = delta;
+
+    /* Only cages with a reduced square can be pruned further */
+    for (index = 0; (index < numCages) && (result != PROPAGATE_CONTRADICTION); ++index) {
+        const Constraint* cage = &pzl->cages->constraints[index];
+
+        if (!info->changed[index]) continue;
+
+        group.cells = cage->region.cells;
+        group.numCells = cage->region.regionSize;
+        group.sum = cage->target;
+        result = MergeResult(result, PruneSumGroup(&group, gridOrder));
+    }
+
+    for (index = 0; (index < pzl->uniqueValue->numConstraints) && (result != PROPAGATE_CONTRADICTION); ++index) {
+        const Region* region = &pzl->uniqueValue->constraints[index].region;
+
+        if (region->regionSize != gridOrder) continue;
+        if ((delta != NULL) && !delta->changedRegions[index] && !RegionCagesChanged(info, region)) continue;
+        result = MergeResult(result, PruneRegion(pzl, info, region, delta));
+    }
+
+    if (delta == NULL) DestroyCageInfo(info);
+    return result;
+}
+
+const Propagator killerCagePropagator = { KillerCages, EVENT_DOMAIN_SHRANK, PROPAGATOR_COST_MEDIUM, false, CreateCageInfo, DestroyCageInfo };
\ No newline at end of file
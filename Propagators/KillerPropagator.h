@@ -0,0 +1,72 @@
+/*
+** KillerPropagator.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef KILLER_PROPAGATOR_H
+#define KILLER_PROPAGATOR_H
+
+#include "Propagator.h"
+
+/*
+** Killer cage propagator. Evaluates the puzzle's cages, see
+** KillerConstraints.h, and does nothing for puzzles without them. See
+** Propagator.h.
+*/
+
+/*
+** Prunes each cage and the innies and outies of each region:
+**
+**  - A value fixed in a cage is removed from the cage's other squares.
+**
+**  - Only values in a combination of different values that adds up to the
+**    cage's sum, and that can be spread over the cage's squares, are kept. A
+**    value in every such combination with one possible square is placed
+**    there. Combinations come from the tables in KillerConstraints.h; grids
+**    too large for a table keep values within the sum's bounds instead.
+**
+**  - A region holding every value once adds up to 1 + 2 + ... + gridOrder.
+**    Taking away the cages wholly inside the region leaves the innies, the
+**    region's other squares, with a known sum. They're pruned as a cage.
+**
+**  - If the cages meeting a region cover it, their squares outside the
+**    region, the outies, add up to the cages' sums less the region's. Outies
+**    may share values, so only values within the sum's bounds are kept.
+**
+** Only cages with a square reduced since the last run, and regions meeting
+** them or with a reduced square, are pruned.
+*/
+PropagateResult KillerCages(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Scheduling for KillerCages. Woken when a domain shrinks; in the medium cost
+** tier. The AC3 solvers add it for puzzles with cages.
+*/
+extern const Propagator killerCagePropagator;
+
+#endif // !KILLER_PROPAGATOR_H
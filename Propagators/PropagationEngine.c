@@ -0,0 +1,463 @@
+/*
+** PropagationEngine.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "PropagationEngine.h"
+
+#include "../common/Domain.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+/*
+** Squares reported changed since the engine last recorded changes. Each square
+** is listed once.
+*/
+struct _ChangeListType {
+    CellIndex* cells;
+    bool* listed;
+    unsigned int numCells;
+};
+
+/*
+** A recorded domain change.
+*/
+typedef struct {
+    GridLocation location;
+    PropagateEvents events;
+    Domain removed;
+} ChangeRecord;
+
+/*
+** A propagator added to the engine.
+**
+**  nextRecord - First change record the propagator hasn't been given.
+**
+**  woken - True if a change the propagator subscribes to was recorded
+**          since it last ran.
+**
+**  state - The propagator's state, or NULL if it keeps none.
+**
+**  restored - True until the propagator first runs, and again after the
+**             engine is reset. See PropagationDelta.
+*/
+typedef struct {
+    const Propagator* propagator;
+    unsigned int nextRecord;
+    bool woken;
+    void* state;
+    bool restored;
+} EngineEntry;
+
+/*
+** Engine state.
+**
+**  domains - Domain of each square as of the last recorded change, indexed
+**            row-wise.
+**
+**  changes - Squares reported changed since then.
+**
+**  scanAll - True until the first run, which compares every domain to pick
+**            up the squares reduced before the engine was created.
+**
+**  records - Every change recorded. Each record removes at least one value
+**            from a domain, so the number of records is bounded.
+**
+**  regionStart, regionIndices - The regions containing square n, from the
+**                               puzzle's compiled uniqueValue list. See
+**                               Constraint.h.
+**
+**  fixed, shrunk, changedRegions - Storage for the delta given to a
+**                                  propagator.
+*/
+struct _PropagationEngineType {
+    SudokuPuzzle* pzl;
+    unsigned int gridOrder;
+    unsigned int numSquares;
+    unsigned int numRegions;
+    Domain* domains;
+    struct _ChangeListType changes;
+    bool scanAll;
+    ChangeRecord* records;
+    unsigned int numRecords;
+    unsigned int maxRecords;
+    const unsigned int* regionStart;
+    const unsigned int* regionIndices;
+    GridLocation* fixed;
+    GridLocation* shrunk;
+    bool* changedRegions;
+    EngineEntry entries[MAX_ENGINE_PROPAGATORS];
+    unsigned int numEntries;
+    EngineStats stats;
+};
+
+/*****************************************************************************/
+/* Helper functions                                                          */
+/*****************************************************************************/
+
+/*
+** Wakes the propagators subscribed to events. source is the propagator that
+** made the change, or NULL.
+*/
+static void WakePropagators(PropagationEngine engine, const EngineEntry* source, const PropagateEvents events)
+{
+    unsigned int index = 0;
+
+    for (index = 0; index < engine->numEntries; ++index) {
+        EngineEntry* entry = &engine->entries[index];
+
+        if ((entry->propagator->events & events) == 0) continue;
+
+        if (entry->woken || ((entry == source) && entry->propagator->idempotent)) {
+            ++engine->stats.numSkipped;
+        }
+        else {
+            entry->woken = true;
+        }
+    }
+}
+
+/*
+** Lists cell as changed, unless it already is.
+*/
+static void ListChange(struct _ChangeListType* changes, const CellIndex cell)
+{
+    if (changes->listed[cell]) return;
+
+    changes->listed[cell] = true;
+    changes->cells[changes->numCells++] = cell;
+}
+
+/*
+** Compares the domains of the squares reported changed with their previous
+** state, recording and announcing the changes. source is the propagator that
+** was just run, or NULL.
+*/
+static PropagateResult RecordChanges(PropagationEngine engine, EngineEntry* source)
+{
+    const GridSquare* squares = GetSquares(engine->pzl->grid);
+    struct _ChangeListType* changes = &engine->changes;
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int index = 0;
+
+    for (index = 0; index < changes->numCells; ++index) {
+        const CellIndex square = changes->cells[index];
+        const GridSquare* gridSquare = &squares[square];
+        ChangeRecord* record = NULL;
+
+        changes->listed[square] = false;
+        if (DomNumElements(gridSquare->domain) == DomNumElements(engine->domains[square])) continue;
+
+        /* Domains only shrink */
+        assert(DomIsEmptyDomain(DomDifference(gridSquare->domain, engine->domains[square])));
+        assert(engine->numRecords < engine->maxRecords);
+
+        record = &engine->records[engine->numRecords++];
+        record->location.row = square / engine->gridOrder;
+        record->location.col = square % engine->gridOrder;
+        record->removed = DomDifference(engine->domains[square], gridSquare->domain);
+        record->events = EVENT_DOMAIN_SHRANK | EVENT_REGION_CHANGED;
+        if (DomIsSingletonDomain(gridSquare->domain)) record->events |= EVENT_VALUE_FIXED;
+
+        engine->domains[square] = gridSquare->domain;
+        ++engine->stats.numChanges;
+
+        WakePropagators(engine, source, record->events);
+
+        if (DomIsEmptyDomain(gridSquare->domain)) result = PROPAGATE_CONTRADICTION;
+        else if (result == PROPAGATE_NO_CHANGE) result = PROPAGATE_CHANGED;
+    }
+
+    changes->numCells = 0;
+
+    /* An idempotent propagator has nothing left to do with its own changes */
+    if ((source != NULL) && source->propagator->idempotent) source->nextRecord = engine->numRecords;
+
+    return result;
+}
+
+/*
+** Collects the changes the propagator hasn't been given into delta.
+*/
+static void BuildDelta(PropagationEngine engine, EngineEntry* entry, PropagationDelta* delta)
+{
+    unsigned int numFixed = 0;
+    unsigned int numShrunk = 0;
+    unsigned int index = 0;
+
+    for (index = 0; index < engine->numRegions; ++index) {
+        engine->changedRegions[index] = false;
+    }
+
+    delta->removedValues = DomCreate(VALUE_1, engine->gridOrder, false);
+
+    for (index = entry->nextRecord; index < engine->numRecords; ++index) {
+        const ChangeRecord* record = &engine->records[index];
+        const unsigned int square = record->location.row * engine->gridOrder + record->location.col;
+        unsigned int region = 0;
+
+        if (record->events & EVENT_VALUE_FIXED) engine->fixed[numFixed++] = record->location;
+        engine->shrunk[numShrunk++] = record->location;
+
+        for (region = engine->regionStart[square]; region < engine->regionStart[square + 1]; ++region) {
+            engine->changedRegions[engine->regionIndices[region]] = true;
+        }
+
+        delta->removedValues = DomUnion(delta->removedValues, record->removed);
+    }
+
+    delta->fixed = engine->fixed;
+    delta->numFixed = numFixed;
+    delta->shrunk = engine->shrunk;
+    delta->numShrunk = numShrunk;
+    delta->changedRegions = engine->changedRegions;
+    delta->changes = &engine->changes;
+    delta->state = entry->state;
+    delta->restored = entry->restored;
+
+    entry->nextRecord = engine->numRecords;
+    entry->restored = false;
+}
+
+/*
+** Returns the first woken propagator of the cheapest tier, or NULL if none
+** are woken.
+*/
+static EngineEntry* NextPropagator(PropagationEngine engine)
+{
+    EngineEntry* next = NULL;
+    unsigned int index = 0;
+
+    for (index = 0; index < engine->numEntries; ++index) {
+        EngineEntry* entry = &engine->entries[index];
+
+        if (!entry->woken) continue;
+        if ((next == NULL) || (entry->propagator->cost < next->propagator->cost)) next = entry;
+    }
+
+    return next;
+}
+
+/*****************************************************************************/
+/* Engine functions                                                          */
+/*****************************************************************************/
+
+bool CreatePropagationEngine(PropagationEngine* engine, SudokuPuzzle* pzl)
+{
+    PropagationEngine newEngine = NULL;
+    unsigned int square = 0;
+
+    assert(engine != NULL);
+    assert(pzl != NULL);
+
+    newEngine = (PropagationEngine)calloc(1, sizeof(struct _PropagationEngineType));
+    if (newEngine == NULL) return false;
+
+    newEngine->pzl = pzl;
+    newEngine->gridOrder = GetGridOrder(pzl->grid);
+    newEngine->numSquares = newEngine->gridOrder * newEngine->gridOrder;
+    newEngine->numRegions = pzl->uniqueValue->numConstraints;
+    newEngine->regionStart = pzl->uniqueValue->regionStart;
+    newEngine->regionIndices = pzl->uniqueValue->regionIndices;
+    newEngine->maxRecords = newEngine->numSquares * (newEngine->gridOrder + 1);
+
+    newEngine->domains = (Domain*)malloc(newEngine->numSquares * sizeof(Domain));
+    newEngine->changes.cells = (CellIndex*)malloc(newEngine->numSquares * sizeof(CellIndex));
+    newEngine->changes.listed = (bool*)calloc(newEngine->numSquares, sizeof(bool));
+    newEngine->records = (ChangeRecord*)malloc(newEngine->maxRecords * sizeof(ChangeRecord));
+    newEngine->fixed = (GridLocation*)malloc(newEngine->maxRecords * sizeof(GridLocation));
+    newEngine->shrunk = (GridLocation*)malloc(newEngine->maxRecords * sizeof(GridLocation));
+    newEngine->changedRegions = (bool*)malloc((newEngine->numRegions > 0 ? newEngine->numRegions : 1) * sizeof(bool));
+
+    if ((newEngine->domains == NULL) || (newEngine->changes.cells == NULL) || (newEngine->changes.listed == NULL) || (newEngine->records == NULL) || (newEngine->fixed == NULL) ||
+        (newEngine->shrunk == NULL) || (newEngine->changedRegions == NULL)) {
+        DestroyPropagationEngine(&newEngine);
+        return false;
+    }
+
+    /* Compare against full domains, so every reduced square is a change on the first run */
+    for (square = 0; square < newEngine->numSquares; ++square) {
+        newEngine->domains[square] = DomCreate(VALUE_1, newEngine->gridOrder, true);
+    }
+    newEngine->scanAll = true;
+
+    *engine = newEngine;
+    return true;
+}
+
+void DestroyPropagationEngine(PropagationEngine* engine)
+{
+    if ((engine != NULL) && (*engine != NULL)) {
+        unsigned int index = 0;
+
+        for (index = 0; index < (*engine)->numEntries; ++index) {
+            const EngineEntry* entry = &(*engine)->entries[index];
+            if (entry->state != NULL) entry->propagator->destroyState(entry->state);
+        }
+
+        free((*engine)->domains);
+        free((*engine)->changes.cells);
+        free((*engine)->changes.listed);
+        free((*engine)->records);
+        free((*engine)->fixed);
+        free((*engine)->shrunk);
+        free((*engine)->changedRegions);
+        free(*engine);
+
+        *engine = NULL;
+    }
+}
+
+bool AddPropagator(PropagationEngine engine, const Propagator* propagator)
+{
+    EngineEntry* entry = NULL;
+
+    assert(engine != NULL);
+    assert((propagator != NULL) && (propagator->propagate != NULL));
+
+    assert((propagator->createState == NULL) == (propagator->destroyState == NULL));
+
+    if (engine->numEntries >= MAX_ENGINE_PROPAGATORS) return false;
+
+    entry = &engine->entries[engine->numEntries];
+    entry->propagator = propagator;
+    entry->nextRecord = 0;
+    entry->woken = false;
+    entry->state = NULL;
+    entry->restored = true;
+
+    if (propagator->createState != NULL) {
+        entry->state = propagator->createState(engine->pzl);
+        if (entry->state == NULL) return false;
+    }
+
+    ++engine->numEntries;
+
+    /* Changes already recorded are new to this propagator */
+    if (engine->numRecords > 0) entry->woken = true;
+
+    return true;
+}
+
+bool AddPropagators(PropagationEngine engine, const PropagatorList* propagators)
+{
+    unsigned int index = 0;
+
+    assert(propagators != NULL);
+
+    for (index = 0; index < propagators->numPropagators; ++index) {
+        if (!AddPropagator(engine, propagators->propagators[index])) return false;
+    }
+
+    return true;
+}
+
+PropagateResult RunPropagationEngine(PropagationEngine engine)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    EngineEntry* entry = NULL;
+
+    assert(engine != NULL);
+
+    /* Pick up changes made outside the engine */
+    if (engine->scanAll) {
+        unsigned int square = 0;
+
+        for (square = 0; square < engine->numSquares; ++square) ListChange(&engine->changes, (CellIndex)square);
+        engine->scanAll = false;
+    }
+
+    if (RecordChanges(engine, NULL) == PROPAGATE_CONTRADICTION) return PROPAGATE_CONTRADICTION;
+
+    while ((entry = NextPropagator(engine)) != NULL) {
+        PropagationDelta delta;
+        PropagateResult changes = PROPAGATE_NO_CHANGE;
+
+        if (isSudokuCancelled(engine->pzl)) return PROPAGATE_CONTRADICTION;
+
+        BuildDelta(engine, entry, &delta);
+        entry->woken = false;
+        ++engine->stats.numRuns;
+
+        if (entry->propagator->propagate(engine->pzl, &delta) == PROPAGATE_CONTRADICTION) return PROPAGATE_CONTRADICTION;
+
+        changes = RecordChanges(engine, entry);
+        if (changes == PROPAGATE_CONTRADICTION) return PROPAGATE_CONTRADICTION;
+        if (changes == PROPAGATE_CHANGED) result = PROPAGATE_CHANGED;
+    }
+
+    return result;
+}
+
+void ResetPropagationEngine(PropagationEngine engine)
+{
+    unsigned int index = 0;
+
+    assert(engine != NULL);
+
+    for (index = 0; index < engine->numSquares; ++index) {
+        engine->domains[index] = GetSquares(engine->pzl->grid)[index].domain;
+        engine->changes.listed[index] = false;
+    }
+
+    engine->changes.numCells = 0;
+    engine->scanAll = false;
+
+    for (index = 0; index < engine->numEntries; ++index) {
+        engine->entries[index].nextRecord = 0;
+        engine->entries[index].woken = false;
+        engine->entries[index].restored = true;
+    }
+
+    engine->numRecords = 0;
+}
+
+void ReportEngineChange(PropagationEngine engine, const CellIndex cell)
+{
+    assert(engine != NULL);
+    assert(cell < engine->numSquares);
+
+    ListChange(&engine->changes, cell);
+}
+
+PropagateResult MergeResult(const PropagateResult a, const PropagateResult b)
+{
+    return (a > b) ? a : b;
+}
+
+void ReportChange(const PropagationDelta* delta, const CellIndex cell)
+{
+    if (delta != NULL) ListChange(delta->changes, cell);
+}
+
+EngineStats GetEngineStats(PropagationEngine engine)
+{
+    assert(engine != NULL);
+    return engine->stats;
+}
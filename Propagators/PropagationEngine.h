@@ -0,0 +1,131 @@
+/*
+** PropagationEngine.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef PROPAGATION_ENGINE_H
+#define PROPAGATION_ENGINE_H
+
+#include "Propagator.h"
+
+#include <stdbool.h>
+
+/*
+** Schedules propagators until no more domains can be reduced (fixpoint).
+**
+** Propagators report the squares whose domains they reduce (ReportChange).
+** After each propagator runs, the engine compares the domains of those
+** squares with their previous state and records the changes. Each change
+** wakes the propagators subscribed to its events, and each woken propagator
+** is given the changes made since it last ran. A propagator that hasn't been
+** woken isn't run.
+**
+** The engine always runs the first woken propagator, in the order added, of
+** the cheapest cost tier with a woken propagator. A cheap tier therefore
+** reaches fixpoint before a more expensive tier is run.
+**
+** Domains are assumed to only shrink while the engine runs. Squares whose
+** domain isn't full when the engine is first run are treated as changed.
+** Domains reduced outside the engine after that must be reported with
+** ReportEngineChange.
+*/
+
+typedef struct _PropagationEngineType* PropagationEngine;
+
+/*
+** Work done by the engine.
+**
+**  numRuns - Number of times a propagator was run.
+**
+**  numChanges - Number of domain changes recorded.
+**
+**  numSkipped - Number of wake-ups skipped because the propagator was
+**               already woken, or because it made the change and is
+**               idempotent.
+*/
+typedef struct {
+    unsigned long numRuns;
+    unsigned long numChanges;
+    unsigned long numSkipped;
+} EngineStats;
+
+/* Maximum number of propagators added to an engine */
+enum {
+    MAX_ENGINE_PROPAGATORS = 16
+};
+
+/*
+** Creates a new engine for the puzzle with no propagators.
+**
+** If successful, the engine parameter is updated and true is returned.
+*/
+bool CreatePropagationEngine(PropagationEngine* engine, SudokuPuzzle* pzl);
+
+/*
+** Destroys the engine. The puzzle isn't modified.
+*/
+void DestroyPropagationEngine(PropagationEngine* engine);
+
+/*
+** Adds a propagator, or each propagator in a list, creating the state the
+** engine keeps for it. Returns false if the engine is full or the state can't
+** be allocated.
+*/
+bool AddPropagator(PropagationEngine engine, const Propagator* propagator);
+bool AddPropagators(PropagationEngine engine, const PropagatorList* propagators);
+
+/*
+** Runs the woken propagators until none are left.
+**
+** Returns PROPAGATE_CONTRADICTION if a propagator finds one or a domain is
+** emptied, or if the puzzle is cancelled so the solver stops, PROPAGATE_CHANGED
+** if any domain was reduced, and PROPAGATE_NO_CHANGE otherwise.
+*/
+PropagateResult RunPropagationEngine(PropagationEngine engine);
+
+/*
+** Reports that the domain of the square at cell was reduced outside the
+** engine, so the next run records the change.
+*/
+void ReportEngineChange(PropagationEngine engine, const CellIndex cell);
+
+/*
+** Takes the current domains as the engine's previous state. Recorded changes
+** are discarded and no propagator is woken. Propagators rebuild the state
+** derived from the domains on their next run.
+**
+** Used after the puzzle is restored from a snapshot, which may grow domains.
+*/
+void ResetPropagationEngine(PropagationEngine engine);
+
+/*
+** Returns the work done by the engine since it was created.
+*/
+EngineStats GetEngineStats(PropagationEngine engine);
+
+#endif // !PROPAGATION_ENGINE_H
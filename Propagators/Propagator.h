@@ -0,0 +1,177 @@
+/*
+** Propagator.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef PROPAGATOR_H
+#define PROPAGATOR_H
+
+#include "../SudokuPuzzle.h"
+
+#include <stdbool.h>
+
+/*
+** Propagators apply a deduction rule to the domains of a Sudoku's squares,
+** removing values that can't be part of a solution.
+**
+** Propagators only modify the domains of squares without a value; assigning
+** values and propagating them to other squares is left to the solver. A
+** propagator assumes the domains of squares sharing a region with an assigned
+** square no longer contain the assigned value.
+*/
+
+typedef enum {
+    PROPAGATE_NO_CHANGE,        /* No domains were modified */
+    PROPAGATE_CHANGED,          /* At least one domain was reduced */
+    PROPAGATE_CONTRADICTION     /* The puzzle has no solution */
+} PropagateResult;
+
+/*
+** Returns the more significant of two results, so a contradiction is never
+** masked by a later change.
+*/
+PropagateResult MergeResult(const PropagateResult a, const PropagateResult b);
+
+/*
+** Events a propagator can subscribe to. A propagator is only run after an
+** event it subscribes to has occurred since it last ran.
+*/
+enum {
+    EVENT_VALUE_FIXED = 0x1,        /* A square's domain was reduced to one value */
+    EVENT_DOMAIN_SHRANK = 0x2,      /* A square's domain was reduced */
+    EVENT_REGION_CHANGED = 0x4      /* A domain was reduced within a region */
+};
+
+typedef unsigned int PropagateEvents;
+
+/*
+** Cost tiers. Propagators in a cheaper tier are run to fixpoint before any
+** propagator in a more expensive tier is run.
+*/
+typedef enum {
+    PROPAGATOR_COST_LOW,            /* Work proportional to the changes */
+    PROPAGATOR_COST_MEDIUM,         /* Scans the changed regions */
+    PROPAGATOR_COST_HIGH,           /* Scans the grid */
+    PROPAGATOR_COST_VERY_HIGH,      /* Searches beyond a single scan of the grid */
+    numPropagatorCosts
+} PropagatorCost;
+
+/* Squares changed during a run. See ReportChange. */
+struct _ChangeListType;
+
+/*
+** Changes made since a propagator last ran. A square may be listed more than
+** once.
+**
+**  fixed - Squares whose domain was reduced to one value.
+**
+**  shrunk - Squares whose domain was reduced, including fixed squares.
+**
+**  changedRegions - For each constraint in the puzzle's uniqueValue list,
+**                   true if the domain of a square in its region was reduced.
+**
+**  removedValues - Values removed from any domain.
+**
+**  changes - Where the propagator reports the squares whose domains it
+**            reduces. See ReportChange.
+**
+**  state - The state kept for the propagator between runs. See Propagator.
+**
+**  restored - True on the propagator's first run and after the engine was
+**             reset. Domains may have grown since it last ran, so state
+**             derived from them must be rebuilt.
+*/
+typedef struct {
+    const GridLocation* fixed;
+    unsigned int numFixed;
+    const GridLocation* shrunk;
+    unsigned int numShrunk;
+    const bool* changedRegions;
+    Domain removedValues;
+    struct _ChangeListType* changes;
+    void* state;
+    bool restored;
+} PropagationDelta;
+
+/*
+** Reports that a propagator reduced the domain of the square at cell. The
+** engine only records the changes reported to it, so every domain a
+** propagator reduces must be reported. Reporting a square more than once is
+** harmless. Does nothing if delta is NULL.
+*/
+void ReportChange(const PropagationDelta* delta, const CellIndex cell);
+
+/*
+** delta is NULL when a propagator is run on its own, in which case every
+** square and region is treated as changed.
+*/
+typedef PropagateResult (*PropagatorFunction)(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Creates the state kept for a propagator between runs, sized for pzl.
+** Returns NULL if memory can't be allocated.
+*/
+typedef void* (*PropagatorStateCreate)(SudokuPuzzle* pzl);
+
+typedef void (*PropagatorStateDestroy)(void* state);
+
+/*
+** Describes how a propagator is scheduled. See PropagationEngine.h.
+**
+**  events - Events that wake the propagator.
+**
+**  cost - Cost tier of the propagator.
+**
+**  idempotent - True if running the propagator twice in a row can't reduce
+**               any more domains. Changes made by an idempotent propagator
+**               don't wake it again.
+**
+**  createState, destroyState - Create and destroy the work space the engine
+**                              keeps for the propagator, so it isn't
+**                              allocated on every run. NULL if the
+**                              propagator keeps no state.
+*/
+typedef struct {
+    PropagatorFunction propagate;
+    PropagateEvents events;
+    PropagatorCost cost;
+    bool idempotent;
+    PropagatorStateCreate createState;
+    PropagatorStateDestroy destroyState;
+} Propagator;
+
+/*
+** A list of propagators. Within a cost tier, propagators are run in list
+** order.
+*/
+typedef struct {
+    const Propagator* const* propagators;
+    unsigned int numPropagators;
+} PropagatorList;
+
+#endif // !PROPAGATOR_H
@@ -0,0 +1,395 @@
+/*
+** SubsetPropagator.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "SubsetPropagator.h"
+
+#include "../common/Domain.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+/*
+** Squares and candidate information for a single region. Positions are
+** indices into the region's location array.
+**
+**  squares, cells - GridSquare and cell index for each position in the
+**                   region.
+**
+**  delta - Delta the propagator was run with, for reporting changes.
+**
+**  numValues - Number of square values. Regions of this size contain every
+**              value once.
+**
+**  openSquares - Positions of squares without a value.
+**
+**  unplacedValues - Values not assigned to any square in the region.
+**
+**  valuePositions - For each value, positions of squares without a value
+**                   whose domain contains the value.
+*/
+typedef struct {
+    GridSquare* squares[MAX_SQUARE_VALUE];
+    const CellIndex* cells;
+    const PropagationDelta* delta;
+    unsigned int regionSize;
+    unsigned int numValues;
+    Domain openSquares;
+    Domain unplacedValues;
+    Domain valuePositions[numSquareValues];
+} RegionInfo;
+
+/*****************************************************************************/
+/* Helper functions                                                          */
+/*****************************************************************************/
+
+/*
+** Returns true if the region at index in the uniqueValue list has changed
+** since the propagator last ran. Deductions within an unchanged region have
+** already been made.
+*/
+static bool RegionChanged(const PropagationDelta* delta, const unsigned int index)
+{
+    return (delta == NULL) || delta->changedRegions[index];
+}
+
+/*
+** Collects the squares of region and the domain masks used by the propagators.
+*/
+static void LoadRegionInfo(Grid grid, const Region* region, const PropagationDelta* delta, RegionInfo* info)
+{
+    SquareValue value = VALUE_1;
+    unsigned int position = 0;
+
+    assert((region != NULL) && (info != NULL));
+    assert(region->regionSize <= MAX_SQUARE_VALUE);
+
+    info->cells = region->cells;
+    info->delta = delta;
+    info->regionSize = region->regionSize;
+    info->numValues = GetGridOrder(grid);
+    info->openSquares = DomCreate(0, region->regionSize, false);
+    info->unplacedValues = DomCreate(VALUE_1, info->numValues, true);
+
+    for (value = VALUE_1; value <= info->numValues; ++value) {
+        info->valuePositions[value] = info->openSquares;
+    }
+
+    for (position = 0; position < region->regionSize; ++position) {
+        GridSquare* square = &GetSquares(grid)[region->cells[position]];
+
+        info->squares[position] = square;
+
+        if (square->value != VALUE_NONE) {
+            DomRemoveElement(&info->unplacedValues, square->value);
+        }
+        else {
+            Domain candidates = square->domain;
+
+            DomAddElement(&info->openSquares, position);
+            while (!DomIsEmptyDomain(candidates)) {
+                DomAddElement(&info->valuePositions[DomPopLSValue(&candidates)], position);
+            }
+        }
+    }
+}
+
+/*
+** Sets the domain of the square at position to newDomain if it's a reduction.
+*/
+static PropagateResult ReduceDomain(RegionInfo* info, const unsigned int position, const Domain newDomain)
+{
+    GridSquare* square = info->squares[position];
+
+    assert(square->value == VALUE_NONE);
+
+    if (DomNumElements(newDomain) == DomNumElements(square->domain)) return PROPAGATE_NO_CHANGE;
+
+    square->domain = newDomain;
+    ReportChange(info->delta, info->cells[position]);
+    return DomIsEmptyDomain(newDomain) ? PROPAGATE_CONTRADICTION : PROPAGATE_CHANGED;
+}
+
+/*****************************************************************************/
+/* Naked subsets                                                             */
+/*****************************************************************************/
+
+/*
+** The squares at positions members can only hold the values in combined.
+** Removes those values from all other open squares in the region.
+*/
+static PropagateResult ApplyNakedSubset(RegionInfo* info, const Domain members, const Domain combined)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    Domain others = DomDifference(info->openSquares, members);
+
+    /* N squares with fewer than N possible values */
+    if (DomNumElements(combined) < DomNumElements(members)) return PROPAGATE_CONTRADICTION;
+
+    while (!DomIsEmptyDomain(others) && (result != PROPAGATE_CONTRADICTION)) {
+        const unsigned int position = DomPopLSValue(&others);
+        result = MergeResult(result, ReduceDomain(info, position, DomDifference(info->squares[position]->domain, combined)));
+    }
+
+    return result;
+}
+
+/*
+** Recursively builds combinations of open squares. candidates are the
+** positions that may still be added to members; combined is the union of the
+** members' domains. Combinations are abandoned as soon as their combined
+** domain has more than subsetSize values.
+*/
+static PropagateResult NakedSubsetSearch(RegionInfo* info, const unsigned int subsetSize, Domain candidates, const Domain members, const Domain combined)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+
+    while (!DomIsEmptyDomain(candidates) && (result != PROPAGATE_CONTRADICTION)) {
+        const unsigned int position = DomPopLSValue(&candidates);
+        const Domain newCombined = DomUnion(combined, info->squares[position]->domain);
+        Domain newMembers = members;
+
+        if (DomNumElements(newCombined) > subsetSize) continue;
+
+        DomAddElement(&newMembers, position);
+
+        if (DomNumElements(newMembers) == subsetSize) {
+            result = MergeResult(result, ApplyNakedSubset(info, newMembers, newCombined));
+        }
+        else {
+            result = MergeResult(result, NakedSubsetSearch(info, subsetSize, candidates, newMembers, newCombined));
+        }
+    }
+
+    return result;
+}
+
+PropagateResult NakedSubsets(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    const Constraint* constraints = NULL;
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int index = 0;
+
+    assert(pzl != NULL);
+    constraints = pzl->uniqueValue->constraints;
+
+    for (index = 0; index < pzl->uniqueValue->numConstraints; ++index) {
+        RegionInfo info;
+        unsigned int subsetSize = 0;
+
+        if (!RegionChanged(delta, index)) continue;
+
+        LoadRegionInfo(pzl->grid, &constraints[index].region, delta, &info);
+
+        /* A subset containing every open square doesn't eliminate anything */
+        for (subsetSize = 2; (subsetSize <= MAX_SUBSET_SIZE) && (subsetSize < DomNumElements(info.openSquares)); ++subsetSize) {
+            const Domain noMembers = DomCreate(0, info.regionSize, false);
+            const Domain noValues = DomCreate(VALUE_1, info.numValues, false);
+
+            result = MergeResult(result, NakedSubsetSearch(&info, subsetSize, info.openSquares, noMembers, noValues));
+            if (result == PROPAGATE_CONTRADICTION) return result;
+        }
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+/* Hidden subsets                                                            */
+/*****************************************************************************/
+
+/*
+** The values in members can only be placed at the squares in positions.
+** Removes all other values from the domains of those squares.
+*/
+static PropagateResult ApplyHiddenSubset(RegionInfo* info, const Domain members, Domain positions)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+
+    /* N values with fewer than N possible squares */
+    if (DomNumElements(positions) < DomNumElements(members)) return PROPAGATE_CONTRADICTION;
+
+    while (!DomIsEmptyDomain(positions) && (result != PROPAGATE_CONTRADICTION)) {
+        const unsigned int position = DomPopLSValue(&positions);
+        result = MergeResult(result, ReduceDomain(info, position, DomIntersection(info->squares[position]->domain, members)));
+    }
+
+    return result;
+}
+
+/*
+** Recursively builds combinations of unplaced values. candidates are the
+** values that may still be added to members; positions is the union of the
+** members' possible squares.
+*/
+static PropagateResult HiddenSubsetSearch(RegionInfo* info, const unsigned int subsetSize, Domain candidates, const Domain members, const Domain positions)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+
+    while (!DomIsEmptyDomain(candidates) && (result != PROPAGATE_CONTRADICTION)) {
+        const SquareValue value = DomPopLSValue(&candidates);
+        const Domain newPositions = DomUnion(positions, info->valuePositions[value]);
+        Domain newMembers = members;
+
+        if (DomNumElements(newPositions) > subsetSize) continue;
+
+        DomAddElement(&newMembers, value);
+
+        if (DomNumElements(newMembers) == subsetSize) {
+            result = MergeResult(result, ApplyHiddenSubset(info, newMembers, newPositions));
+        }
+        else {
+            result = MergeResult(result, HiddenSubsetSearch(info, subsetSize, candidates, newMembers, newPositions));
+        }
+    }
+
+    return result;
+}
+
+PropagateResult HiddenSubsets(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    const Constraint* constraints = NULL;
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int index = 0;
+
+    assert(pzl != NULL);
+    constraints = pzl->uniqueValue->constraints;
+
+    for (index = 0; index < pzl->uniqueValue->numConstraints; ++index) {
+        RegionInfo info;
+        unsigned int subsetSize = 0;
+
+        /* Every value must be placed only in regions containing every value */
+        if ((constraints[index].region.regionSize != GetGridOrder(pzl->grid)) || !RegionChanged(delta, index)) continue;
+
+        LoadRegionInfo(pzl->grid, &constraints[index].region, delta, &info);
+
+        for (subsetSize = 2; (subsetSize <= MAX_SUBSET_SIZE) && (subsetSize < DomNumElements(info.unplacedValues)); ++subsetSize) {
+            const Domain noMembers = DomCreate(VALUE_1, info.numValues, false);
+            const Domain noPositions = DomCreate(0, info.regionSize, false);
+
+            result = MergeResult(result, HiddenSubsetSearch(&info, subsetSize, info.unplacedValues, noMembers, noPositions));
+            if (result == PROPAGATE_CONTRADICTION) return result;
+        }
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+/* Locked candidates                                                         */
+/*****************************************************************************/
+
+/*
+** Removes value from the squares of region b that are not in region a.
+*/
+static PropagateResult RemoveOutside(Grid grid, const Region* a, const Region* b, const SquareValue value, const PropagationDelta* delta)
+{
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int position = 0;
+
+    for (position = 0; position < b->regionSize; ++position) {
+        GridSquare* square = NULL;
+
+        if (RegionContainsCell(a, b->cells[position])) continue;
+
+        square = &GetSquares(grid)[b->cells[position]];
+
+        if ((square->value == VALUE_NONE) && DomRemoveElement(&square->domain, value)) {
+            ReportChange(delta, b->cells[position]);
+            if (DomIsEmptyDomain(square->domain)) return PROPAGATE_CONTRADICTION;
+            result = PROPAGATE_CHANGED;
+        }
+    }
+
+    return result;
+}
+
+PropagateResult LockedCandidates(SudokuPuzzle* pzl, const PropagationDelta* delta)
+{
+    const Constraint* constraints = NULL;
+    unsigned int numConstraints = 0;
+    PropagateResult result = PROPAGATE_NO_CHANGE;
+    unsigned int aIndex = 0;
+
+    assert(pzl != NULL);
+    constraints = pzl->uniqueValue->constraints;
+    numConstraints = pzl->uniqueValue->numConstraints;
+
+    for (aIndex = 0; aIndex < numConstraints; ++aIndex) {
+        const Region* a = &constraints[aIndex].region;
+        RegionInfo info;
+        unsigned int bIndex = 0;
+
+        /* Every value must be placed only in regions containing every value */
+        if ((a->regionSize != GetGridOrder(pzl->grid)) || !RegionChanged(delta, aIndex)) continue;
+
+        LoadRegionInfo(pzl->grid, a, delta, &info);
+
+        for (bIndex = 0; bIndex < numConstraints; ++bIndex) {
+            const Region* b = &constraints[bIndex].region;
+            Domain shared = DomCreate(0, a->regionSize, false);
+            Domain values = info.unplacedValues;
+            unsigned int position = 0;
+
+            if (bIndex == aIndex) continue;
+
+            /* Regions without a common row and column can't intersect */
+            if (!(a->rowMask & b->rowMask) || !(a->colMask & b->colMask)) continue;
+
+            /* Positions of region a that are also in region b */
+            for (position = 0; position < a->regionSize; ++position) {
+                if (RegionContains(b, a->locations[position])) DomAddElement(&shared, position);
+            }
+
+            if (DomIsEmptyDomain(shared)) continue;
+
+            while (!DomIsEmptyDomain(values)) {
+                const SquareValue value = DomPopLSValue(&values);
+                const Domain positions = info.valuePositions[value];
+
+                /* Every possible square for value lies in both regions */
+                if (!DomIsEmptyDomain(positions) && DomIsEmptyDomain(DomDifference(positions, shared))) {
+                    result = MergeResult(result, RemoveOutside(pzl->grid, a, b, value, delta));
+                    if (result == PROPAGATE_CONTRADICTION) return result;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+/* Scheduling                                                                */
+/*****************************************************************************/
+
+const Propagator lockedCandidatesPropagator = { LockedCandidates, EVENT_REGION_CHANGED, PROPAGATOR_COST_MEDIUM, false, NULL, NULL };
+const Propagator nakedSubsetsPropagator = { NakedSubsets, EVENT_REGION_CHANGED, PROPAGATOR_COST_MEDIUM, false, NULL, NULL };
+const Propagator hiddenSubsetsPropagator = { HiddenSubsets, EVENT_REGION_CHANGED, PROPAGATOR_COST_MEDIUM, false, NULL, NULL };
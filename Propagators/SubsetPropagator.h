@@ -0,0 +1,76 @@
+/*
+** SubsetPropagator.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef SUBSET_PROPAGATOR_H
+#define SUBSET_PROPAGATOR_H
+
+#include "Propagator.h"
+
+/*
+** Subset and intersection propagators. Each propagator evaluates the regions
+** of the puzzle's uniqueValue constraint list that changed since it last ran.
+** See Propagator.h.
+*/
+
+/* Largest subset considered by NakedSubsets and HiddenSubsets */
+enum {
+    MAX_SUBSET_SIZE = 4
+};
+
+/*
+** Naked pairs, triples, and quads. If the combined domain of N squares in a
+** region contains only N values, those values must be placed in those squares
+** and are removed from the domains of the other squares in the region.
+*/
+PropagateResult NakedSubsets(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Hidden pairs, triples, and quads. If N values can only be placed in the
+** same N squares of a region, all other values are removed from the domains
+** of those squares.
+*/
+PropagateResult HiddenSubsets(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Pointing and claiming (box-line reduction). If every possible square for a
+** value in one region also lies in a second region, the value is removed from
+** the squares of the second region outside the first.
+*/
+PropagateResult LockedCandidates(SudokuPuzzle* pzl, const PropagationDelta* delta);
+
+/*
+** Scheduling for the propagators above. Each is woken when a region changes
+** and is in the medium cost tier.
+*/
+extern const Propagator lockedCandidatesPropagator;
+extern const Propagator nakedSubsetsPropagator;
+extern const Propagator hiddenSubsetsPropagator;
+
+#endif // !SUBSET_PROPAGATOR_H
@@ -31,6 +31,29 @@
 #include "Region.h"
 
 #include <assert.h>
+#include <stddef.h>
+
+void CompileRegion(Region* const region, const unsigned int gridOrder, CellIndex* cells)
+{
+    unsigned int position = 0;
+
+    assert((region != NULL) && (cells != NULL));
+    assert(gridOrder <= MAX_REGION_GRID_ORDER);
+
+    region->cells = cells;
+    region->rowMask = 0;
+    region->colMask = 0;
+
+    for (position = 0; position < region->regionSize; ++position) {
+        const GridLocation location = region->locations[position];
+
+        assert((location.row < gridOrder) && (location.col < gridOrder));
+
+        cells[position] = (CellIndex)(location.row * gridOrder + location.col);
+        region->rowMask |= (LineMask)1 << location.row;
+        region->colMask |= (LineMask)1 << location.col;
+    }
+}
 
 bool RegionContains(const Region* const region, const GridLocation location)
 {
@@ -39,10 +62,29 @@ bool RegionContains(const Region* const region, const GridLocation location)
     assert(region != NULL);
     assert((region->locations != NULL) && (region->regionSize != 0));
 
+    /* A compiled region can rule out most locations from its masks */
+    if ((region->cells != NULL) && (location.row < MAX_REGION_GRID_ORDER) && (location.col < MAX_REGION_GRID_ORDER)) {
+        if (!(region->rowMask & ((LineMask)1 << location.row)) || !(region->colMask & ((LineMask)1 << location.col))) return false;
+    }
+
     regionLoc = region->locations + region->regionSize;
     while (regionLoc-- > region->locations) {
         if ((regionLoc->col == location.col) && (regionLoc->row == location.row)) return true;
     }
 
+    return false;
+}
+
+bool RegionContainsCell(const Region* const region, const CellIndex cell)
+{
+    const CellIndex* regionCell = NULL;
+
+    assert((region != NULL) && (region->cells != NULL));
+
+    regionCell = region->cells + region->regionSize;
+    while (regionCell-- > region->cells) {
+        if (*regionCell == cell) return true;
+    }
+
     return false;
 }
\ No newline at end of file
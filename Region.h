@@ -34,6 +34,7 @@
 #define REGION_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /*
 ** Regions define a group of squares within a grid. Regions may be of any size
@@ -45,21 +46,56 @@ typedef struct {
     unsigned int col;
 } GridLocation;
 
+/*
+** Index of a square in the grid's square array: row * gridOrder + col.
+*/
+typedef uint16_t CellIndex;
+
+/*
+** Set of grid rows or columns. Bit n represents row or column n.
+*/
+typedef uint64_t LineMask;
+
+/* Largest grid order a compiled region can describe */
+enum {
+    MAX_REGION_GRID_ORDER = 64
+};
+
 /*
 ** Structure describing a region.
 **
 **  square - Array of GridLocations for each grid square in the region.
 **
 **  regionSize - Number of grid locations in the square array.
+**
+**  cells - Cell index of each grid location, or NULL if the region hasn't
+**          been compiled. See CompileRegion.
+**
+**  rowMask, colMask - Rows and columns holding a square of the region. Only
+**                     valid if the region has been compiled.
 */
 typedef struct {
     GridLocation* locations;
     unsigned int regionSize;
+    CellIndex* cells;
+    LineMask rowMask;
+    LineMask colMask;
 } Region;
 
+/*
+** Fills in the cell indices and row and column masks of a region for a grid of
+** the given order. cells must have room for regionSize indices.
+*/
+void CompileRegion(Region* const region, const unsigned int gridOrder, CellIndex* cells);
+
 /*
 ** Returns true if region contains the given location.
 */
 bool RegionContains(const Region* const region, const GridLocation location);
 
+/*
+** Returns true if a compiled region contains the given cell.
+*/
+bool RegionContainsCell(const Region* const region, const CellIndex cell);
+
 #endif // !REGION_H
@@ -0,0 +1,238 @@
+/*
+** SamuraiPuzzle.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "SamuraiPuzzle.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+enum {
+    SAMURAI_BOX_ORDER = 3,
+    SAMURAI_CENTRE_GRID = 2,
+    SAMURAI_REGIONS = SAMURAI_NUM_GRIDS * 3 * SAMURAI_GRID_ORDER - 4
+};
+
+/* Top left square of each grid */
+static const GridLocation gridOrigins[SAMURAI_NUM_GRIDS] = {
+    { 0, 0 }, { 0, 12 }, { 6, 6 }, { 12, 0 }, { 12, 12 }
+};
+
+/* Constraints of every Samurai puzzle, created when first requested */
+static ConstraintList* samuraiConstraints = NULL;
+
+/*****************************************************************************/
+/* Constraint generation                                                     */
+/*****************************************************************************/
+
+/*
+** Points the next constraint of list at the next SAMURAI_GRID_ORDER locations
+** of storage. Returns the constraint's locations.
+*/
+static GridLocation* AddSamuraiRegion(ConstraintList* list, GridLocation* storage)
+{
+    Constraint* constraint = &list->constraints[list->numConstraints];
+
+    constraint->region.locations = storage + list->numConstraints * SAMURAI_GRID_ORDER;
+    constraint->region.regionSize = SAMURAI_GRID_ORDER;
+    constraint->region.cells = NULL;
+    constraint->region.rowMask = 0;
+    constraint->region.colMask = 0;
+    constraint->funcs = GetUniqueValueFuncs();
+    constraint->target = 0;
+
+    ++list->numConstraints;
+    return constraint->region.locations;
+}
+
+/*
+** Creates the row, column and box constraints of every grid, grid by grid.
+** The centre grid's corner boxes are the same squares as a box of another
+** grid, so they're left out. The list, its constraints and their locations
+** share one allocation.
+**
+** Returns NULL if memory can't be allocated.
+*/
+static ConstraintList* CreateSamuraiConstraints(void)
+{
+    ConstraintList* list = NULL;
+    GridLocation* storage = NULL;
+    unsigned int gridIndex = 0;
+
+    list = (ConstraintList*)malloc(sizeof(ConstraintList) + SAMURAI_REGIONS * sizeof(Constraint) + SAMURAI_REGIONS * SAMURAI_GRID_ORDER * sizeof(GridLocation));
+    if (list == NULL) return NULL;
+
+    list->constraints = (Constraint*)(list + 1);
+    list->numConstraints = 0;
+    list->neighbourStart = NULL;
+    list->neighbours = NULL;
+    list->cells = NULL;
+    list->gridOrder = 0;
+    list->regionStart = NULL;
+    list->regionIndices = NULL;
+    list->peerStart = NULL;
+    list->peers = NULL;
+    storage = (GridLocation*)(list->constraints + SAMURAI_REGIONS);
+
+    for (gridIndex = 0; gridIndex < SAMURAI_NUM_GRIDS; ++gridIndex) {
+        const GridLocation origin = gridOrigins[gridIndex];
+        unsigned int line = 0;
+
+        for (line = 0; line < SAMURAI_GRID_ORDER; ++line) {
+            GridLocation* rowLocations = AddSamuraiRegion(list, storage);
+            GridLocation* colLocations = AddSamuraiRegion(list, storage);
+            unsigned int position = 0;
+
+            for (position = 0; position < SAMURAI_GRID_ORDER; ++position) {
+                rowLocations[position].row = origin.row + line;
+                rowLocations[position].col = origin.col + position;
+                colLocations[position].row = origin.row + position;
+                colLocations[position].col = origin.col + line;
+            }
+        }
+
+        for (line = 0; line < SAMURAI_GRID_ORDER; ++line) {
+            GridLocation* locations = NULL;
+            unsigned int position = 0;
+
+            /* Corner boxes are boxes 0, 2, 6 and 8 */
+            if ((gridIndex == SAMURAI_CENTRE_GRID) && (line != 4) && (line % 2 == 0)) continue;
+
+            locations = AddSamuraiRegion(list, storage);
+            for (position = 0; position < SAMURAI_GRID_ORDER; ++position) {
+                locations[position].row = origin.row + (line / SAMURAI_BOX_ORDER) * SAMURAI_BOX_ORDER + position / SAMURAI_BOX_ORDER;
+                locations[position].col = origin.col + (line % SAMURAI_BOX_ORDER) * SAMURAI_BOX_ORDER + position % SAMURAI_BOX_ORDER;
+            }
+        }
+    }
+
+    assert(list->numConstraints == SAMURAI_REGIONS);
+
+    if (!CompileConstraints(list, SAMURAI_ORDER)) {
+        free(list);
+        return NULL;
+    }
+
+    return list;
+}
+
+/*****************************************************************************/
+/* Samurai puzzles                                                           */
+/*****************************************************************************/
+
+GridLocation GetSamuraiGridOrigin(const unsigned int gridIndex)
+{
+    assert(gridIndex < SAMURAI_NUM_GRIDS);
+    return gridOrigins[gridIndex];
+}
+
+bool IsSamuraiSquare(const unsigned int row, const unsigned int col)
+{
+    unsigned int gridIndex = 0;
+
+    for (gridIndex = 0; gridIndex < SAMURAI_NUM_GRIDS; ++gridIndex) {
+        const GridLocation origin = gridOrigins[gridIndex];
+
+        if ((row >= origin.row) && (row < origin.row + SAMURAI_GRID_ORDER) && (col >= origin.col) && (col < origin.col + SAMURAI_GRID_ORDER)) return true;
+    }
+
+    return false;
+}
+
+bool CreateSamurai(SamuraiPuzzle** pzl)
+{
+    SamuraiPuzzle* newPuzzle = NULL;
+    GridSquare* squares = NULL;
+    unsigned int cell = 0;
+
+    assert(pzl != NULL);
+
+    if (samuraiConstraints == NULL) samuraiConstraints = CreateSamuraiConstraints();
+    if (samuraiConstraints == NULL) return false;
+
+    newPuzzle = (SamuraiPuzzle*)malloc(sizeof(SamuraiPuzzle));
+    if (newPuzzle == NULL) return false;
+
+    if (!CreateGrid(&newPuzzle->grid, SAMURAI_ORDER)) {
+        free(newPuzzle);
+        return false;
+    }
+
+    /* Each grid holds the values 1-9, and the gaps between them nothing */
+    squares = GetSquares(newPuzzle->grid);
+    for (cell = 0; cell < SAMURAI_ORDER * SAMURAI_ORDER; ++cell) {
+        const bool used = IsSamuraiSquare(cell / SAMURAI_ORDER, cell % SAMURAI_ORDER);
+
+        squares[cell].domain = DomCreate(VALUE_1, SAMURAI_GRID_ORDER, used);
+    }
+
+    newPuzzle->uniqueValue = samuraiConstraints;
+
+    *pzl = newPuzzle;
+    return true;
+}
+
+void DestroySamurai(SamuraiPuzzle** pzl)
+{
+    if ((pzl != NULL) && (*pzl != NULL)) {
+
+        DestroyGrid(&(*pzl)->grid);
+        free(*pzl);
+
+        *pzl = NULL;
+    }
+}
+
+bool isSamuraiComplete(SamuraiPuzzle* pzl)
+{
+    const GridSquare* squares = NULL;
+    unsigned int cell = 0;
+
+    assert(pzl != NULL);
+
+    squares = GetSquares(pzl->grid);
+    for (cell = 0; cell < SAMURAI_ORDER * SAMURAI_ORDER; ++cell) {
+        if (!IsSamuraiSquare(cell / SAMURAI_ORDER, cell % SAMURAI_ORDER)) continue;
+        if (squares[cell].value == VALUE_NONE) return false;
+    }
+
+    return true;
+}
+
+bool isSamuraiValid(SamuraiPuzzle* pzl)
+{
+    assert(pzl != NULL);
+
+    return ConstraintsMet(pzl->uniqueValue, pzl->grid);
+}
+
+void ReleaseSamuraiConstraints(void)
+{
+    DestroyConstraintList(&samuraiConstraints);
+}
\ No newline at end of file
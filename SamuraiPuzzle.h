@@ -0,0 +1,108 @@
+/*
+** SamuraiPuzzle.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef SAMURAI_PUZZLE_H
+#define SAMURAI_PUZZLE_H
+
+#include "Grid.h"
+#include "SudokuConstraints.h"
+
+#include <stdbool.h>
+
+/*
+** A Samurai Sudoku is five standard nine-by-nine grids overlapping in a
+** cross: a centre grid whose four corner boxes are also a corner box of one
+** of the other grids. Each grid's rows, columns and boxes hold every digit
+** 1-9 once, so the shared boxes couple the grids.
+**
+** The grids lie in a 21x21 grid, and squares outside them are unused. Their
+** 369 squares are indexed row-wise in that grid, so one compiled constraint
+** list covers every grid: 131 regions, as each shared box is held once. The
+** list and the peers of each square are shared by every Samurai puzzle.
+**
+** Squares outside the grids have no value and an empty domain, and are in
+** no region.
+*/
+
+enum {
+    SAMURAI_GRID_ORDER = 9,
+    SAMURAI_NUM_GRIDS = 5,
+    SAMURAI_ORDER = 21,
+    SAMURAI_SQUARES = 369
+};
+
+typedef struct {
+    Grid grid;
+    ConstraintList* uniqueValue;
+} SamuraiPuzzle;
+
+/*
+** Creates a new blank Samurai puzzle.
+**
+** If successful, the pzl parameter is updated to point to the newly created
+** puzzle and true is returned.
+**
+** If unsuccessful, the pzl parameter is not modified and false is returned.
+*/
+bool CreateSamurai(SamuraiPuzzle** pzl);
+
+/*
+** Destroys the Samurai puzzle and its grid. The constraints are shared; see
+** ReleaseSamuraiConstraints.
+*/
+void DestroySamurai(SamuraiPuzzle** pzl);
+
+/*
+** Returns the top left location of one of the five grids: the top left,
+** top right, centre, bottom left and bottom right grids in that order.
+*/
+GridLocation GetSamuraiGridOrigin(const unsigned int gridIndex);
+
+/*
+** Returns true if the location is in one of the five grids.
+*/
+bool IsSamuraiSquare(const unsigned int row, const unsigned int col);
+
+/*
+** Returns true if every square of the five grids has a value.
+*/
+bool isSamuraiComplete(SamuraiPuzzle* pzl);
+
+/*
+** Returns true if no region of the five grids repeats a value.
+*/
+bool isSamuraiValid(SamuraiPuzzle* pzl);
+
+/*
+** Frees the shared Samurai constraints. No Samurai puzzles may remain.
+*/
+void ReleaseSamuraiConstraints(void);
+
+#endif // !SAMURAI_PUZZLE_H
@@ -0,0 +1,354 @@
+/*
+** SamuraiSolver.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "SamuraiSolver.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    SAMURAI_CELLS = SAMURAI_ORDER * SAMURAI_ORDER,
+    REGIONS_PER_GRID = 3 * SAMURAI_GRID_ORDER,
+    CENTRE_GRID = 2,
+    ALL_GRIDS = SAMURAI_NUM_GRIDS
+};
+
+/* Every value of a grid's domain, which fits in the first word */
+#define FULL_SAMURAI ((DomWord)0x1FF)
+
+/* Domain bit of a square value */
+#define VALUE_BIT(value) ((DomWord)0x1 << ((value) - VALUE_1))
+
+/*
+** Search state: the values left to each square, and which squares' values
+** have been removed from their peers. Squares outside the grids have no
+** values.
+*/
+typedef struct {
+    DomWord masks[SAMURAI_CELLS];
+    bool placed[SAMURAI_CELLS];
+} SamuraiState;
+
+static bool IsSingleton(const DomWord mask)
+{
+    return (mask != 0) && ((mask & (mask - 1)) == 0);
+}
+
+static SquareValue MaskValue(const DomWord mask)
+{
+    SquareValue value = VALUE_1;
+
+    while (!(mask & VALUE_BIT(value))) ++value;
+    return value;
+}
+
+/*
+** Returns the first of the regions of a grid, or of every grid if gridIndex is
+** ALL_GRIDS, and sets end to one past the last. Regions are listed grid by
+** grid, and the centre grid has four fewer boxes.
+*/
+static unsigned int GetGridRegions(const ConstraintList* list, const unsigned int gridIndex, unsigned int* end)
+{
+    unsigned int first = 0;
+
+    if (gridIndex == ALL_GRIDS) {
+        *end = list->numConstraints;
+        return 0;
+    }
+
+    first = gridIndex * REGIONS_PER_GRID - ((gridIndex > CENTRE_GRID) ? 4 : 0);
+    *end = first + REGIONS_PER_GRID - ((gridIndex == CENTRE_GRID) ? 4 : 0);
+    return first;
+}
+
+/*****************************************************************************/
+/* Propagation                                                               */
+/*****************************************************************************/
+
+/*
+** Removes the value of every unplaced singleton from its peers, repeating for
+** any square left with one value. Returns false if a square has no values.
+*/
+static bool ArcConsistency(SamuraiState* state, const ConstraintList* list)
+{
+    CellIndex queue[SAMURAI_CELLS];
+    bool queued[SAMURAI_CELLS] = { false };
+    unsigned int numQueued = 0;
+    unsigned int cell = 0;
+
+    for (cell = 0; cell < SAMURAI_CELLS; ++cell) {
+        if (!state->placed[cell] && IsSingleton(state->masks[cell])) {
+            queued[cell] = true;
+            queue[numQueued++] = (CellIndex)cell;
+        }
+    }
+
+    while (numQueued > 0) {
+        const CellIndex placed = queue[--numQueued];
+        const DomWord bit = state->masks[placed];
+        unsigned int index = 0;
+
+        queued[placed] = false;
+        state->placed[placed] = true;
+
+        for (index = list->peerStart[placed]; index < list->peerStart[placed + 1]; ++index) {
+            const CellIndex peer = list->peers[index];
+
+            if (!(state->masks[peer] & bit)) continue;
+
+            state->masks[peer] &= ~bit;
+            if (state->masks[peer] == 0) return false;
+
+            if (IsSingleton(state->masks[peer]) && !queued[peer]) {
+                queued[peer] = true;
+                queue[numQueued++] = peer;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+** Places each value with one possible square in a region. Returns false if a
+** value has no possible square, and sets changed if a value was placed.
+*/
+static bool HiddenSingles(SamuraiState* state, const ConstraintList* list, const unsigned int gridIndex, bool* changed)
+{
+    unsigned int region = 0;
+    unsigned int end = 0;
+
+    for (region = GetGridRegions(list, gridIndex, &end); region < end; ++region) {
+        const CellIndex* cells = list->constraints[region].region.cells;
+        DomWord seenOnce = 0;
+        DomWord seenTwice = 0;
+        DomWord hiddenSingles = 0;
+        unsigned int position = 0;
+
+        for (position = 0; position < SAMURAI_GRID_ORDER; ++position) {
+            const DomWord mask = state->masks[cells[position]];
+
+            seenTwice |= seenOnce & mask;
+            seenOnce |= mask;
+        }
+
+        if (seenOnce != FULL_SAMURAI) return false;
+
+        hiddenSingles = seenOnce & ~seenTwice;
+
+        while (hiddenSingles != 0) {
+            const DomWord bit = hiddenSingles & (~hiddenSingles + 1);
+
+            hiddenSingles &= ~bit;
+
+            /* Find the one square that can hold the value */
+            for (position = 0; position < SAMURAI_GRID_ORDER; ++position) {
+                DomWord* mask = &state->masks[cells[position]];
+
+                if (!(*mask & bit)) continue;
+
+                if (!IsSingleton(*mask)) {
+                    *mask = bit;
+                    *changed = true;
+                }
+
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+** Runs arc consistency and hidden singles in the regions of gridIndex until
+** neither changes anything. Returns false if the state has no solution.
+*/
+static bool Propagate(SamuraiState* state, const ConstraintList* list, const unsigned int gridIndex)
+{
+    bool changed = false;
+
+    do {
+        changed = false;
+        if (!ArcConsistency(state, list)) return false;
+        if (!HiddenSingles(state, list, gridIndex, &changed)) return false;
+    } while (changed);
+
+    return true;
+}
+
+/*****************************************************************************/
+/* Search                                                                    */
+/*****************************************************************************/
+
+/*
+** Returns true if every square of the centre grid's corner boxes is placed.
+*/
+static bool SharedBoxesPlaced(const SamuraiState* state)
+{
+    const GridLocation origin = GetSamuraiGridOrigin(CENTRE_GRID);
+    unsigned int row = 0;
+    unsigned int col = 0;
+
+    for (row = 0; row < SAMURAI_GRID_ORDER; ++row) {
+        if ((row >= 3) && (row < 6)) continue;
+
+        for (col = 0; col < SAMURAI_GRID_ORDER; ++col) {
+            if ((col >= 3) && (col < 6)) continue;
+            if (!state->placed[(origin.row + row) * SAMURAI_ORDER + origin.col + col]) return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+** Returns the open square of gridIndex, or of every grid, with the fewest
+** values left. Returns SAMURAI_CELLS if every square has one value.
+*/
+static unsigned int SelectSquare(const SamuraiState* state, const unsigned int gridIndex)
+{
+    unsigned int best = SAMURAI_CELLS;
+    unsigned int bestCount = SAMURAI_GRID_ORDER + 1;
+    unsigned int cell = 0;
+
+    for (cell = 0; cell < SAMURAI_CELLS; ++cell) {
+        const DomWord mask = state->masks[cell];
+        DomWord remaining = 0;
+        unsigned int count = 0;
+
+        if ((mask == 0) || IsSingleton(mask)) continue;
+
+        if (gridIndex != ALL_GRIDS) {
+            const GridLocation origin = GetSamuraiGridOrigin(gridIndex);
+            const unsigned int row = cell / SAMURAI_ORDER;
+            const unsigned int col = cell % SAMURAI_ORDER;
+
+            if ((row < origin.row) || (row >= origin.row + SAMURAI_GRID_ORDER)) continue;
+            if ((col < origin.col) || (col >= origin.col + SAMURAI_GRID_ORDER)) continue;
+        }
+
+        /* Count the values by clearing the lowest bit until none are left */
+        for (remaining = mask; remaining != 0; remaining &= remaining - 1) ++count;
+
+        if (count < bestCount) {
+            best = cell;
+            bestCount = count;
+            if (count == 2) break;
+        }
+    }
+
+    return best;
+}
+
+/*
+** Searches for a solution of gridIndex, or of every grid, from states[depth].
+** Returns true and leaves the solution in states[depth] if there is one.
+*/
+static bool Search(SamuraiState* states, const unsigned int depth, const ConstraintList* list, const unsigned int gridIndex)
+{
+    SamuraiState* state = &states[depth];
+    unsigned int cell = 0;
+    DomWord remaining = 0;
+
+    if (!Propagate(state, list, gridIndex)) return false;
+
+    /* With the shared boxes placed, the grids are independent */
+    if ((gridIndex == ALL_GRIDS) && SharedBoxesPlaced(state)) {
+        unsigned int grid = 0;
+
+        for (grid = 0; grid < SAMURAI_NUM_GRIDS; ++grid) {
+            if (!Search(states, depth, list, grid)) return false;
+        }
+
+        return true;
+    }
+
+    cell = SelectSquare(state, gridIndex);
+    if (cell == SAMURAI_CELLS) return true;
+
+    assert(depth < SAMURAI_SQUARES);
+
+    remaining = state->masks[cell];
+    while (remaining != 0) {
+        const DomWord bit = remaining & (~remaining + 1);
+
+        remaining &= ~bit;
+
+        memcpy(&states[depth + 1], state, sizeof(SamuraiState));
+        states[depth + 1].masks[cell] = bit;
+
+        if (Search(states, depth + 1, list, gridIndex)) {
+            memcpy(state, &states[depth + 1], sizeof(SamuraiState));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SamuraiSolver(SamuraiPuzzle* pzl)
+{
+    SamuraiState* states = NULL;
+    GridSquare* squares = NULL;
+    unsigned int cell = 0;
+    bool solved = false;
+
+    assert(pzl != NULL);
+    assert(pzl->uniqueValue->gridOrder == SAMURAI_ORDER);
+
+    /* Each search level places at least one square */
+    states = (SamuraiState*)malloc((SAMURAI_SQUARES + 1) * sizeof(SamuraiState));
+    if (states == NULL) return false;
+
+    squares = GetSquares(pzl->grid);
+    for (cell = 0; cell < SAMURAI_CELLS; ++cell) {
+        states[0].masks[cell] = (squares[cell].value != VALUE_NONE) ? VALUE_BIT(squares[cell].value) : squares[cell].domain.words[0];
+        states[0].placed[cell] = false;
+    }
+
+    solved = Search(states, 0, pzl->uniqueValue, ALL_GRIDS);
+
+    if (solved) {
+        for (cell = 0; cell < SAMURAI_CELLS; ++cell) {
+            const DomWord mask = states[0].masks[cell];
+
+            if (mask == 0) continue;
+
+            assert(IsSingleton(mask));
+            squares[cell].domain.words[0] = mask;
+            squares[cell].value = MaskValue(mask);
+        }
+    }
+
+    free(states);
+    return solved;
+}
\ No newline at end of file
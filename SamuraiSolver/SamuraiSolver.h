@@ -0,0 +1,53 @@
+/*
+** SamuraiSolver.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef SAMURAISOLVER_H
+#define SAMURAISOLVER_H
+
+#include "../SamuraiPuzzle.h"
+
+#include <stdbool.h>
+
+/*
+** Solves a Samurai puzzle over its combined constraint list. Arc consistency
+** and hidden singles run to a fixed point across all five grids, so values
+** placed in a shared box prune both grids holding it. The search branches on
+** the square with the fewest values left in any grid.
+**
+** Once the four shared boxes are filled the grids no longer affect each other,
+** and each is searched on its own, so a dead end in one grid doesn't retry
+** the others.
+**
+** Returns true and fills the grid if a solution is found. Returns false and
+** leaves the grid unmodified if there isn't one or memory can't be allocated.
+*/
+bool SamuraiSolver(SamuraiPuzzle* pzl);
+
+#endif // !SAMURAISOLVER_H
@@ -0,0 +1,146 @@
+/*
+** SolutionCache.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "SolutionCache.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    CACHE_WAYS = 4
+};
+
+typedef struct {
+    uint64_t hash;
+    uint64_t lastUse;
+    uint8_t canonical[CANON_SQUARES];
+    uint8_t solution[CANON_SQUARES];
+} CacheEntry;
+
+typedef struct _SolutionCacheType {
+    CacheEntry* entries;
+    unsigned int numSets;
+    uint64_t useCount;
+} _SolutionCacheType;
+
+/*
+** Returns the entry holding a canonical form, or NULL if it isn't cached.
+** Unused entries have a lastUse of zero.
+*/
+static CacheEntry* FindEntry(SolutionCache cache, const uint8_t canonical[CANON_SQUARES], const uint64_t hash)
+{
+    CacheEntry* set = &cache->entries[(hash & (cache->numSets - 1)) * CACHE_WAYS];
+    unsigned int way = 0;
+
+    for (way = 0; way < CACHE_WAYS; ++way) {
+        if ((set[way].lastUse != 0) && (set[way].hash == hash) && (memcmp(set[way].canonical, canonical, CANON_SQUARES) == 0)) return &set[way];
+    }
+
+    return NULL;
+}
+
+bool CreateSolutionCache(SolutionCache* cache, unsigned int capacity)
+{
+    _SolutionCacheType* newCache = NULL;
+    unsigned int numSets = 1;
+
+    assert(cache != NULL);
+
+    /* Sets are found from the low bits of the hash */
+    while (numSets * CACHE_WAYS < capacity) numSets *= 2;
+
+    newCache = (_SolutionCacheType*)malloc(sizeof(_SolutionCacheType));
+    if (newCache == NULL) return false;
+
+    newCache->entries = (CacheEntry*)calloc(numSets * CACHE_WAYS, sizeof(CacheEntry));
+    if (newCache->entries == NULL) {
+        free(newCache);
+        return false;
+    }
+
+    newCache->numSets = numSets;
+    newCache->useCount = 0;
+
+    *cache = newCache;
+    return true;
+}
+
+void DestroySolutionCache(SolutionCache* cache)
+{
+    if ((cache != NULL) && (*cache != NULL)) {
+
+        free((*cache)->entries);
+        free(*cache);
+
+        *cache = NULL;
+    }
+}
+
+bool FindCachedSolution(SolutionCache cache, const uint8_t canonical[CANON_SQUARES], uint8_t solution[CANON_SQUARES])
+{
+    CacheEntry* entry = NULL;
+
+    assert((cache != NULL) && (canonical != NULL) && (solution != NULL));
+
+    entry = FindEntry(cache, canonical, HashCanonicalForm(canonical));
+    if (entry == NULL) return false;
+
+    entry->lastUse = ++cache->useCount;
+    memcpy(solution, entry->solution, CANON_SQUARES);
+    return true;
+}
+
+void CacheSolution(SolutionCache cache, const uint8_t canonical[CANON_SQUARES], const uint8_t solution[CANON_SQUARES])
+{
+    const uint64_t hash = HashCanonicalForm(canonical);
+    CacheEntry* entry = NULL;
+
+    assert((cache != NULL) && (canonical != NULL) && (solution != NULL));
+
+    entry = FindEntry(cache, canonical, hash);
+
+    if (entry == NULL) {
+        CacheEntry* set = &cache->entries[(hash & (cache->numSets - 1)) * CACHE_WAYS];
+        unsigned int way = 0;
+
+        /* Replace the least recently used entry; unused entries come first */
+        entry = &set[0];
+        for (way = 1; way < CACHE_WAYS; ++way) {
+            if (set[way].lastUse < entry->lastUse) entry = &set[way];
+        }
+
+        entry->hash = hash;
+        memcpy(entry->canonical, canonical, CANON_SQUARES);
+    }
+
+    entry->lastUse = ++cache->useCount;
+    memcpy(entry->solution, solution, CANON_SQUARES);
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+** SolutionCache.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+#include "CanonicalForm.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+** A bounded in-memory cache of solutions keyed by canonical form (see
+** CanonicalForm.h). Puzzles related by relabelling, reordering or transposing
+** share one entry, so a solution found for one answers them all once mapped
+** back through InvertCanonTransform.
+**
+** Entries are grouped in sets of four by the hash of their canonical form.
+** When a set is full, the entry used least recently is replaced.
+*/
+typedef struct _SolutionCacheType* SolutionCache;
+
+/*
+** Creates an empty cache holding at least capacity solutions.
+**
+** If successful, the cache parameter is updated to point to the newly created
+** cache and true is returned.
+**
+** If unsuccessful, the cache parameter is not modified and false is returned.
+*/
+bool CreateSolutionCache(SolutionCache* cache, unsigned int capacity);
+
+/*
+** Destroys a cache.
+*/
+void DestroySolutionCache(SolutionCache* cache);
+
+/*
+** Looks up the solution of a canonical form. Returns true and copies the
+** solution, as a grid of the canonical form, if it's cached.
+*/
+bool FindCachedSolution(SolutionCache cache, const uint8_t canonical[CANON_SQUARES], uint8_t solution[CANON_SQUARES]);
+
+/*
+** Adds the solution of a canonical form, given as a grid of the canonical form,
+** replacing any solution already cached for it.
+*/
+void CacheSolution(SolutionCache cache, const uint8_t canonical[CANON_SQUARES], const uint8_t solution[CANON_SQUARES]);
+
+#endif // !SOLUTION_CACHE_H
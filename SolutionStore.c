@@ -0,0 +1,474 @@
+/*
+** SolutionStore.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+/* Memory mapping and file locks are POSIX, not standard C */
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "SolutionStore.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_MAGIC "SUDLOG01"
+#define INDEX_MAGIC "SUDIDX01"
+#define LOG_SUFFIX ".log"
+#define INDEX_SUFFIX ".idx"
+
+/* Slots hold the high half of the hash and the record number plus one */
+#define SLOT_TAG(hash) ((hash) & 0xFFFFFFFF00000000ull)
+#define SLOT_RECORD(slot) ((slot) & 0xFFFFFFFFull)
+
+enum {
+    MAX_STORE_PATH = 4096,
+    MAGIC_LENGTH = 8,
+    STORE_HEADER_SIZE = 64
+};
+
+/*
+** Header of both files. capacity is the number of records or index slots, and
+** count the number of records logged or indexed.
+*/
+typedef struct {
+    char magic[MAGIC_LENGTH];
+    uint64_t capacity;
+    _Atomic uint64_t count;
+} StoreHeader;
+
+typedef struct {
+    uint64_t hash;
+    uint8_t canonical[CANON_SQUARES];
+    uint8_t solution[CANON_SQUARES];
+} StoreRecord;
+
+/*
+** A mapped store file.
+*/
+typedef struct {
+    int file;
+    uint8_t* map;
+    size_t size;
+} StoreFile;
+
+typedef struct _SolutionStoreType {
+    StoreFile logFile;
+    StoreFile indexFile;
+    StoreHeader* log;
+    StoreHeader* index;
+    StoreRecord* records;
+    _Atomic uint64_t* slots;
+    bool writable;
+} _SolutionStoreType;
+
+/*****************************************************************************/
+/* Files                                                                     */
+/*****************************************************************************/
+
+/*
+** Opens and maps a store file. A writer locks the file, so only one process
+** may write a store, and creates it at size with an empty header if it's new.
+** A file's size must agree with its header.
+**
+** Returns false if the file can't be opened, locked or mapped.
+*/
+static bool MapStoreFile(StoreFile* storeFile, const char* path, const char* magic, const bool writable, const uint64_t capacity, const size_t recordSize)
+{
+    struct stat status;
+    StoreHeader* header = NULL;
+    bool created = false;
+
+    storeFile->file = open(path, writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (storeFile->file < 0) return false;
+
+    if (writable) {
+        struct flock lock;
+
+        memset(&lock, 0, sizeof(lock));
+        lock.l_type = F_WRLCK;
+        lock.l_whence = SEEK_SET;
+
+        if (fcntl(storeFile->file, F_SETLK, &lock) != 0) {
+            close(storeFile->file);
+            return false;
+        }
+    }
+
+    if (fstat(storeFile->file, &status) != 0) {
+        close(storeFile->file);
+        return false;
+    }
+
+    storeFile->size = (size_t)status.st_size;
+
+    /* New files are sparse, so unused records take no space */
+    if (writable && (storeFile->size == 0)) {
+        storeFile->size = STORE_HEADER_SIZE + capacity * recordSize;
+        created = (ftruncate(storeFile->file, (off_t)storeFile->size) == 0);
+
+        if (!created) {
+            close(storeFile->file);
+            return false;
+        }
+    }
+
+    if (storeFile->size < STORE_HEADER_SIZE) {
+        close(storeFile->file);
+        return false;
+    }
+
+    storeFile->map = (uint8_t*)mmap(NULL, storeFile->size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, storeFile->file, 0);
+    if (storeFile->map == MAP_FAILED) {
+        close(storeFile->file);
+        return false;
+    }
+
+    header = (StoreHeader*)storeFile->map;
+
+    if (created) {
+        memcpy(header->magic, magic, MAGIC_LENGTH);
+        header->capacity = capacity;
+        atomic_store_explicit(&header->count, 0, memory_order_release);
+    }
+
+    if ((memcmp(header->magic, magic, MAGIC_LENGTH) != 0) || (storeFile->size != STORE_HEADER_SIZE + header->capacity * recordSize)) {
+        munmap(storeFile->map, storeFile->size);
+        close(storeFile->file);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+** Reopens a read-only store file for writing, locks it and maps it writable.
+** The new descriptor replaces the old one rather than joining it, since
+** closing any descriptor of a file releases the process's locks on it.
+**
+** Returns false if the file can't be reopened, locked or mapped. The file
+** stays mapped read-only.
+*/
+static bool UpgradeStoreFile(StoreFile* storeFile, const char* path)
+{
+    struct flock lock;
+    uint8_t* map = NULL;
+    int file = open(path, O_RDWR);
+
+    if (file < 0) return false;
+
+    if (dup2(file, storeFile->file) < 0) {
+        close(file);
+        return false;
+    }
+
+    close(file);
+
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+
+    if (fcntl(storeFile->file, F_SETLK, &lock) != 0) return false;
+
+    map = (uint8_t*)mmap(NULL, storeFile->size, PROT_READ | PROT_WRITE, MAP_SHARED, storeFile->file, 0);
+    if (map == MAP_FAILED) {
+        lock.l_type = F_UNLCK;
+        fcntl(storeFile->file, F_SETLK, &lock);
+        return false;
+    }
+
+    munmap(storeFile->map, storeFile->size);
+    storeFile->map = map;
+    return true;
+}
+
+/*
+** Unlocks a store file upgraded by UpgradeStoreFile, when the other file of
+** the store couldn't be.
+*/
+static void UnlockStoreFile(StoreFile* storeFile)
+{
+    struct flock lock;
+
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_UNLCK;
+    lock.l_whence = SEEK_SET;
+
+    fcntl(storeFile->file, F_SETLK, &lock);
+}
+
+/*
+** Unmaps and closes a store file, first writing it to disk if it was written.
+*/
+static void UnmapStoreFile(StoreFile* storeFile, const bool writable)
+{
+    if (writable) msync(storeFile->map, storeFile->size, MS_SYNC);
+
+    munmap(storeFile->map, storeFile->size);
+    close(storeFile->file);
+}
+
+/*****************************************************************************/
+/* Index                                                                     */
+/*****************************************************************************/
+
+/*
+** Returns the number of the record holding a canonical form, or -1 if it isn't
+** indexed.
+*/
+static long FindRecord(SolutionStore store, const uint8_t canonical[CANON_SQUARES], const uint64_t hash)
+{
+    const uint64_t numSlots = store->index->capacity;
+    const uint64_t logCapacity = store->log->capacity;
+    uint64_t probe = 0;
+
+    for (probe = 0; probe < numSlots; ++probe) {
+        const uint64_t slot = atomic_load_explicit(&store->slots[(hash + probe) & (numSlots - 1)], memory_order_acquire);
+        const StoreRecord* record = NULL;
+
+        if (slot == 0) return -1;
+        if ((SLOT_TAG(slot) != SLOT_TAG(hash)) || (SLOT_RECORD(slot) > logCapacity)) continue;
+
+        record = &store->records[SLOT_RECORD(slot) - 1];
+        if ((record->hash == hash) && (memcmp(record->canonical, canonical, CANON_SQUARES) == 0)) return (long)(SLOT_RECORD(slot) - 1);
+    }
+
+    return -1;
+}
+
+/*
+** Publishes the slot of a logged record. The index has twice as many slots as
+** the log has records, so there's always an empty slot.
+*/
+static void IndexRecord(SolutionStore store, const uint64_t recordNumber)
+{
+    const uint64_t numSlots = store->index->capacity;
+    const uint64_t hash = store->records[recordNumber].hash;
+    uint64_t position = hash & (numSlots - 1);
+
+    while (atomic_load_explicit(&store->slots[position], memory_order_relaxed) != 0) position = (position + 1) & (numSlots - 1);
+
+    atomic_store_explicit(&store->slots[position], SLOT_TAG(hash) | (recordNumber + 1), memory_order_release);
+    atomic_store_explicit(&store->index->count, recordNumber + 1, memory_order_release);
+}
+
+/*
+** Indexes records logged by a writer that stopped before indexing them.
+*/
+static void IndexLoggedRecords(SolutionStore store)
+{
+    uint64_t recordNumber = 0;
+
+    for (recordNumber = atomic_load(&store->index->count); recordNumber < atomic_load(&store->log->count); ++recordNumber) {
+        const StoreRecord* record = &store->records[recordNumber];
+
+        if (FindRecord(store, record->canonical, record->hash) < 0) IndexRecord(store, recordNumber);
+    }
+
+    atomic_store(&store->index->count, atomic_load(&store->log->count));
+}
+
+/*
+** Points a store at its mapped files.
+*/
+static void LocateStoreMaps(SolutionStore store)
+{
+    store->log = (StoreHeader*)store->logFile.map;
+    store->index = (StoreHeader*)store->indexFile.map;
+    store->records = (StoreRecord*)(store->logFile.map + STORE_HEADER_SIZE);
+    store->slots = (_Atomic uint64_t*)(store->indexFile.map + STORE_HEADER_SIZE);
+}
+
+/*****************************************************************************/
+/* Stores                                                                    */
+/*****************************************************************************/
+
+bool OpenSolutionStore(SolutionStore* store, const char* path, unsigned int capacity, bool writable)
+{
+    _SolutionStoreType* newStore = NULL;
+    char filename[MAX_STORE_PATH];
+    uint64_t numSlots = 1;
+
+    assert((store != NULL) && (path != NULL));
+
+    if ((strlen(path) + sizeof(LOG_SUFFIX) > MAX_STORE_PATH) || (writable && (capacity == 0))) return false;
+
+    /* At most half the slots are used, so probes stay short */
+    while (numSlots < 2 * (uint64_t)capacity) numSlots *= 2;
+
+    newStore = (_SolutionStoreType*)malloc(sizeof(_SolutionStoreType));
+    if (newStore == NULL) return false;
+
+    newStore->writable = writable;
+
+    sprintf(filename, "%s%s", path, LOG_SUFFIX);
+    if (!MapStoreFile(&newStore->logFile, filename, LOG_MAGIC, writable, capacity, sizeof(StoreRecord))) {
+        free(newStore);
+        return false;
+    }
+
+    sprintf(filename, "%s%s", path, INDEX_SUFFIX);
+    if (!MapStoreFile(&newStore->indexFile, filename, INDEX_MAGIC, writable, numSlots, sizeof(uint64_t))) {
+        UnmapStoreFile(&newStore->logFile, false);
+        free(newStore);
+        return false;
+    }
+
+    LocateStoreMaps(newStore);
+
+    /* The slots must be a power of two, and able to index every record */
+    numSlots = newStore->index->capacity;
+    if (((numSlots & (numSlots - 1)) != 0) || (numSlots < 2 * newStore->log->capacity)) {
+        CloseSolutionStore(&newStore);
+        return false;
+    }
+
+    if (writable) IndexLoggedRecords(newStore);
+
+    *store = newStore;
+    return true;
+}
+
+bool MakeSolutionStoreWritable(SolutionStore store, const char* path)
+{
+    char filename[MAX_STORE_PATH];
+
+    assert((store != NULL) && (path != NULL));
+
+    if (store->writable) return true;
+    if (strlen(path) + sizeof(LOG_SUFFIX) > MAX_STORE_PATH) return false;
+
+    sprintf(filename, "%s%s", path, LOG_SUFFIX);
+    if (!UpgradeStoreFile(&store->logFile, filename)) return false;
+
+    sprintf(filename, "%s%s", path, INDEX_SUFFIX);
+    if (!UpgradeStoreFile(&store->indexFile, filename)) {
+        UnlockStoreFile(&store->logFile);
+        LocateStoreMaps(store);
+        return false;
+    }
+
+    store->writable = true;
+    LocateStoreMaps(store);
+    IndexLoggedRecords(store);
+    return true;
+}
+
+void CloseSolutionStore(SolutionStore* store)
+{
+    if ((store != NULL) && (*store != NULL)) {
+
+        UnmapStoreFile(&(*store)->indexFile, (*store)->writable);
+        UnmapStoreFile(&(*store)->logFile, (*store)->writable);
+        free(*store);
+
+        *store = NULL;
+    }
+}
+
+bool FindStoredSolution(SolutionStore store, const uint8_t canonical[CANON_SQUARES], uint8_t solution[CANON_SQUARES])
+{
+    long recordNumber = -1;
+
+    assert((store != NULL) && (canonical != NULL) && (solution != NULL));
+
+    recordNumber = FindRecord(store, canonical, HashCanonicalForm(canonical));
+    if (recordNumber < 0) return false;
+
+    memcpy(solution, store->records[recordNumber].solution, CANON_SQUARES);
+    return true;
+}
+
+bool StoreSolution(SolutionStore store, const uint8_t canonical[CANON_SQUARES], const uint8_t solution[CANON_SQUARES])
+{
+    const uint64_t hash = HashCanonicalForm(canonical);
+    uint64_t recordNumber = 0;
+    StoreRecord* record = NULL;
+
+    assert((store != NULL) && (canonical != NULL) && (solution != NULL));
+
+    if (!store->writable) return false;
+    if (FindRecord(store, canonical, hash) >= 0) return true;
+
+    recordNumber = atomic_load_explicit(&store->log->count, memory_order_relaxed);
+    if (recordNumber == store->log->capacity) return false;
+
+    record = &store->records[recordNumber];
+    record->hash = hash;
+    memcpy(record->canonical, canonical, CANON_SQUARES);
+    memcpy(record->solution, solution, CANON_SQUARES);
+
+    /* Log the record, then publish it to readers */
+    atomic_store_explicit(&store->log->count, recordNumber + 1, memory_order_release);
+    IndexRecord(store, recordNumber);
+    return true;
+}
+
+#else
+
+typedef struct _SolutionStoreType {
+    bool unused;
+} _SolutionStoreType;
+
+bool OpenSolutionStore(SolutionStore* store, const char* path, unsigned int capacity, bool writable)
+{
+    printf("ERROR: Solution stores aren't supported on this platform\n");
+    return false;
+}
+
+bool MakeSolutionStoreWritable(SolutionStore store, const char* path)
+{
+    return false;
+}
+
+void CloseSolutionStore(SolutionStore* store)
+{
+}
+
+bool FindStoredSolution(SolutionStore store, const uint8_t canonical[CANON_SQUARES], uint8_t solution[CANON_SQUARES])
+{
+    return false;
+}
+
+bool StoreSolution(SolutionStore store, const uint8_t canonical[CANON_SQUARES], const uint8_t solution[CANON_SQUARES])
+{
+    return false;
+}
+
+#endif
\ No newline at end of file
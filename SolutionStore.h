@@ -0,0 +1,109 @@
+/*
+** SolutionStore.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef SOLUTION_STORE_H
+#define SOLUTION_STORE_H
+
+#include "CanonicalForm.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+** A persistent store of solutions keyed by canonical form, shared by every
+** process opening it. Solutions survive restarts, so a puzzle solved by any
+** worker needn't be solved again.
+**
+** A store is two files:
+**
+**  - "<path>.log" - An append-only log of records, each a canonical form and
+**    its solution. The file is created at its full size, so records are
+**    written in place and never move.
+**
+**  - "<path>.idx" - An open-addressing hash index of the log. Each slot holds
+**    the high half of a record's hash and its position in the log, and slots
+**    are probed linearly from the low bits of the hash.
+**
+** Readers map both files read-only and take no locks. Only one process at a
+** time may open a store for writing. The writer's lock is a POSIX record
+** lock, which the process loses when it closes any descriptor of the files:
+** a process writing a store mustn't open and close it again, e.g. as another
+** reader, while it writes. A record is written and counted in the
+** log before its slot is published, so a reader that finds a slot always
+** finds the whole record. Opening a store for writing indexes any records a
+** previous writer logged but didn't index.
+**
+** Stores use POSIX memory mapping and aren't supported on Windows.
+*/
+typedef struct _SolutionStoreType* SolutionStore;
+
+/*
+** Opens the store at path. If writable is set the store is created, holding up
+** to capacity solutions, if it doesn't exist; an existing store keeps its own
+** capacity.
+**
+** If successful, the store parameter is updated to point to the opened store
+** and true is returned.
+**
+** If unsuccessful, e.g. the files can't be read or another process has the
+** store open for writing, the store parameter is not modified and false is
+** returned.
+*/
+bool OpenSolutionStore(SolutionStore* store, const char* path, unsigned int capacity, bool writable);
+
+/*
+** Opens a store opened read-only for writing, once no other process is
+** writing it. The store's files are reopened in place, so the store is never
+** closed and the lock is kept; path must be the path it was opened with.
+**
+** Returns true if the store is now open for writing.
+*/
+bool MakeSolutionStoreWritable(SolutionStore store, const char* path);
+
+/*
+** Closes a store, writing any changes back to disk.
+*/
+void CloseSolutionStore(SolutionStore* store);
+
+/*
+** Looks up the solution of a canonical form. Returns true and copies the
+** solution, as a grid of the canonical form, if it's stored.
+*/
+bool FindStoredSolution(SolutionStore store, const uint8_t canonical[CANON_SQUARES], uint8_t solution[CANON_SQUARES]);
+
+/*
+** Appends the solution of a canonical form, given as a grid of the canonical
+** form, unless it's already stored.
+**
+** Returns false if the store isn't open for writing or is full.
+*/
+bool StoreSolution(SolutionStore store, const uint8_t canonical[CANON_SQUARES], const uint8_t solution[CANON_SQUARES]);
+
+#endif // !SOLUTION_STORE_H
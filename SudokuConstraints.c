@@ -32,9 +32,10 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 
-enum { ROW_0 = 0, ROW_1, ROW_2, ROW_3, ROW_4, ROW_5, ROW_6, ROW_7, ROW_8 };
-enum { COL_0 = 0, COL_1, COL_2, COL_3, COL_4, COL_5, COL_6, COL_7, COL_8 };
+/* Standard constraints for each box order, created when first requested */
+static ConstraintList* sudokuConstraints[MAX_SUDOKU_BOX_ORDER + 1] = { NULL };
 
 /*****************************************************************************/
 /* Constraint functions                                                      */
@@ -44,18 +45,19 @@ enum { COL_0 = 0, COL_1, COL_2, COL_3, COL_4, COL_5, COL_6, COL_7, COL_8 };
 ** Validation function. Returns false if any square values are repeated in the
 ** region.
 */
-static bool UniqueValues(Grid grid, Region* region)
+static bool UniqueValues(Grid grid, const Constraint* constraint)
 {
-    unsigned int locationIndex = 0;
-    GridLocation* locations = NULL;
+    const Region* region = NULL;
+    unsigned int position = 0;
+    const GridSquare* squares = NULL;
     bool valueFound[numSquareValues] = { false };
 
-    assert(region != NULL);
-    locations = region->locations;
+    assert((constraint != NULL) && (constraint->region.cells != NULL));
+    region = &constraint->region;
+    squares = GetSquares(grid);
 
-    for (locationIndex = 0; locationIndex < region->regionSize; ++locationIndex) {
-        const GridSquare* const square = GetSquare(grid, locations[locationIndex].row, locations[locationIndex].col);
-        assert(square != NULL);
+    for (position = 0; position < region->regionSize; ++position) {
+        const GridSquare* const square = &squares[region->cells[position]];
 
         /* VALUE_NONE squares are always valid. */
         if (square->value == VALUE_NONE) continue;
@@ -92,122 +94,234 @@ static bool BinaryConstraintUpdater(Grid grid, GridLocation a, const GridLocatio
     return DomRemoveElement(&sqrA->domain, sqrB->value);
 }
 
-#define SUDOKU_FUNCS { UniqueValues, BinaryConstraintUpdater }
-
-/*************************************/
-/*       Grid row constraints        */
-/*************************************/
-
-/* Location arrays */
-GridLocation ROW_0_LOCATIONS[] = { { ROW_0, COL_0 }, { ROW_0, COL_1 }, { ROW_0, COL_2 }, { ROW_0, COL_3 }, { ROW_0, COL_4 }, { ROW_0, COL_5 }, { ROW_0, COL_6 }, { ROW_0, COL_7 }, { ROW_0, COL_8 } };
-GridLocation ROW_1_LOCATIONS[] = { { ROW_1, COL_0 }, { ROW_1, COL_1 }, { ROW_1, COL_2 }, { ROW_1, COL_3 }, { ROW_1, COL_4 }, { ROW_1, COL_5 }, { ROW_1, COL_6 }, { ROW_1, COL_7 }, { ROW_1, COL_8 } };
-GridLocation ROW_2_LOCATIONS[] = { { ROW_2, COL_0 }, { ROW_2, COL_1 }, { ROW_2, COL_2 }, { ROW_2, COL_3 }, { ROW_2, COL_4 }, { ROW_2, COL_5 }, { ROW_2, COL_6 }, { ROW_2, COL_7 }, { ROW_2, COL_8 } };
-GridLocation ROW_3_LOCATIONS[] = { { ROW_3, COL_0 }, { ROW_3, COL_1 }, { ROW_3, COL_2 }, { ROW_3, COL_3 }, { ROW_3, COL_4 }, { ROW_3, COL_5 }, { ROW_3, COL_6 }, { ROW_3, COL_7 }, { ROW_3, COL_8 } };
-GridLocation ROW_4_LOCATIONS[] = { { ROW_4, COL_0 }, { ROW_4, COL_1 }, { ROW_4, COL_2 }, { ROW_4, COL_3 }, { ROW_4, COL_4 }, { ROW_4, COL_5 }, { ROW_4, COL_6 }, { ROW_4, COL_7 }, { ROW_4, COL_8 } };
-GridLocation ROW_5_LOCATIONS[] = { { ROW_5, COL_0 }, { ROW_5, COL_1 }, { ROW_5, COL_2 }, { ROW_5, COL_3 }, { ROW_5, COL_4 }, { ROW_5, COL_5 }, { ROW_5, COL_6 }, { ROW_5, COL_7 }, { ROW_5, COL_8 } };
-GridLocation ROW_6_LOCATIONS[] = { { ROW_6, COL_0 }, { ROW_6, COL_1 }, { ROW_6, COL_2 }, { ROW_6, COL_3 }, { ROW_6, COL_4 }, { ROW_6, COL_5 }, { ROW_6, COL_6 }, { ROW_6, COL_7 }, { ROW_6, COL_8 } };
-GridLocation ROW_7_LOCATIONS[] = { { ROW_7, COL_0 }, { ROW_7, COL_1 }, { ROW_7, COL_2 }, { ROW_7, COL_3 }, { ROW_7, COL_4 }, { ROW_7, COL_5 }, { ROW_7, COL_6 }, { ROW_7, COL_7 }, { ROW_7, COL_8 } };
-GridLocation ROW_8_LOCATIONS[] = { { ROW_8, COL_0 }, { ROW_8, COL_1 }, { ROW_8, COL_2 }, { ROW_8, COL_3 }, { ROW_8, COL_4 }, { ROW_8, COL_5 }, { ROW_8, COL_6 }, { ROW_8, COL_7 }, { ROW_8, COL_8 } };
-
-/* Regions */
-#define REGION_ROW_0 { ROW_0_LOCATIONS, sizeof(ROW_0_LOCATIONS) / sizeof(ROW_0_LOCATIONS[0]) }
-#define REGION_ROW_1 { ROW_1_LOCATIONS, sizeof(ROW_1_LOCATIONS) / sizeof(ROW_1_LOCATIONS[0]) }
-#define REGION_ROW_2 { ROW_2_LOCATIONS, sizeof(ROW_2_LOCATIONS) / sizeof(ROW_2_LOCATIONS[0]) }
-#define REGION_ROW_3 { ROW_3_LOCATIONS, sizeof(ROW_3_LOCATIONS) / sizeof(ROW_3_LOCATIONS[0]) }
-#define REGION_ROW_4 { ROW_4_LOCATIONS, sizeof(ROW_4_LOCATIONS) / sizeof(ROW_4_LOCATIONS[0]) }
-#define REGION_ROW_5 { ROW_5_LOCATIONS, sizeof(ROW_5_LOCATIONS) / sizeof(ROW_5_LOCATIONS[0]) }
-#define REGION_ROW_6 { ROW_6_LOCATIONS, sizeof(ROW_6_LOCATIONS) / sizeof(ROW_6_LOCATIONS[0]) }
-#define REGION_ROW_7 { ROW_7_LOCATIONS, sizeof(ROW_7_LOCATIONS) / sizeof(ROW_7_LOCATIONS[0]) }
-#define REGION_ROW_8 { ROW_8_LOCATIONS, sizeof(ROW_8_LOCATIONS) / sizeof(ROW_8_LOCATIONS[0]) }
-
-/* Constraints */
-#define CONSTRAINT_ROW_0 { REGION_ROW_0, SUDOKU_FUNCS }
-#define CONSTRAINT_ROW_1 { REGION_ROW_1, SUDOKU_FUNCS }
-#define CONSTRAINT_ROW_2 { REGION_ROW_2, SUDOKU_FUNCS }
-#define CONSTRAINT_ROW_3 { REGION_ROW_3, SUDOKU_FUNCS }
-#define CONSTRAINT_ROW_4 { REGION_ROW_4, SUDOKU_FUNCS }
-#define CONSTRAINT_ROW_5 { REGION_ROW_5, SUDOKU_FUNCS }
-#define CONSTRAINT_ROW_6 { REGION_ROW_6, SUDOKU_FUNCS }
-#define CONSTRAINT_ROW_7 { REGION_ROW_7, SUDOKU_FUNCS }
-#define CONSTRAINT_ROW_8 { REGION_ROW_8, SUDOKU_FUNCS }
-
-/*************************************/
-/*     Grid column constraints       */
-/*************************************/
-
-/* Location arrays */
-GridLocation COL_0_LOCATIONS[] = { { ROW_0, COL_0 }, { ROW_1, COL_0 }, { ROW_2, COL_0 }, { ROW_3, COL_0 }, { ROW_4, COL_0 }, { ROW_5, COL_0 }, { ROW_6, COL_0 }, { ROW_7, COL_0 }, { ROW_8, COL_0 } };
-GridLocation COL_1_LOCATIONS[] = { { ROW_0, COL_1 }, { ROW_1, COL_1 }, { ROW_2, COL_1 }, { ROW_3, COL_1 }, { ROW_4, COL_1 }, { ROW_5, COL_1 }, { ROW_6, COL_1 }, { ROW_7, COL_1 }, { ROW_8, COL_1 } };
-GridLocation COL_2_LOCATIONS[] = { { ROW_0, COL_2 }, { ROW_1, COL_2 }, { ROW_2, COL_2 }, { ROW_3, COL_2 }, { ROW_4, COL_2 }, { ROW_5, COL_2 }, { ROW_6, COL_2 }, { ROW_7, COL_2 }, { ROW_8, COL_2 } };
-GridLocation COL_3_LOCATIONS[] = { { ROW_0, COL_3 }, { ROW_1, COL_3 }, { ROW_2, COL_3 }, { ROW_3, COL_3 }, { ROW_4, COL_3 }, { ROW_5, COL_3 }, { ROW_6, COL_3 }, { ROW_7, COL_3 }, { ROW_8, COL_3 } };
-GridLocation COL_4_LOCATIONS[] = { { ROW_0, COL_4 }, { ROW_1, COL_4 }, { ROW_2, COL_4 }, { ROW_3, COL_4 }, { ROW_4, COL_4 }, { ROW_5, COL_4 }, { ROW_6, COL_4 }, { ROW_7, COL_4 }, { ROW_8, COL_4 } };
-GridLocation COL_5_LOCATIONS[] = { { ROW_0, COL_5 }, { ROW_1, COL_5 }, { ROW_2, COL_5 }, { ROW_3, COL_5 }, { ROW_4, COL_5 }, { ROW_5, COL_5 }, { ROW_6, COL_5 }, { ROW_7, COL_5 }, { ROW_8, COL_5 } };
-GridLocation COL_6_LOCATIONS[] = { { ROW_0, COL_6 }, { ROW_1, COL_6 }, { ROW_2, COL_6 }, { ROW_3, COL_6 }, { ROW_4, COL_6 }, { ROW_5, COL_6 }, { ROW_6, COL_6 }, { ROW_7, COL_6 }, { ROW_8, COL_6 } };
-GridLocation COL_7_LOCATIONS[] = { { ROW_0, COL_7 }, { ROW_1, COL_7 }, { ROW_2, COL_7 }, { ROW_3, COL_7 }, { ROW_4, COL_7 }, { ROW_5, COL_7 }, { ROW_6, COL_7 }, { ROW_7, COL_7 }, { ROW_8, COL_7 } };
-GridLocation COL_8_LOCATIONS[] = { { ROW_0, COL_8 }, { ROW_1, COL_8 }, { ROW_2, COL_8 }, { ROW_3, COL_8 }, { ROW_4, COL_8 }, { ROW_5, COL_8 }, { ROW_6, COL_8 }, { ROW_7, COL_8 }, { ROW_8, COL_8 } };
-
-/* Regions */
-#define REGION_COL_0 {COL_0_LOCATIONS, sizeof(COL_0_LOCATIONS) / sizeof(COL_0_LOCATIONS[0])}
-#define REGION_COL_1 {COL_1_LOCATIONS, sizeof(COL_1_LOCATIONS) / sizeof(COL_1_LOCATIONS[0])}
-#define REGION_COL_2 {COL_2_LOCATIONS, sizeof(COL_2_LOCATIONS) / sizeof(COL_2_LOCATIONS[0])}
-#define REGION_COL_3 {COL_3_LOCATIONS, sizeof(COL_3_LOCATIONS) / sizeof(COL_3_LOCATIONS[0])}
-#define REGION_COL_4 {COL_4_LOCATIONS, sizeof(COL_4_LOCATIONS) / sizeof(COL_4_LOCATIONS[0])}
-#define REGION_COL_5 {COL_5_LOCATIONS, sizeof(COL_5_LOCATIONS) / sizeof(COL_5_LOCATIONS[0])}
-#define REGION_COL_6 {COL_6_LOCATIONS, sizeof(COL_6_LOCATIONS) / sizeof(COL_6_LOCATIONS[0])}
-#define REGION_COL_7 {COL_7_LOCATIONS, sizeof(COL_7_LOCATIONS) / sizeof(COL_7_LOCATIONS[0])}
-#define REGION_COL_8 {COL_8_LOCATIONS, sizeof(COL_8_LOCATIONS) / sizeof(COL_8_LOCATIONS[0])}
-
-/* Constraints */
-#define CONSTRAINT_COL_0 { REGION_COL_0, SUDOKU_FUNCS }
-#define CONSTRAINT_COL_1 { REGION_COL_1, SUDOKU_FUNCS }
-#define CONSTRAINT_COL_2 { REGION_COL_2, SUDOKU_FUNCS }
-#define CONSTRAINT_COL_3 { REGION_COL_3, SUDOKU_FUNCS }
-#define CONSTRAINT_COL_4 { REGION_COL_4, SUDOKU_FUNCS }
-#define CONSTRAINT_COL_5 { REGION_COL_5, SUDOKU_FUNCS }
-#define CONSTRAINT_COL_6 { REGION_COL_6, SUDOKU_FUNCS }
-#define CONSTRAINT_COL_7 { REGION_COL_7, SUDOKU_FUNCS }
-#define CONSTRAINT_COL_8 { REGION_COL_8, SUDOKU_FUNCS }
-
-/*************************************/
-/*       Subgrid constraints         */
-/*************************************/
-
-/* Location arrays */
-
-GridLocation SUB_0_LOCATIONS[] = { { ROW_0, COL_0 }, { ROW_0, COL_1 }, { ROW_0, COL_2 }, { ROW_1, COL_0 }, { ROW_1, COL_1 }, { ROW_1, COL_2 }, { ROW_2, COL_0 }, { ROW_2, COL_1 }, { ROW_2, COL_2 } };
-GridLocation SUB_1_LOCATIONS[] = { { ROW_0, COL_3 }, { ROW_0, COL_4 }, { ROW_0, COL_5 }, { ROW_1, COL_3 }, { ROW_1, COL_4 }, { ROW_1, COL_5 }, { ROW_2, COL_3 }, { ROW_2, COL_4 }, { ROW_2, COL_5 } };
-GridLocation SUB_2_LOCATIONS[] = { { ROW_0, COL_6 }, { ROW_0, COL_7 }, { ROW_0, COL_8 }, { ROW_1, COL_6 }, { ROW_1, COL_7 }, { ROW_1, COL_8 }, { ROW_2, COL_6 }, { ROW_2, COL_7 }, { ROW_2, COL_8 } };
-GridLocation SUB_3_LOCATIONS[] = { { ROW_3, COL_0 }, { ROW_3, COL_1 }, { ROW_3, COL_2 }, { ROW_4, COL_0 }, { ROW_4, COL_1 }, { ROW_4, COL_2 }, { ROW_5, COL_0 }, { ROW_5, COL_1 }, { ROW_5, COL_2 } };
-GridLocation SUB_4_LOCATIONS[] = { { ROW_3, COL_3 }, { ROW_3, COL_4 }, { ROW_3, COL_5 }, { ROW_4, COL_3 }, { ROW_4, COL_4 }, { ROW_4, COL_5 }, { ROW_5, COL_3 }, { ROW_5, COL_4 }, { ROW_5, COL_5 } };
-GridLocation SUB_5_LOCATIONS[] = { { ROW_3, COL_6 }, { ROW_3, COL_7 }, { ROW_3, COL_8 }, { ROW_4, COL_6 }, { ROW_4, COL_7 }, { ROW_4, COL_8 }, { ROW_5, COL_6 }, { ROW_5, COL_7 }, { ROW_5, COL_8 } };
-GridLocation SUB_6_LOCATIONS[] = { { ROW_6, COL_0 }, { ROW_6, COL_1 }, { ROW_6, COL_2 }, { ROW_7, COL_0 }, { ROW_7, COL_1 }, { ROW_7, COL_2 }, { ROW_8, COL_0 }, { ROW_8, COL_1 }, { ROW_8, COL_2 } };
-GridLocation SUB_7_LOCATIONS[] = { { ROW_6, COL_3 }, { ROW_6, COL_4 }, { ROW_6, COL_5 }, { ROW_7, COL_3 }, { ROW_7, COL_4 }, { ROW_7, COL_5 }, { ROW_8, COL_3 }, { ROW_8, COL_4 }, { ROW_8, COL_5 } };
-GridLocation SUB_8_LOCATIONS[] = { { ROW_6, COL_6 }, { ROW_6, COL_7 }, { ROW_6, COL_8 }, { ROW_7, COL_6 }, { ROW_7, COL_7 }, { ROW_7, COL_8 }, { ROW_8, COL_6 }, { ROW_8, COL_7 }, { ROW_8, COL_8 } };
-
-/* Regions */
-#define REGION_SUB_0 { SUB_0_LOCATIONS, sizeof(SUB_0_LOCATIONS) / sizeof(SUB_0_LOCATIONS[0]) }
-#define REGION_SUB_1 { SUB_1_LOCATIONS, sizeof(SUB_1_LOCATIONS) / sizeof(SUB_1_LOCATIONS[0]) }
-#define REGION_SUB_2 { SUB_2_LOCATIONS, sizeof(SUB_2_LOCATIONS) / sizeof(SUB_2_LOCATIONS[0]) }
-#define REGION_SUB_3 { SUB_3_LOCATIONS, sizeof(SUB_3_LOCATIONS) / sizeof(SUB_3_LOCATIONS[0]) }
-#define REGION_SUB_4 { SUB_4_LOCATIONS, sizeof(SUB_4_LOCATIONS) / sizeof(SUB_4_LOCATIONS[0]) }
-#define REGION_SUB_5 { SUB_5_LOCATIONS, sizeof(SUB_5_LOCATIONS) / sizeof(SUB_5_LOCATIONS[0]) }
-#define REGION_SUB_6 { SUB_6_LOCATIONS, sizeof(SUB_6_LOCATIONS) / sizeof(SUB_6_LOCATIONS[0]) }
-#define REGION_SUB_7 { SUB_7_LOCATIONS, sizeof(SUB_7_LOCATIONS) / sizeof(SUB_7_LOCATIONS[0]) }
-#define REGION_SUB_8 { SUB_8_LOCATIONS, sizeof(SUB_8_LOCATIONS) / sizeof(SUB_8_LOCATIONS[0]) }
-
-/* Constraints */
-#define CONSTRAINT_SUB_0 { REGION_SUB_0, SUDOKU_FUNCS }
-#define CONSTRAINT_SUB_1 { REGION_SUB_1, SUDOKU_FUNCS }
-#define CONSTRAINT_SUB_2 { REGION_SUB_2, SUDOKU_FUNCS }
-#define CONSTRAINT_SUB_3 { REGION_SUB_3, SUDOKU_FUNCS }
-#define CONSTRAINT_SUB_4 { REGION_SUB_4, SUDOKU_FUNCS }
-#define CONSTRAINT_SUB_5 { REGION_SUB_5, SUDOKU_FUNCS }
-#define CONSTRAINT_SUB_6 { REGION_SUB_6, SUDOKU_FUNCS }
-#define CONSTRAINT_SUB_7 { REGION_SUB_7, SUDOKU_FUNCS }
-#define CONSTRAINT_SUB_8 { REGION_SUB_8, SUDOKU_FUNCS }
-
-Constraint uvCons[] = { CONSTRAINT_ROW_0, CONSTRAINT_ROW_1, CONSTRAINT_ROW_2, CONSTRAINT_ROW_3, CONSTRAINT_ROW_4, CONSTRAINT_ROW_5, CONSTRAINT_ROW_6, CONSTRAINT_ROW_7, CONSTRAINT_ROW_8,
-                        CONSTRAINT_COL_0, CONSTRAINT_COL_1, CONSTRAINT_COL_2, CONSTRAINT_COL_3, CONSTRAINT_COL_4, CONSTRAINT_COL_5, CONSTRAINT_COL_6, CONSTRAINT_COL_7, CONSTRAINT_COL_8,
-                        CONSTRAINT_SUB_0, CONSTRAINT_SUB_1, CONSTRAINT_SUB_2, CONSTRAINT_SUB_3, CONSTRAINT_SUB_4, CONSTRAINT_SUB_5, CONSTRAINT_SUB_6, CONSTRAINT_SUB_7, CONSTRAINT_SUB_8 };
-
-ConstraintList uniqueValueConstraints = { uvCons, sizeof(uvCons) / sizeof(uvCons[0])};
+/*
+** Region-wide update. Removes the value of the modified square from the
+** domain of every other square in the region without a value.
+*/
+static RegionMask RegionConstraintUpdater(Grid grid, const Region* region, const GridLocation modified)
+{
+    GridSquare* squares = GetSquares(grid);
+    const GridSquare* modifiedSquare = NULL;
+    RegionMask changed = 0;
+    unsigned int position = 0;
+
+    assert((region != NULL) && (region->cells != NULL));
+    assert(region->regionSize <= sizeof(RegionMask) * 8);
+
+    modifiedSquare = &squares[modified.row * GetGridOrder(grid) + modified.col];
+    if (modifiedSquare->value == VALUE_NONE) return 0;
+
+    for (position = 0; position < region->regionSize; ++position) {
+        GridSquare* square = &squares[region->cells[position]];
+
+        if ((square->value == VALUE_NONE) && (square != modifiedSquare) && DomRemoveElement(&square->domain, modifiedSquare->value)) {
+            changed |= (RegionMask)1 << position;
+        }
+    }
+
+    return changed;
+}
+
+#define SUDOKU_FUNCS { UniqueValues, BinaryConstraintUpdater, RegionConstraintUpdater }
+
+/*****************************************************************************/
+/* Constraint generation                                                     */
+/*****************************************************************************/
+
+/*
+** Points the next constraint of list at the next gridOrder locations of
+** storage. Returns the constraint's locations.
+*/
+static GridLocation* AddRegion(ConstraintList* list, GridLocation* storage, const unsigned int gridOrder)
+{
+    const ConstraintFuncs funcs = SUDOKU_FUNCS;
+    Constraint* constraint = &list->constraints[list->numConstraints];
+
+    constraint->region.locations = storage + list->numConstraints * gridOrder;
+    constraint->region.regionSize = gridOrder;
+    constraint->region.cells = NULL;
+    constraint->region.rowMask = 0;
+    constraint->region.colMask = 0;
+    constraint->funcs = funcs;
+    constraint->target = 0;
+
+    ++list->numConstraints;
+    return constraint->region.locations;
+}
+
+/*
+** Allocates a list for a grid of gridOrder with room for a row, column and
+** one other region per line, and adds the rows and then the columns. The
+** list, its constraints and their locations share one allocation; storage is
+** set to the locations.
+**
+** Returns NULL if memory can't be allocated.
+*/
+static ConstraintList* CreateLineConstraints(const unsigned int gridOrder, GridLocation** storage)
+{
+    const unsigned int numConstraints = 3 * gridOrder;
+    ConstraintList* list = NULL;
+    unsigned int line = 0;
+
+    list = (ConstraintList*)malloc(sizeof(ConstraintList) + numConstraints * sizeof(Constraint) + numConstraints * gridOrder * sizeof(GridLocation));
+    if (list == NULL) return NULL;
+
+    list->constraints = (Constraint*)(list + 1);
+    list->numConstraints = 0;
+    list->neighbourStart = NULL;
+    list->neighbours = NULL;
+    list->cells = NULL;
+    list->gridOrder = 0;
+    list->regionStart = NULL;
+    list->regionIndices = NULL;
+    list->peerStart = NULL;
+    list->peers = NULL;
+    *storage = (GridLocation*)(list->constraints + numConstraints);
+
+    for (line = 0; line < gridOrder; ++line) {
+        GridLocation* locations = AddRegion(list, *storage, gridOrder);
+        unsigned int position = 0;
+
+        for (position = 0; position < gridOrder; ++position) {
+            locations[position].row = line;
+            locations[position].col = position;
+        }
+    }
+
+    for (line = 0; line < gridOrder; ++line) {
+        GridLocation* locations = AddRegion(list, *storage, gridOrder);
+        unsigned int position = 0;
+
+        for (position = 0; position < gridOrder; ++position) {
+            locations[position].row = position;
+            locations[position].col = line;
+        }
+    }
+
+    return list;
+}
+
+/*
+** Creates the row, column and box constraints for a grid with boxes of
+** boxOrder by boxOrder squares. The compiled cell indices share one
+** allocation; see CreateLineConstraints for the rest.
+**
+** Returns NULL if memory can't be allocated.
+*/
+static ConstraintList* CreateSudokuConstraints(const unsigned int boxOrder)
+{
+    const unsigned int gridOrder = boxOrder * boxOrder;
+    ConstraintList* list = NULL;
+    GridLocation* storage = NULL;
+    unsigned int line = 0;
+
+    list = CreateLineConstraints(gridOrder, &storage);
+    if (list == NULL) return NULL;
+
+    /* Boxes left to right and top to bottom */
+    for (line = 0; line < gridOrder; ++line) {
+        GridLocation* locations = AddRegion(list, storage, gridOrder);
+        unsigned int position = 0;
+
+        for (position = 0; position < gridOrder; ++position) {
+            locations[position].row = (line / boxOrder) * boxOrder + position / boxOrder;
+            locations[position].col = (line % boxOrder) * boxOrder + position % boxOrder;
+        }
+    }
+
+    assert(list->numConstraints == 3 * gridOrder);
+
+    if (!CompileConstraints(list, gridOrder)) {
+        free(list);
+        return NULL;
+    }
+
+    return list;
+}
+
+/*****************************************************************************/
+/* Constraint lists                                                          */
+/*****************************************************************************/
+
+unsigned int GetSudokuBoxOrder(const unsigned int gridOrder)
+{
+    unsigned int boxOrder = 0;
+
+    for (boxOrder = MIN_SUDOKU_BOX_ORDER; boxOrder <= MAX_SUDOKU_BOX_ORDER; ++boxOrder) {
+        if (boxOrder * boxOrder == gridOrder) return boxOrder;
+    }
+
+    return 0;
+}
+
+ConstraintList* GetSudokuConstraints(const unsigned int gridOrder)
+{
+    const unsigned int boxOrder = GetSudokuBoxOrder(gridOrder);
+
+    if (boxOrder == 0) return NULL;
+
+    if (sudokuConstraints[boxOrder] == NULL) {
+        sudokuConstraints[boxOrder] = CreateSudokuConstraints(boxOrder);
+    }
+
+    return sudokuConstraints[boxOrder];
+}
+
+bool CreateJigsawConstraints(ConstraintList** list, const unsigned int gridOrder, const unsigned int* regionOfCell)
+{
+    const unsigned int numSquares = gridOrder * gridOrder;
+    ConstraintList* newList = NULL;
+    GridLocation* storage = NULL;
+    unsigned int cell = 0;
+    unsigned int index = 0;
+
+    assert((list != NULL) && (regionOfCell != NULL));
+
+    if ((gridOrder == 0) || (gridOrder > MAX_REGION_GRID_ORDER)) return false;
+
+    newList = CreateLineConstraints(gridOrder, &storage);
+    if (newList == NULL) return false;
+
+    /* Regions take the last gridOrder constraints in label order, and start empty */
+    for (index = 0; index < gridOrder; ++index) {
+        AddRegion(newList, storage, gridOrder);
+        newList->constraints[newList->numConstraints - 1].region.regionSize = 0;
+    }
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        Region* region = NULL;
+
+        if ((regionOfCell[cell] == 0) || (regionOfCell[cell] > gridOrder)) break;
+
+        region = &newList->constraints[2 * gridOrder + regionOfCell[cell] - 1].region;
+        if (region->regionSize == gridOrder) break;
+
+        region->locations[region->regionSize].row = cell / gridOrder;
+        region->locations[region->regionSize].col = cell % gridOrder;
+        ++region->regionSize;
+    }
+
+    /* Every square must be labelled, so each region is filled exactly */
+    if ((cell < numSquares) || !CompileConstraints(newList, gridOrder)) {
+        free(newList);
+        return false;
+    }
+
+    *list = newList;
+    return true;
+}
+
+ConstraintFuncs GetUniqueValueFuncs(void)
+{
+    const ConstraintFuncs funcs = SUDOKU_FUNCS;
+    return funcs;
+}
+
+void ReleaseSudokuConstraints(void)
+{
+    unsigned int boxOrder = 0;
+
+    for (boxOrder = 0; boxOrder <= MAX_SUDOKU_BOX_ORDER; ++boxOrder) {
+        DestroyConstraintList(&sudokuConstraints[boxOrder]);
+    }
+}
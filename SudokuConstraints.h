@@ -33,6 +33,54 @@
 
 #include "Constraint.h"
 
-ConstraintList uniqueValueConstraints;
+/*
+** Standard Sudoku grids have an order that is the square of the box order:
+** 4x4 grids with 2x2 boxes up to 64x64 grids with 8x8 boxes.
+*/
+enum {
+    MIN_SUDOKU_BOX_ORDER = 2,
+    MAX_SUDOKU_BOX_ORDER = 8
+};
+
+/*
+** Returns the box order of a standard Sudoku grid of gridOrder, or 0 if
+** gridOrder isn't supported.
+*/
+unsigned int GetSudokuBoxOrder(const unsigned int gridOrder);
+
+/*
+** Returns the compiled unique value constraints for a standard Sudoku grid of
+** gridOrder: one for each row, column and box, in that order. Lists are
+** generated the first time an order is requested and shared by every puzzle
+** of that order, so they must not be modified. Generation isn't thread safe.
+**
+** Returns NULL if gridOrder isn't supported or memory can't be allocated.
+*/
+ConstraintList* GetSudokuConstraints(const unsigned int gridOrder);
+
+/*
+** Creates compiled unique value constraints for a Jigsaw Sudoku grid of
+** gridOrder: one for each row, then each column, then each irregular region.
+**
+** regionOfCell holds the region of each square by cell index, 1 through
+** gridOrder. Each region must have gridOrder squares, though they need not be
+** contiguous. The list isn't shared; see DestroyConstraintList.
+**
+** Returns false and leaves list unmodified if a square's region is out of
+** range, a region has too many squares, or memory can't be allocated.
+*/
+bool CreateJigsawConstraints(ConstraintList** list, const unsigned int gridOrder, const unsigned int* regionOfCell);
+
+/*
+** Returns the functions of a constraint requiring every value in its region
+** to be different. Other constraints with that rule, e.g. Killer cages, use
+** the same update functions.
+*/
+ConstraintFuncs GetUniqueValueFuncs(void);
+
+/*
+** Frees every generated constraint list. No puzzle using them may remain.
+*/
+void ReleaseSudokuConstraints(void);
 
 #endif // !SUDOKU_CONSTRAINTS_H
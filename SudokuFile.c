@@ -29,11 +29,36 @@
 */
 
 #include "SudokuFile.h"
+#include "KillerConstraints.h"
+#include "VariantConstraints.h"
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define isWhitespace(ch) (((ch) < '!') || ((ch) > '~'))
+#define isDigit(ch) (((ch) >= '0') && ((ch) <= '9'))
+
+/* Keywords starting the sections that may follow the grid */
+#define CAGE_KEYWORD "cages"
+#define REGION_KEYWORD "regions"
+#define VARIANT_KEYWORD "variants"
+
+enum {
+    MAX_KEYWORD_LENGTH = 15
+};
+
+/* Names of the rules in a variants section */
+static const struct {
+    const char* name;
+    unsigned int variant;
+} variantNames[] = {
+    { "diagonal",   VARIANT_DIAGONAL },
+    { "windoku",    VARIANT_WINDOKU },
+    { "antiking",   VARIANT_ANTI_KING },
+    { "antiknight", VARIANT_ANTI_KNIGHT }
+};
 
 /*
 ** Reads file to find the next linefeed or non-whitespace character. Returns
@@ -51,52 +76,49 @@ static int FindNextChar(FILE* file)
 }
 
 /*
-** Gets the next square value (VALUE_NONE through VALUE_9) from file.
+** Gets the next value (VALUE_NONE through maxValue) from file. Values are
+** decimal and may have more than one digit.
 **
 ** If successful, updates *value and returns true.
 **
 ** If unsuccesful, returns false. *value will contain the source of the error
 ** (e.g., EOF or invalid character).
 */
-static bool GetValue(FILE* file, int* value)
+static bool GetValue(FILE* file, const unsigned int maxValue, int* value)
 {
     int input = EOF;
+    unsigned int number = 0;
 
     /* Ignore leading linefeeds */
     while ((input = FindNextChar(file)) == '\n');
 
-    /* Should be a comma or a character 1 through 9 */
-    switch (input) {
-    case '1':
-    case '2':
-    case '3':
-    case '4':
-    case '5':
-    case '6':
-    case '7':
-    case '8':
-    case '9':
-        *value = input - '0';
-        assert(*value > VALUE_NONE);
-
-        if (*value >= numSquareValues) {
-            *value = input;
-            return false;
-        }
-
-        break;
-
-    case ',':
+    /* Should be a comma or a value 1 through gridOrder */
+    if (input == ',') {
         *value = VALUE_NONE;
         return true;
+    }
 
-    default:
+    if (!isDigit(input) || (input == '0')) {
         *value = input;
         return false;
     }
 
+    while (isDigit(input)) {
+        number = number * 10 + (input - '0');
+        if (number > maxValue) {
+            *value = input;
+            return false;
+        }
+
+        input = getc(file);
+    }
+
+    *value = (int)number;
+    assert(*value > VALUE_NONE);
+
     /* Next character after a value can be a comma, linefeed, or EOF */
-    input = FindNextChar(file);
+    if (isWhitespace(input) && (input != '\n') && (input != EOF)) input = FindNextChar(file);
+
     switch (input) {
     case EOF:
     case ',':
@@ -109,6 +131,268 @@ static bool GetValue(FILE* file, int* value)
     }
 }
 
+/*
+** Counts the values on the first line of file holding any, which is the
+** order of the grid. A comma ends a value, as does the end of the line if a
+** value follows the last comma.
+*/
+static unsigned int CountRowValues(FILE* file)
+{
+    unsigned int numValues = 0;
+    bool pending = false;
+    int input = EOF;
+
+    while ((input = FindNextChar(file)) != EOF) {
+        if (input == '\n') {
+            if ((numValues > 0) || pending) break;
+        }
+        else if (input == ',') {
+            ++numValues;
+            pending = false;
+        }
+        else {
+            pending = true;
+        }
+    }
+
+    return numValues + (pending ? 1 : 0);
+}
+
+/*
+** Prints the character GetValue failed on.
+*/
+static void PrintUnexpected(const int input)
+{
+    if (input == EOF) {
+        printf("ERROR: Unexpected EOF at ");
+    }
+    else {
+        printf("ERROR: Unexpected '%c' at ", input);
+    }
+}
+
+/*
+** Reads the next word in file, ignoring line feeds, into keyword. Longer words
+** are cut to MAX_KEYWORD_LENGTH characters. Returns false if there's no word.
+*/
+static bool ReadKeyword(FILE* file, char keyword[MAX_KEYWORD_LENGTH + 1])
+{
+    size_t length = 0;
+    int input = EOF;
+
+    while ((input = FindNextChar(file)) == '\n');
+
+    while ((input != EOF) && !isWhitespace(input)) {
+        if (length < MAX_KEYWORD_LENGTH) keyword[length++] = (char)input;
+        input = getc(file);
+    }
+
+    keyword[length] = '\0';
+    return (length > 0);
+}
+
+/*
+** Reads the region map of a Jigsaw Sudoku file into the puzzle's unique value
+** constraints.
+*/
+static bool ReadRegions(FILE* file, SudokuPuzzle* pzl)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const unsigned int numSquares = gridOrder * gridOrder;
+    ConstraintList* regions = NULL;
+    unsigned int* regionOfCell = NULL;
+    unsigned int cell = 0;
+    int input = EOF;
+
+    regionOfCell = (unsigned int*)malloc(numSquares * sizeof(unsigned int));
+    if (regionOfCell == NULL) return false;
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        if (!GetValue(file, gridOrder, &input) || (input == VALUE_NONE)) {
+            if (input == VALUE_NONE) {
+                printf("ERROR: Missing region at ");
+            }
+            else {
+                PrintUnexpected(input);
+            }
+
+            printf("region map row %u, col %u\n", cell / gridOrder, cell % gridOrder);
+            free(regionOfCell);
+            return false;
+        }
+
+        regionOfCell[cell] = (unsigned int)input;
+    }
+
+    if (!CreateJigsawConstraints(&regions, gridOrder, regionOfCell)) {
+        printf("ERROR: Invalid regions\n");
+        free(regionOfCell);
+        return false;
+    }
+
+    SetSudokuRegions(pzl, regions);
+
+    free(regionOfCell);
+    return true;
+}
+
+/*
+** Reads the rule names of a variants section, separated by commas and ended
+** by a line feed, and adds the rules to the puzzle's unique value
+** constraints.
+*/
+static bool ReadVariants(FILE* file, SudokuPuzzle* pzl)
+{
+    ConstraintList* list = NULL;
+    unsigned int variants = 0;
+    int input = EOF;
+
+    while ((input = FindNextChar(file)) == '\n');
+
+    do {
+        char name[MAX_KEYWORD_LENGTH + 1];
+        size_t length = 0;
+        size_t index = 0;
+
+        if (input == ',') input = FindNextChar(file);
+
+        while ((input != EOF) && (input != ',') && (input != '\n')) {
+            if (!isWhitespace(input) && (length < MAX_KEYWORD_LENGTH)) name[length++] = (char)input;
+            input = getc(file);
+        }
+
+        name[length] = '\0';
+
+        for (index = 0; index < sizeof(variantNames) / sizeof(variantNames[0]); ++index) {
+            if (strcmp(name, variantNames[index].name) == 0) break;
+        }
+
+        if (index == sizeof(variantNames) / sizeof(variantNames[0])) {
+            printf("ERROR: Unknown variant '%s'\n", name);
+            return false;
+        }
+
+        variants |= variantNames[index].variant;
+    } while (input == ',');
+
+    if (!CreateVariantConstraints(&list, pzl->uniqueValue, GetGridOrder(pzl->grid), variants)) {
+        printf("ERROR: Invalid variants\n");
+        return false;
+    }
+
+    SetSudokuRegions(pzl, list);
+    return true;
+}
+
+/*
+** Reads the cage map and sums of a Killer Sudoku file into the puzzle's cages.
+*/
+static bool ReadCages(FILE* file, SudokuPuzzle* pzl)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    const unsigned int numSquares = gridOrder * gridOrder;
+    ConstraintList* cages = NULL;
+    unsigned int* cageOfCell = NULL;
+    unsigned int* sums = NULL;
+    unsigned int numCages = 0;
+    unsigned int cell = 0;
+    int input = EOF;
+    bool success = true;
+
+    cageOfCell = (unsigned int*)malloc(numSquares * sizeof(unsigned int));
+    if (cageOfCell == NULL) return false;
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        if (!GetValue(file, numSquares, &input)) {
+            PrintUnexpected(input);
+            printf("cage map row %u, col %u\n", cell / gridOrder, cell % gridOrder);
+            free(cageOfCell);
+            return false;
+        }
+
+        cageOfCell[cell] = (unsigned int)input;
+        if (cageOfCell[cell] > numCages) numCages = cageOfCell[cell];
+    }
+
+    sums = (unsigned int*)malloc((numCages > 0 ? numCages : 1) * sizeof(unsigned int));
+    if (sums == NULL) {
+        free(cageOfCell);
+        return false;
+    }
+
+    for (cell = 0; (cell < numCages) && success; ++cell) {
+        success = GetValue(file, gridOrder * (gridOrder + 1) / 2, &input) && (input != VALUE_NONE);
+        if (!success) {
+            if (input == VALUE_NONE) {
+                printf("ERROR: Missing value at ");
+            }
+            else {
+                PrintUnexpected(input);
+            }
+
+            printf("sum of cage %u\n", cell + 1);
+        }
+
+        sums[cell] = (unsigned int)input;
+    }
+
+    if (success && !CreateCageConstraints(&cages, gridOrder, cageOfCell, sums, numCages)) {
+        printf("ERROR: Invalid cages\n");
+        success = false;
+    }
+
+    if (success) {
+        DestroyCageConstraints(&pzl->cages);
+        pzl->cages = cages;
+    }
+
+    free(cageOfCell);
+    free(sums);
+    return success;
+}
+
+/*
+** Reads the sections following the grid. Reading stops at the first word that
+** doesn't start a section, so any other text may follow the grid.
+**
+** Variants are added to the regions read before them, so a regions section
+** can't follow the variants section, and all of a puzzle's rules are named in
+** one variants section.
+*/
+static bool ReadSections(FILE* file, SudokuPuzzle* pzl)
+{
+    char keyword[MAX_KEYWORD_LENGTH + 1];
+    bool variantsRead = false;
+
+    while (ReadKeyword(file, keyword)) {
+        if (strcmp(keyword, CAGE_KEYWORD) == 0) {
+            if (!ReadCages(file, pzl)) return false;
+        }
+        else if (strcmp(keyword, REGION_KEYWORD) == 0) {
+            if (variantsRead) {
+                printf("ERROR: Regions must come before variants\n");
+                return false;
+            }
+
+            if (!ReadRegions(file, pzl)) return false;
+        }
+        else if (strcmp(keyword, VARIANT_KEYWORD) == 0) {
+            if (variantsRead) {
+                printf("ERROR: Variants must be named in one section\n");
+                return false;
+            }
+
+            if (!ReadVariants(file, pzl)) return false;
+            variantsRead = true;
+        }
+        else {
+            break;
+        }
+    }
+
+    return true;
+}
+
 /*
 ** Helper function to accomplish the actual work of reading a file into the
 ** Sudoku grid.
@@ -125,14 +409,8 @@ static bool ReadSudokuFile(FILE* file, SudokuPuzzle* pzl)
             int input = EOF;
             GridSquare* square;
 
-            if (!GetValue(file, &input)) {
-                if (input == EOF) {
-                    printf("ERROR: Unexpected EOF at ");
-                }
-                else {
-                    printf("ERROR: Unexpected '%c' at ", input);
-                }
-
+            if (!GetValue(file, gridOrder, &input)) {
+                PrintUnexpected(input);
                 printf("row %u, col %u\n", row, col);
                 return false;
             }
@@ -151,7 +429,7 @@ static bool ReadSudokuFile(FILE* file, SudokuPuzzle* pzl)
         }
     }
 
-    return true;
+    return ReadSections(file, pzl);
 }
 
 bool LoadSudoku(SudokuPuzzle* pzl, const char* filename)
@@ -167,3 +445,87 @@ bool LoadSudoku(SudokuPuzzle* pzl, const char* filename)
 
     return success;
 }
+
+bool CreateSudokuFromFile(SudokuPuzzle** pzl, const char* filename)
+{
+    SudokuPuzzle* newPuzzle = NULL;
+    unsigned int gridOrder = 0;
+    bool success = true;
+    FILE* file = NULL;
+
+    assert(pzl != NULL);
+
+    file = fopen(filename, "r");
+    if (file == NULL) return false;
+
+    gridOrder = CountRowValues(file);
+    rewind(file);
+
+    if (!CreateSudokuOfOrder(&newPuzzle, gridOrder)) {
+        printf("ERROR: Unsupported grid order %u\n", gridOrder);
+        fclose(file);
+        return false;
+    }
+
+    success = ReadSudokuFile(file, newPuzzle);
+
+    if ((fclose(file) != 0) || !success) {
+        DestroySudoku(&newPuzzle);
+        return false;
+    }
+
+    *pzl = newPuzzle;
+    return true;
+}
+
+bool LoadSamurai(SamuraiPuzzle* pzl, const char* filename)
+{
+    bool success = true;
+    unsigned int row = 0;
+    FILE* file = NULL;
+
+    assert(pzl != NULL);
+
+    file = fopen(filename, "r");
+    if (file == NULL) return false;
+
+    for (row = 0; success && (row < SAMURAI_ORDER); ++row) {
+        unsigned int col = 0;
+
+        for (col = 0; col < SAMURAI_ORDER; ++col) {
+            int input = EOF;
+            GridSquare* square;
+
+            if (!GetValue(file, SAMURAI_GRID_ORDER, &input)) {
+                PrintUnexpected(input);
+                printf("row %u, col %u\n", row, col);
+                success = false;
+                break;
+            }
+
+            if (!IsSamuraiSquare(row, col)) {
+                if (input == VALUE_NONE) continue;
+
+                printf("ERROR: Value outside the grids at row %u, col %u\n", row, col);
+                success = false;
+                break;
+            }
+
+            square = GetSquare(pzl->grid, row, col);
+            assert(square != NULL);
+
+            square->value = input;
+            if (input == VALUE_NONE) {
+                DomSetFull(&square->domain);
+            }
+            else {
+                DomSetEmpty(&square->domain);
+                DomAddElement(&square->domain, input);
+            }
+        }
+    }
+
+    if (fclose(file) != 0) return false;
+
+    return success;
+}
\ No newline at end of file
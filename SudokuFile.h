@@ -31,6 +31,7 @@
 #ifndef SUDOKU_FILE_H
 #define SUDOKU_FILE_H
 
+#include "SamuraiPuzzle.h"
 #include "SudokuPuzzle.h"
 
 #include <stdbool.h>
@@ -42,8 +43,8 @@
 **  - The sudoku grid is filled in row-wise using values from the file. File
 **    reading ends once the grid is filled.
 **
-**  - Values must be in the range of 1 to 9. No attempt is made to parse
-**    multidigit values.
+**  - Values must be in the range of 1 to the grid order, written in
+**    decimal. Grids larger than nine-by-nine use multidigit values.
 **
 **  - A comma without a preceding value is considered VALUE_NONE.
 **
@@ -51,6 +52,28 @@
 **
 **  - Whitespace other than '\n' is always ignored. Any character outside the
 **    range of '!' to '~' is considered whitespace.
+**
+** Sections may follow the grid, each starting with a line holding its name:
+**
+**  - "regions" - Jigsaw Sudoku. A region map: a grid of the same order, read
+**    the same way, giving the region of each square, 1 through the grid
+**    order. The regions replace the boxes, and each must have one square for
+**    every value.
+**
+**  - "variants" - Variant Sudoku. A line of rule names separated by commas:
+**    "diagonal", "windoku", "antiking" or "antiknight". See
+**    VariantConstraints.h. The rules apply to the regions read so far, so a
+**    regions section must come first.
+**
+**  - "cages" - Killer Sudoku. A cage map giving the cage of each square.
+**    Cages are numbered from 1; squares outside every cage are left blank.
+**    The map is followed by the sum of each cage in cage number order,
+**    separated by a comma or a line feed.
+**
+** Anything else following the grid is ignored.
+**
+** Samurai files hold the 21x21 grid enclosing all five grids, read the same
+** way. Squares outside the grids must be blank, and no sections follow.
 */
 
 /*
@@ -58,10 +81,30 @@
 **
 ** Initial values are assigned to both the square and the associated domain.
 ** Squares without an initial value are set to VALUE_NONE and the associated
-** domain is full.
+** domain is full. Regions, variants and cages in the file replace the
+** puzzle's.
 **
 ** Returns true if the file successfully loaded.
 */
 bool LoadSudoku(SudokuPuzzle* pzl, const char* filename);
 
+/*
+** Creates a puzzle sized to fit the file and loads it. The grid order is the
+** number of values on the first line holding any, so each row of the grid
+** should be on its own line.
+**
+** If successful, the pzl parameter is updated to point to the newly created
+** puzzle and true is returned. Otherwise pzl is not modified and false is
+** returned.
+*/
+bool CreateSudokuFromFile(SudokuPuzzle** pzl, const char* filename);
+
+/*
+** Loads a Samurai puzzle from file, as LoadSudoku. Squares outside the grids
+** are left without a value or domain.
+**
+** Returns true if the file successfully loaded.
+*/
+bool LoadSamurai(SamuraiPuzzle* pzl, const char* filename);
+
 #endif // !SUDOKU_FILE_H
@@ -33,29 +33,29 @@
 #include <assert.h>
 #include <stdio.h>
 
-static char ValueToChar(SquareValue value)
+/*
+** Returns the number of decimal digits needed to print value.
+*/
+static unsigned int NumDigits(unsigned int value)
 {
-    switch (value) {
-    case VALUE_1:       return '1';
-    case VALUE_2:       return '2';
-    case VALUE_3:       return '3';
-    case VALUE_4:       return '4';
-    case VALUE_5:       return '5';
-    case VALUE_6:       return '6';
-    case VALUE_7:       return '7';
-    case VALUE_8:       return '8';
-    case VALUE_9:       return '9';
-    default:            return ' ';
+    unsigned int numDigits = 1;
+
+    while (value >= 10) {
+        value /= 10;
+        ++numDigits;
     }
+
+    return numDigits;
 }
 
 void PrintSudoku(SudokuPuzzle* pzl)
 {
     unsigned int row = 0;
     unsigned int gridOrder = GetGridOrder(pzl->grid);
-    unsigned int gridWidth =    gridOrder * 3           /* The value and a single space on either side */
-                              + gridOrder + 1;          /* Space for column separators and outer frame */
-    unsigned int colSpacing = gridWidth / gridOrder;    /* How often to place grid intersections */
+    unsigned int valueWidth = NumDigits(gridOrder);     /* Widest value in the grid */
+    unsigned int gridWidth =    gridOrder * (valueWidth + 2)    /* The value and a single space on either side */
+                              + gridOrder + 1;                  /* Space for column separators and outer frame */
+    unsigned int colSpacing = gridWidth / gridOrder;            /* How often to place grid intersections */
 
     for (row = 0; row < gridOrder; ++row) {
         unsigned int col = gridWidth;
@@ -68,7 +68,12 @@ void PrintSudoku(SudokuPuzzle* pzl)
 
             assert(square != NULL);
 
-            printf(" %c |", ValueToChar(square->value));
+            if (square->value == VALUE_NONE) {
+                printf(" %*s |", (int)valueWidth, "");
+            }
+            else {
+                printf(" %*u |", (int)valueWidth, square->value);
+            }
         }
 
         putchar('\n');
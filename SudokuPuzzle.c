@@ -29,6 +29,7 @@
 */
 
 #include "SudokuPuzzle.h"
+#include "KillerConstraints.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -38,30 +39,55 @@ enum {
 };
 
 bool CreateSudoku(SudokuPuzzle** pzl)
+{
+    return CreateSudokuOfOrder(pzl, SudokuSize);
+}
+
+bool CreateSudokuOfOrder(SudokuPuzzle** pzl, const unsigned int gridOrder)
 {
     SudokuPuzzle* newPuzzle = NULL;
+    ConstraintList* constraints = NULL;
 
     assert(pzl != NULL);
 
+    constraints = GetSudokuConstraints(gridOrder);
+    if (constraints == NULL) return false;
+
     newPuzzle = (SudokuPuzzle*)malloc(sizeof(SudokuPuzzle));
     if (newPuzzle == NULL) return false;
 
-    if (!CreateGrid(&newPuzzle->grid, SudokuSize)) {
-        DestroySudoku(&newPuzzle);
+    if (!CreateGrid(&newPuzzle->grid, gridOrder)) {
+        free(newPuzzle);
         return false;
     }
 
-    newPuzzle->uniqueValue = &uniqueValueConstraints;
-    
+    newPuzzle->uniqueValue = constraints;
+    newPuzzle->ownsRegions = false;
+    newPuzzle->cages = NULL;
+    newPuzzle->cancel = NULL;
+
     *pzl = newPuzzle;
     return true;
 }
 
+void SetSudokuRegions(SudokuPuzzle* pzl, ConstraintList* regions)
+{
+    assert((pzl != NULL) && (regions != NULL));
+    assert(regions->gridOrder == GetGridOrder(pzl->grid));
+
+    if (pzl->ownsRegions) DestroyConstraintList(&pzl->uniqueValue);
+
+    pzl->uniqueValue = regions;
+    pzl->ownsRegions = true;
+}
+
 void DestroySudoku(SudokuPuzzle** pzl)
 {
     if ((pzl != NULL) && (*pzl != NULL)) {
 
         DestroyGrid(&(*pzl)->grid);
+        DestroyCageConstraints(&(*pzl)->cages);
+        if ((*pzl)->ownsRegions) DestroyConstraintList(&(*pzl)->uniqueValue);
         free(*pzl);
 
         *pzl = NULL;
@@ -90,5 +116,15 @@ bool isSudokuValid(SudokuPuzzle* pzl)
 {
     assert(pzl != NULL);
 
-    return ConstraintsMet(pzl->uniqueValue, pzl->grid);
+    if (!ConstraintsMet(pzl->uniqueValue, pzl->grid)) return false;
+
+    return (pzl->cages == NULL) || ConstraintsMet(pzl->cages, pzl->grid);
+}
+
+bool isSudokuCancelled(const SudokuPuzzle* pzl)
+{
+    assert(pzl != NULL);
+
+    /* The flag only ever goes from false to true, so no ordering is needed */
+    return (pzl->cancel != NULL) && atomic_load_explicit(pzl->cancel, memory_order_relaxed);
 }
\ No newline at end of file
@@ -34,6 +34,7 @@
 #include "Grid.h"
 #include "SudokuConstraints.h"
 
+#include <stdatomic.h>
 #include <stdbool.h>
 
 /*
@@ -51,17 +52,37 @@
 **   - Each region has the constraint that each of the digits 1-9 may appear
 **     only once within the region.
 **
+** Larger and smaller grids follow the same pattern: a grid of order n*n has
+** values 1 to n*n and is divided into rows, columns, and n-by-n boxes.
+**
 ** A Sudoku solution is one in which the grid is both complete (no blanks) and
 ** valid (each region's constraints are satisfied).
+**
+** Jigsaw Sudoku puzzles replace the boxes with irregular regions, and
+** variants such as X-Sudoku add regions and neighbour rules. ownsRegions is
+** true if uniqueValue holds such a list, which the puzzle owns; otherwise
+** uniqueValue is the shared standard constraints.
+**
+** Killer Sudoku puzzles also have cages: regions whose values must be
+** different and add up to the cage's sum. See KillerConstraints.h. cages is
+** NULL for other puzzles, and is owned by the puzzle.
+**
+** cancel is NULL unless a caller wants to stop a solver early, as when
+** several solvers race on copies of one puzzle (see PortfolioSolver.h).
+** Searching solvers poll it and, once it's set, return false with the grid
+** partly solved.
 */
 typedef struct {
     Grid grid;
     ConstraintList* uniqueValue;
+    bool ownsRegions;
+    ConstraintList* cages;
+    const atomic_bool* cancel;
 } SudokuPuzzle;
 
 /*
-** Creates a new Sudoku puzzle. The puzzle grid is blank and standard
-** constraints are used.
+** Creates a new nine-by-nine Sudoku puzzle. The puzzle grid is blank and
+** standard constraints are used.
 **
 ** If successful, the pzl parameter is updated to point to the newly created
 ** puzzle and true is returned.
@@ -71,7 +92,26 @@ typedef struct {
 bool CreateSudoku(SudokuPuzzle** pzl);
 
 /*
-** Destroys the Sudoku puzzle, along with the associated grid and constraints.
+** Creates a new blank Sudoku puzzle with standard constraints for a grid of
+** the given order. The order must be the square of a box order from
+** MIN_SUDOKU_BOX_ORDER to MAX_SUDOKU_BOX_ORDER, i.e. 4, 9, 16, ... 64.
+**
+** Returns false and leaves pzl unmodified if the order isn't supported or the
+** puzzle can't be created.
+*/
+bool CreateSudokuOfOrder(SudokuPuzzle** pzl, const unsigned int gridOrder);
+
+/*
+** Replaces the unique value constraints of the puzzle with a list from
+** CreateJigsawConstraints or CreateVariantConstraints, compiled for the
+** puzzle's grid order. The puzzle takes ownership of regions.
+*/
+void SetSudokuRegions(SudokuPuzzle* pzl, ConstraintList* regions);
+
+/*
+** Destroys the Sudoku puzzle, its grid, its own regions and its cages.
+** Standard constraints are shared between puzzles and aren't destroyed; see
+** ReleaseSudokuConstraints.
 */
 void DestroySudoku(SudokuPuzzle** pzl);
 
@@ -83,11 +123,16 @@ void DestroySudoku(SudokuPuzzle** pzl);
 bool isSudokuComplete(SudokuPuzzle* pzl);
 
 /*
-** Returns true if grid squares assigned a value do not violate region
+** Returns true if grid squares assigned a value do not violate region or cage
 ** constraints.
 **
 ** Note that a valid grid may be incomplete.
 */
 bool isSudokuValid(SudokuPuzzle* pzl);
 
+/*
+** Returns true if the puzzle has a cancel flag and it's been set.
+*/
+bool isSudokuCancelled(const SudokuPuzzle* pzl);
+
 #endif // !SUDOKU_PUZZLE_H
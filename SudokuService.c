@@ -0,0 +1,1236 @@
+/*
+** SudokuService.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+/* Unix domain sockets, fdopen and poll are POSIX, not standard C */
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "SudokuService.h"
+#include "AC3Solver/AC3Solver.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#define QUIT_REQUEST "quit"
+
+/* A request with no deadline */
+#define NO_DEADLINE UINT64_MAX
+
+enum {
+    PREWARMED_ORDER = 9,
+    SERVICE_BACKLOG = 8,
+    MAX_QUEUED_REQUESTS = 256,
+    READ_BUFFER_SIZE = 4 * (MAX_REQUEST_LENGTH + MAX_TAG_LENGTH + 32)
+};
+
+/*
+** Reads lines from a stream without waiting for input that hasn't arrived.
+** skipping is set while the rest of an overlong line is discarded.
+*/
+typedef struct {
+    FILE* file;
+    char buffer[READ_BUFFER_SIZE];
+    size_t start;
+    size_t end;
+    bool skipping;
+    bool ended;
+} LineReader;
+
+/*
+** A connection, or the input and output of ServeStream. Responses to the
+** client's requests are written to out. numWaiting counts its requests in the
+** queue, so a client that has disconnected is kept until they're answered.
+*/
+typedef struct {
+    LineReader reader;
+    FILE* out;
+    unsigned int numWaiting;
+} ServiceClient;
+
+/*
+** A thread that sets cancel once the armed deadline passes, so a solve polling
+** cancel stops in time. deadline is NO_DEADLINE while the timer is disarmed.
+** deadline and stop are guarded by lock, and changes are signalled with
+** changed.
+*/
+struct _DeadlineTimerType {
+    thrd_t thread;
+    mtx_t lock;
+    cnd_t changed;
+    uint64_t deadline;
+    bool stop;
+    atomic_bool cancel;
+};
+
+typedef struct _DeadlineTimerType DeadlineTimer;
+
+/*
+** A request read by the service. A request waiting in the queue either leads
+** a group of requests for the same puzzle, and is solved for them all, or
+** follows the leader at index leader.
+**
+**  arrival, deadline - Microseconds since the epoch when the request was read
+**                      and by which it must be answered, or NO_DEADLINE.
+**
+**  groupDeadline - For a leader, the earliest deadline of its group.
+**
+**  openSquares - Squares left blank by the AC3Solver pre-pass, an estimate of
+**                the request's difficulty.
+**
+**  canonical, transform - The canonical form of a 9x9 puzzle and the transform
+**                         to it, if canonicalFound is set.
+**
+**  client - The client the request came from, which its response goes to.
+*/
+typedef struct {
+    ServiceClient* client;
+    char tag[MAX_TAG_LENGTH + 1];
+    char grid[MAX_REQUEST_LENGTH + 1];
+    unsigned int gridOrder;
+    uint64_t arrival;
+    uint64_t deadline;
+    uint64_t groupDeadline;
+    unsigned long sequence;
+    unsigned int openSquares;
+    bool canonicalFound;
+    uint8_t canonical[CANON_SQUARES];
+    CanonTransform transform;
+    int leader;
+    bool queued;
+} ServiceRequest;
+
+/*
+** Requests read but not yet answered.
+*/
+typedef struct {
+    ServiceRequest requests[MAX_QUEUED_REQUESTS];
+    unsigned int numQueued;
+    unsigned long numRead;
+} RequestQueue;
+
+/*****************************************************************************/
+/* Request format                                                            */
+/*****************************************************************************/
+
+/*
+** Returns the value of a request character, VALUE_NONE for a blank, or -1 if
+** the character isn't a value.
+*/
+static int CharValue(const char ch)
+{
+    if ((ch == '.') || (ch == '0')) return VALUE_NONE;
+    if ((ch >= '1') && (ch <= '9')) return ch - '0';
+    if ((ch >= 'A') && (ch <= 'Z')) return ch - 'A' + 10;
+    if ((ch >= 'a') && (ch <= 'z')) return ch - 'a' + 10;
+
+    return -1;
+}
+
+/*
+** Returns the request character of a value.
+*/
+static char ValueChar(const SquareValue value)
+{
+    if (value == VALUE_NONE) return '.';
+    if (value < 10) return (char)('0' + value);
+
+    return (char)('A' + value - 10);
+}
+
+/*
+** Returns the grid order of a request of length characters, or 0 if the length
+** isn't a supported Sudoku grid.
+*/
+static unsigned int RequestOrder(const size_t length)
+{
+    unsigned int order = 0;
+
+    for (order = 1; order <= MAX_REQUEST_ORDER; ++order) {
+        if (order * order == length) return (GetSudokuBoxOrder(order) != 0) ? order : 0;
+    }
+
+    return 0;
+}
+
+/*
+** Returns the microseconds since the epoch.
+*/
+static uint64_t NowMicroseconds(void)
+{
+    struct timespec now;
+
+    timespec_get(&now, TIME_UTC);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+/*
+** Reads a request line: a grid, a tag and a grid, or a tag, a grid and a
+** deadline, separated by spaces.
+**
+** Returns NULL if successful, or the reason the request can't be read.
+*/
+static const char* ParseRequest(const char* line, ServiceRequest* request)
+{
+    const char* tokens[3] = { NULL };
+    size_t lengths[3] = { 0 };
+    unsigned int numTokens = 0;
+    const char* grid = NULL;
+    size_t gridLength = 0;
+    unsigned int cell = 0;
+
+    memset(request, 0, sizeof(*request));
+    request->arrival = NowMicroseconds();
+    request->deadline = NO_DEADLINE;
+    request->leader = -1;
+
+    while (*line != '\0') {
+        const size_t length = strcspn(line, " \t");
+
+        if (length > 0) {
+            if (numTokens == 3) return "too many fields";
+
+            tokens[numTokens] = line;
+            lengths[numTokens++] = length;
+        }
+
+        line += length;
+        line += strspn(line, " \t");
+    }
+
+    grid = tokens[(numTokens > 1) ? 1 : 0];
+    gridLength = lengths[(numTokens > 1) ? 1 : 0];
+
+    if (numTokens > 1) {
+        if (lengths[0] > MAX_TAG_LENGTH) return "tag too long";
+        memcpy(request->tag, tokens[0], lengths[0]);
+    }
+
+    if (numTokens == 3) {
+        char* end = NULL;
+        unsigned long long deadline = 0;
+
+        /* strtoull accepts a sign, and negates a negative deadline into a huge one */
+        if ((tokens[2][0] < '0') || (tokens[2][0] > '9')) return "invalid deadline";
+
+        errno = 0;
+        deadline = strtoull(tokens[2], &end, 10);
+        if ((end != tokens[2] + lengths[2]) || (errno == ERANGE)) return "invalid deadline";
+
+        /* A deadline too far off to represent is no deadline */
+        request->deadline = (deadline < NO_DEADLINE - request->arrival) ? request->arrival + deadline : NO_DEADLINE;
+    }
+
+    request->gridOrder = RequestOrder(gridLength);
+    if (request->gridOrder == 0) return "unsupported grid size";
+
+    for (cell = 0; cell < gridLength; ++cell) {
+        const int value = CharValue(grid[cell]);
+
+        if ((value < 0) || (value > (int)request->gridOrder)) return "invalid square value";
+    }
+
+    memcpy(request->grid, grid, gridLength);
+    request->groupDeadline = request->deadline;
+    return NULL;
+}
+
+/*
+** Sets every square of pzl from a request's grid, so nothing is left of the
+** last request solved with it.
+*/
+static void ResetPuzzle(SudokuPuzzle* pzl, const char* grid)
+{
+    const unsigned int gridOrder = GetGridOrder(pzl->grid);
+    GridSquare* squares = GetSquares(pzl->grid);
+    unsigned int cell = 0;
+
+    for (cell = 0; cell < gridOrder * gridOrder; ++cell) {
+        const int value = CharValue(grid[cell]);
+
+        squares[cell].value = (SquareValue)value;
+        if (value == VALUE_NONE) {
+            DomSetFull(&squares[cell].domain);
+        }
+        else {
+            DomSetEmpty(&squares[cell].domain);
+            DomAddElement(&squares[cell].domain, value);
+        }
+    }
+}
+
+/*
+** Returns true if a response status carries the puzzle's grid.
+*/
+static bool HasGrid(const char* status)
+{
+    return (strcmp(status, "solved") == 0) || (strcmp(status, "unsolved") == 0);
+}
+
+/*
+** Writes a response line, without a line feed, for a request: its tag, the
+** status, the grid if the status carries one, and the microseconds since the
+** request was read.
+*/
+static void FormatResponse(char* response, const ServiceRequest* request, const char* status, const char* grid)
+{
+    const char* separator = (request->tag[0] != '\0') ? " " : "";
+    const unsigned long elapsed = (unsigned long)(NowMicroseconds() - request->arrival);
+
+    if (HasGrid(status)) sprintf(response, "%s%s%s %s %lu", request->tag, separator, status, grid, elapsed);
+    else sprintf(response, "%s%s%s %lu", request->tag, separator, status, elapsed);
+}
+
+/*****************************************************************************/
+/* Deadline timer                                                            */
+/*****************************************************************************/
+
+static int RunDeadlineTimer(void* arg)
+{
+    DeadlineTimer* timer = (DeadlineTimer*)arg;
+
+    mtx_lock(&timer->lock);
+
+    while (!timer->stop) {
+        if (timer->deadline == NO_DEADLINE) {
+            cnd_wait(&timer->changed, &timer->lock);
+        }
+        else if (NowMicroseconds() >= timer->deadline) {
+            atomic_store(&timer->cancel, true);
+            timer->deadline = NO_DEADLINE;
+        }
+        else {
+            struct timespec until;
+
+            until.tv_sec = (time_t)(timer->deadline / 1000000u);
+            until.tv_nsec = (long)(timer->deadline % 1000000u) * 1000;
+            cnd_timedwait(&timer->changed, &timer->lock, &until);
+        }
+    }
+
+    mtx_unlock(&timer->lock);
+    return 0;
+}
+
+/*
+** Creates a disarmed timer and starts its thread. Returns NULL if it can't be
+** created.
+*/
+static DeadlineTimer* CreateDeadlineTimer(void)
+{
+    DeadlineTimer* timer = (DeadlineTimer*)malloc(sizeof(DeadlineTimer));
+
+    if (timer == NULL) return NULL;
+
+    timer->deadline = NO_DEADLINE;
+    timer->stop = false;
+    atomic_init(&timer->cancel, false);
+
+    if (mtx_init(&timer->lock, mtx_plain) != thrd_success) {
+        free(timer);
+        return NULL;
+    }
+
+    if (cnd_init(&timer->changed) != thrd_success) {
+        mtx_destroy(&timer->lock);
+        free(timer);
+        return NULL;
+    }
+
+    if (thrd_create(&timer->thread, RunDeadlineTimer, timer) != thrd_success) {
+        cnd_destroy(&timer->changed);
+        mtx_destroy(&timer->lock);
+        free(timer);
+        return NULL;
+    }
+
+    return timer;
+}
+
+static void DestroyDeadlineTimer(DeadlineTimer** timer)
+{
+    if ((timer != NULL) && (*timer != NULL)) {
+        mtx_lock(&(*timer)->lock);
+        (*timer)->stop = true;
+        cnd_signal(&(*timer)->changed);
+        mtx_unlock(&(*timer)->lock);
+
+        thrd_join((*timer)->thread, NULL);
+        cnd_destroy(&(*timer)->changed);
+        mtx_destroy(&(*timer)->lock);
+        free(*timer);
+
+        *timer = NULL;
+    }
+}
+
+/*
+** Clears the timer's cancel flag, and has it set once deadline passes. A
+** deadline of NO_DEADLINE disarms the timer.
+*/
+static void ArmDeadlineTimer(DeadlineTimer* timer, const uint64_t deadline)
+{
+    mtx_lock(&timer->lock);
+    atomic_store(&timer->cancel, false);
+    timer->deadline = deadline;
+    cnd_signal(&timer->changed);
+    mtx_unlock(&timer->lock);
+}
+
+/*****************************************************************************/
+/* Solver contexts                                                           */
+/*****************************************************************************/
+
+/*
+** Returns the context's puzzle of gridOrder, creating it if needed. Returns
+** NULL if it can't be created.
+*/
+static SudokuPuzzle* GetContextPuzzle(SolverContext* ctx, const unsigned int gridOrder)
+{
+    const unsigned int boxOrder = GetSudokuBoxOrder(gridOrder);
+
+    assert(boxOrder != 0);
+
+    if (ctx->puzzles[boxOrder] == NULL) CreateSudokuOfOrder(&ctx->puzzles[boxOrder], gridOrder);
+
+    return ctx->puzzles[boxOrder];
+}
+
+bool CreateSolverContext(SolverContext** ctx, SolverFunction solver)
+{
+    SolverContext* newContext = NULL;
+    unsigned int boxOrder = 0;
+
+    assert((ctx != NULL) && (solver != NULL));
+
+    newContext = (SolverContext*)malloc(sizeof(SolverContext));
+    if (newContext == NULL) return false;
+
+    newContext->solver = solver;
+    for (boxOrder = 0; boxOrder <= MAX_SUDOKU_BOX_ORDER; ++boxOrder) newContext->puzzles[boxOrder] = NULL;
+
+    newContext->store = NULL;
+    newContext->storePath = NULL;
+    newContext->storeWritable = false;
+    newContext->numUnstored = 0;
+    newContext->timer = NULL;
+
+    if (!CreateSolutionCache(&newContext->cache, SOLUTION_CACHE_SIZE)) {
+        free(newContext);
+        return false;
+    }
+
+    if (GetContextPuzzle(newContext, PREWARMED_ORDER) == NULL) {
+        DestroySolverContext(&newContext);
+        return false;
+    }
+
+    *ctx = newContext;
+    return true;
+}
+
+void DestroySolverContext(SolverContext** ctx)
+{
+    if ((ctx != NULL) && (*ctx != NULL)) {
+        unsigned int boxOrder = 0;
+
+        for (boxOrder = 0; boxOrder <= MAX_SUDOKU_BOX_ORDER; ++boxOrder) DestroySudoku(&(*ctx)->puzzles[boxOrder]);
+        DestroySolutionCache(&(*ctx)->cache);
+        CloseSolutionStore(&(*ctx)->store);
+        free((*ctx)->storePath);
+        DestroyDeadlineTimer(&(*ctx)->timer);
+        free(*ctx);
+
+        *ctx = NULL;
+    }
+}
+
+bool UseSolutionStore(SolverContext* ctx, const char* path)
+{
+    assert((ctx != NULL) && (path != NULL));
+
+    CloseSolutionStore(&ctx->store);
+    free(ctx->storePath);
+
+    ctx->storePath = (char*)malloc(strlen(path) + 1);
+    if (ctx->storePath == NULL) return false;
+    strcpy(ctx->storePath, path);
+
+    ctx->storeWritable = OpenSolutionStore(&ctx->store, path, SOLUTION_STORE_SIZE, true);
+    ctx->numUnstored = 0;
+
+    return ctx->storeWritable || OpenSolutionStore(&ctx->store, path, 0, false);
+}
+
+/*
+** Stores a solution if the context's store is writable. A read-only store is
+** made writable, in place, after every STORE_RETRY_INTERVAL solutions it
+** couldn't take, in case the process writing it has closed it.
+*/
+static void StoreContextSolution(SolverContext* ctx, const uint8_t canonical[CANON_SQUARES], const uint8_t solution[CANON_SQUARES])
+{
+    if (ctx->store == NULL) return;
+
+    if (!ctx->storeWritable && (++ctx->numUnstored % STORE_RETRY_INTERVAL == 0)) {
+        ctx->storeWritable = MakeSolutionStoreWritable(ctx->store, ctx->storePath);
+    }
+
+    if (ctx->storeWritable) StoreSolution(ctx->store, canonical, solution);
+}
+
+/*****************************************************************************/
+/* Solving                                                                   */
+/*****************************************************************************/
+
+/*
+** Looks up the solution of a 9x9 request in the context's cache, and then its
+** store. A solution found in the store is added to the cache.
+**
+** Returns true and writes the solution, as request characters, to grid if
+** it's found.
+*/
+static bool FindSolution(SolverContext* ctx, const ServiceRequest* request, char* grid)
+{
+    uint8_t solution[CANON_SQUARES];
+    uint8_t values[CANON_SQUARES];
+    unsigned int cell = 0;
+
+    if (!request->canonicalFound) return false;
+
+    if (!FindCachedSolution(ctx->cache, request->canonical, solution)) {
+        if ((ctx->store == NULL) || !FindStoredSolution(ctx->store, request->canonical, solution)) return false;
+
+        CacheSolution(ctx->cache, request->canonical, solution);
+    }
+
+    InvertCanonTransform(&request->transform, solution, values);
+
+    for (cell = 0; cell < CANON_SQUARES; ++cell) grid[cell] = ValueChar(values[cell]);
+    grid[CANON_SQUARES] = '\0';
+    return true;
+}
+
+/*
+** Writes the squares of a solved puzzle to grid as request characters and, if
+** it's a 9x9 puzzle with a canonical form, caches and stores the solution.
+*/
+static void KeepSolution(SolverContext* ctx, const ServiceRequest* request, SudokuPuzzle* pzl, const bool solved, char* grid)
+{
+    const GridSquare* squares = GetSquares(pzl->grid);
+    unsigned int cell = 0;
+
+    for (cell = 0; cell < request->gridOrder * request->gridOrder; ++cell) grid[cell] = ValueChar(squares[cell].value);
+    grid[request->gridOrder * request->gridOrder] = '\0';
+
+    if (solved && request->canonicalFound) {
+        uint8_t values[CANON_SQUARES];
+        uint8_t solution[CANON_SQUARES];
+
+        for (cell = 0; cell < CANON_SQUARES; ++cell) values[cell] = (uint8_t)squares[cell].value;
+
+        ApplyCanonTransform(&request->transform, values, solution);
+        CacheSolution(ctx->cache, request->canonical, solution);
+        StoreContextSolution(ctx, request->canonical, solution);
+    }
+}
+
+/*
+** Finds the canonical form of a 9x9 request, under which its solution is
+** cached and stored.
+*/
+static void FindCanonicalForm(ServiceRequest* request)
+{
+    uint8_t values[CANON_SQUARES];
+    unsigned int cell = 0;
+
+    if (request->gridOrder != CANON_ORDER) return;
+
+    for (cell = 0; cell < CANON_SQUARES; ++cell) values[cell] = (uint8_t)CharValue(request->grid[cell]);
+
+    request->canonicalFound = GetCanonicalForm(values, request->canonical, &request->transform);
+}
+
+/*
+** Answers a request without searching if it can: from the cache or store, or
+** by the AC3Solver pre-pass. Otherwise sets the request's open squares left
+** by the pre-pass and returns NULL.
+**
+** Returns the response status, with the solution in grid if there is one.
+*/
+static const char* AnswerQuickly(SolverContext* ctx, ServiceRequest* request, char* grid)
+{
+    SudokuPuzzle* pzl = GetContextPuzzle(ctx, request->gridOrder);
+    const GridSquare* squares = NULL;
+    unsigned int cell = 0;
+
+    assert(pzl != NULL);
+
+    if (FindSolution(ctx, request, grid)) return "solved";
+
+    ResetPuzzle(pzl, request->grid);
+    if (!AC3Solver(pzl)) return "failed";
+
+    if (isSudokuComplete(pzl)) {
+        const bool solved = isSudokuValid(pzl);
+
+        KeepSolution(ctx, request, pzl, solved, grid);
+        return solved ? "solved" : "unsolved";
+    }
+
+    squares = GetSquares(pzl->grid);
+    request->openSquares = 0;
+    for (cell = 0; cell < request->gridOrder * request->gridOrder; ++cell) {
+        if (squares[cell].value == VALUE_NONE) ++request->openSquares;
+    }
+
+    return NULL;
+}
+
+/*
+** Solves a request with the context's solver. A request waiting in the queue
+** may have been solved for another request since it arrived, so the cache is
+** checked first.
+**
+** The solver is cancelled through the context's timer if deadline passes
+** first, and the request is answered "expired".
+**
+** Returns the response status, with the grid in grid if there is one.
+*/
+static const char* SolveFully(SolverContext* ctx, const ServiceRequest* request, const uint64_t deadline, char* grid)
+{
+    SudokuPuzzle* pzl = GetContextPuzzle(ctx, request->gridOrder);
+    bool success = false;
+    bool solved = false;
+    bool expired = false;
+
+    assert(pzl != NULL);
+
+    if (FindSolution(ctx, request, grid)) return "solved";
+
+    /* Without a timer the solve runs to completion, as it would with no deadline */
+    if ((deadline != NO_DEADLINE) && (ctx->timer == NULL)) ctx->timer = CreateDeadlineTimer();
+
+    ResetPuzzle(pzl, request->grid);
+
+    if ((deadline != NO_DEADLINE) && (ctx->timer != NULL)) {
+        ArmDeadlineTimer(ctx->timer, deadline);
+        pzl->cancel = &ctx->timer->cancel;
+
+        success = ctx->solver(pzl);
+
+        expired = atomic_load(&ctx->timer->cancel);
+        ArmDeadlineTimer(ctx->timer, NO_DEADLINE);
+        pzl->cancel = NULL;
+    }
+    else {
+        success = ctx->solver(pzl);
+    }
+
+    solved = success && isSudokuComplete(pzl) && isSudokuValid(pzl);
+    if (expired && !solved) return "expired";
+    if (!success) return "failed";
+
+    KeepSolution(ctx, request, pzl, solved, grid);
+    return solved ? "solved" : "unsolved";
+}
+
+void SolveRequest(SolverContext* ctx, const char* request, char* response)
+{
+    ServiceRequest parsed;
+    char grid[MAX_REQUEST_LENGTH + 1];
+    const char* status = NULL;
+
+    assert((ctx != NULL) && (request != NULL) && (response != NULL));
+
+    status = ParseRequest(request, &parsed);
+    if (status == NULL) {
+        if (GetContextPuzzle(ctx, parsed.gridOrder) == NULL) status = "out of memory";
+    }
+
+    if (status != NULL) {
+        sprintf(response, "error %s", status);
+        return;
+    }
+
+    FindCanonicalForm(&parsed);
+
+    status = AnswerQuickly(ctx, &parsed, grid);
+    if (status == NULL) status = SolveFully(ctx, &parsed, parsed.deadline, grid);
+
+    FormatResponse(response, &parsed, status, grid);
+}
+
+/*****************************************************************************/
+/* Scheduling                                                                */
+/*****************************************************************************/
+
+/*
+** Writes a response line to the request's client and flushes it.
+*/
+static void Respond(const ServiceRequest* request, const char* status, const char* grid)
+{
+    FILE* out = request->client->out;
+    char response[MAX_RESPONSE_LENGTH + 1];
+
+    FormatResponse(response, request, status, grid);
+    fputs(response, out);
+    putc('\n', out);
+    fflush(out);
+}
+
+/*
+** Returns true if two requests are for the same puzzle, up to the transforms
+** of a canonical form.
+*/
+static bool SamePuzzle(const ServiceRequest* a, const ServiceRequest* b)
+{
+    if (a->gridOrder != b->gridOrder) return false;
+    if (a->canonicalFound && b->canonicalFound) return memcmp(a->canonical, b->canonical, CANON_SQUARES) == 0;
+
+    return strcmp(a->grid, b->grid) == 0;
+}
+
+/*
+** Returns true if leader a should be solved before leader b: the earlier
+** deadline of their groups first, then fewer open squares, then the order
+** they arrived. Untagged requests are answered in the order they arrive, so
+** their difficulty isn't compared.
+*/
+static bool SolveBefore(const ServiceRequest* a, const ServiceRequest* b)
+{
+    const unsigned int aOpen = (a->tag[0] != '\0') ? a->openSquares : 0;
+    const unsigned int bOpen = (b->tag[0] != '\0') ? b->openSquares : 0;
+
+    if (a->groupDeadline != b->groupDeadline) return a->groupDeadline < b->groupDeadline;
+    if (aOpen != bOpen) return aOpen < bOpen;
+
+    return a->sequence < b->sequence;
+}
+
+/*
+** Reads a client's request and answers it if it's quick to, or adds it to the
+** queue. A tagged request for the same puzzle as a queued one joins its group
+** straight away, without the pre-pass, rather than being solved again.
+**
+** Untagged requests are answered in the order they arrive, so one is only
+** answered straight away if no other untagged request of the client is
+** waiting, and never joins a group.
+*/
+static void ReceiveRequest(SolverContext* ctx, RequestQueue* queue, ServiceClient* client, const char* line)
+{
+    ServiceRequest* request = NULL;
+    char grid[MAX_REQUEST_LENGTH + 1];
+    const char* status = NULL;
+    unsigned int index = 0;
+    bool untaggedWaiting = false;
+
+    /* Requests are read into a free queue slot, which is kept only if the request waits */
+    for (index = 0; queue->requests[index].queued; ++index) assert(index + 1 < MAX_QUEUED_REQUESTS);
+    request = &queue->requests[index];
+
+    status = ParseRequest(line, request);
+    if (status == NULL) {
+        if (GetContextPuzzle(ctx, request->gridOrder) == NULL) status = "out of memory";
+    }
+
+    if (status != NULL) {
+        fprintf(client->out, "%s%serror %s\n", request->tag, (request->tag[0] != '\0') ? " " : "", status);
+        fflush(client->out);
+        return;
+    }
+
+    request->client = client;
+
+    request->sequence = queue->numRead++;
+    FindCanonicalForm(request);
+
+    for (index = 0; (index < MAX_QUEUED_REQUESTS) && (request->tag[0] != '\0'); ++index) {
+        ServiceRequest* leader = &queue->requests[index];
+
+        if (!leader->queued || (leader->leader >= 0) || (leader->tag[0] == '\0')) continue;
+
+        if (SamePuzzle(leader, request)) {
+            request->leader = (int)index;
+            if (request->deadline < leader->groupDeadline) leader->groupDeadline = request->deadline;
+            break;
+        }
+    }
+
+    if (request->leader < 0) {
+        for (index = 0; index < MAX_QUEUED_REQUESTS; ++index) {
+            const ServiceRequest* waiting = &queue->requests[index];
+            if (waiting->queued && (waiting->client == client) && (waiting->tag[0] == '\0')) untaggedWaiting = true;
+        }
+
+        if ((request->tag[0] != '\0') || !untaggedWaiting) {
+            status = AnswerQuickly(ctx, request, grid);
+            if (status != NULL) {
+                Respond(request, status, grid);
+                return;
+            }
+        }
+    }
+
+    request->queued = true;
+    ++queue->numQueued;
+    ++client->numWaiting;
+}
+
+/*
+** Writes a response to a follower from its leader's. A 9x9 grid is mapped
+** through the leader's transform to the canonical form, and back through the
+** follower's.
+*/
+static void RespondToFollower(const ServiceRequest* leader, const ServiceRequest* follower, const char* status, const char* grid)
+{
+    char followerGrid[MAX_REQUEST_LENGTH + 1];
+
+    if (HasGrid(status) && leader->canonicalFound && follower->canonicalFound) {
+        uint8_t values[CANON_SQUARES];
+        uint8_t canonical[CANON_SQUARES];
+        unsigned int cell = 0;
+
+        for (cell = 0; cell < CANON_SQUARES; ++cell) values[cell] = (uint8_t)CharValue(grid[cell]);
+
+        ApplyCanonTransform(&leader->transform, values, canonical);
+        InvertCanonTransform(&follower->transform, canonical, values);
+
+        for (cell = 0; cell < CANON_SQUARES; ++cell) followerGrid[cell] = ValueChar(values[cell]);
+        followerGrid[CANON_SQUARES] = '\0';
+        grid = followerGrid;
+    }
+
+    Respond(follower, status, grid);
+}
+
+/*
+** Solves the first leader in the queue and answers its group. Requests whose
+** deadline has passed by the time they're answered are answered "expired".
+** The puzzle isn't solved if the whole group has expired, and the solve is
+** stopped once the last deadline of the group passes.
+*/
+static void SolveNext(SolverContext* ctx, RequestQueue* queue)
+{
+    uint64_t now = NowMicroseconds();
+    uint64_t lastDeadline = 0;
+    ServiceRequest* leader = NULL;
+    char grid[MAX_REQUEST_LENGTH + 1];
+    const char* status = "expired";
+    unsigned int index = 0;
+    int leaderIndex = -1;
+    bool waiting = false;
+
+    for (index = 0; index < MAX_QUEUED_REQUESTS; ++index) {
+        ServiceRequest* request = &queue->requests[index];
+
+        if (!request->queued || (request->leader >= 0)) continue;
+        if ((leader == NULL) || SolveBefore(request, leader)) {
+            leader = request;
+            leaderIndex = (int)index;
+        }
+    }
+
+    assert(leader != NULL);
+
+    /* Only solve if some request of the group can still be answered in time */
+    for (index = 0; index < MAX_QUEUED_REQUESTS; ++index) {
+        const ServiceRequest* request = &queue->requests[index];
+
+        if (!request->queued || ((request != leader) && (request->leader != leaderIndex)) || (request->deadline < now)) continue;
+
+        waiting = true;
+        if (request->deadline > lastDeadline) lastDeadline = request->deadline;
+    }
+
+    if (waiting) {
+        status = SolveFully(ctx, leader, lastDeadline, grid);
+        now = NowMicroseconds();
+    }
+
+    Respond(leader, (leader->deadline >= now) ? status : "expired", grid);
+
+    for (index = 0; index < MAX_QUEUED_REQUESTS; ++index) {
+        ServiceRequest* follower = &queue->requests[index];
+
+        if (!follower->queued || (follower->leader != leaderIndex)) continue;
+
+        RespondToFollower(leader, follower, (follower->deadline >= now) ? status : "expired", grid);
+        follower->queued = false;
+        --follower->client->numWaiting;
+        --queue->numQueued;
+    }
+
+    leader->queued = false;
+    --leader->client->numWaiting;
+    --queue->numQueued;
+}
+
+/*****************************************************************************/
+/* Serving                                                                   */
+/*****************************************************************************/
+
+/*
+** Reads more input into the reader's buffer. If wait is false, only input that
+** has already arrived is read.
+**
+** Returns true if anything was read.
+*/
+static bool FillReader(LineReader* reader, const bool wait)
+{
+    size_t space = 0;
+
+    if (reader->ended) return false;
+
+    /* Move the unread input to the start of the buffer */
+    memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+    reader->end -= reader->start;
+    reader->start = 0;
+
+    space = READ_BUFFER_SIZE - reader->end;
+    if (space == 0) return false;
+
+#ifndef _WIN32
+    {
+        struct pollfd input;
+        ssize_t numRead = 0;
+
+        input.fd = fileno(reader->file);
+        input.events = POLLIN;
+        input.revents = 0;
+
+        if (!wait && (poll(&input, 1, 0) <= 0)) return false;
+
+        do {
+            numRead = read(input.fd, reader->buffer + reader->end, space);
+        } while ((numRead < 0) && (errno == EINTR));
+
+        if (numRead <= 0) {
+            reader->ended = true;
+            return false;
+        }
+
+        reader->end += (size_t)numRead;
+        return true;
+    }
+#else
+    /* Without poll, only wait for one line at a time */
+    if (!wait) return false;
+
+    if (fgets(reader->buffer + reader->end, (int)space, reader->file) == NULL) {
+        reader->ended = true;
+        return false;
+    }
+
+    reader->end += strlen(reader->buffer + reader->end);
+    return true;
+#endif
+}
+
+/*
+** Takes the next whole line from the reader's buffer, without its line feed.
+** A line too long for the buffer is discarded and reported as tooLong. The
+** last line of the input needn't end with a line feed.
+**
+** Returns false if the buffer holds no whole line.
+*/
+static bool NextLine(LineReader* reader, char* line, bool* tooLong)
+{
+    char* lineEnd = memchr(reader->buffer + reader->start, '\n', reader->end - reader->start);
+    size_t length = 0;
+
+    *tooLong = false;
+
+    if (lineEnd == NULL) {
+        /* A full buffer without a line feed holds part of an overlong line */
+        if ((reader->start == 0) && (reader->end == READ_BUFFER_SIZE)) {
+            reader->skipping = true;
+            reader->start = reader->end = 0;
+            return false;
+        }
+
+        if (!reader->ended || (reader->start == reader->end)) return false;
+        lineEnd = reader->buffer + reader->end;
+    }
+
+    length = (size_t)(lineEnd - (reader->buffer + reader->start));
+
+    if (reader->skipping || (length > MAX_REQUEST_LENGTH + MAX_TAG_LENGTH + 32)) {
+        *tooLong = true;
+        reader->skipping = false;
+        line[0] = '\0';
+    }
+    else {
+        memcpy(line, reader->buffer + reader->start, length);
+        line[length] = '\0';
+        line[strcspn(line, "\r")] = '\0';
+    }
+
+    reader->start = (lineEnd < reader->buffer + reader->end) ? (size_t)(lineEnd - reader->buffer) + 1 : reader->end;
+    return true;
+}
+
+/*
+** Takes the whole request lines a client has sent, while the queue has room.
+** Sets quit on a "quit" request, and takes no lines after it.
+*/
+static void TakeRequests(SolverContext* ctx, RequestQueue* queue, ServiceClient* client, bool* quit)
+{
+    char line[READ_BUFFER_SIZE + 1];
+    bool tooLong = false;
+
+    while (!*quit && (queue->numQueued < MAX_QUEUED_REQUESTS) && NextLine(&client->reader, line, &tooLong)) {
+        if (tooLong) {
+            fputs("error request too long\n", client->out);
+            fflush(client->out);
+        }
+        else if (strcmp(line, QUIT_REQUEST) == 0) *quit = true;
+        else if ((line[strspn(line, " \t")] != '\0') && (line[0] != '#')) ReceiveRequest(ctx, queue, client, line);
+    }
+}
+
+bool ServeStream(SolverContext* ctx, FILE* in, FILE* out)
+{
+    RequestQueue* queue = NULL;
+    ServiceClient* client = NULL;
+    bool quit = false;
+
+    assert((ctx != NULL) && (in != NULL) && (out != NULL));
+
+    queue = (RequestQueue*)calloc(1, sizeof(RequestQueue));
+    client = (ServiceClient*)calloc(1, sizeof(ServiceClient));
+
+    if ((queue == NULL) || (client == NULL)) {
+        free(queue);
+        free(client);
+        return false;
+    }
+
+    client->reader.file = in;
+    client->out = out;
+
+    while (!quit || (queue->numQueued > 0)) {
+
+        /* Take every request that has arrived, waiting for more only if there's nothing to solve */
+        while (true) {
+            TakeRequests(ctx, queue, client, &quit);
+            if (quit || (queue->numQueued >= MAX_QUEUED_REQUESTS)) break;
+
+            if (!FillReader(&client->reader, queue->numQueued == 0)) {
+                /* The last line needn't end with a line feed */
+                TakeRequests(ctx, queue, client, &quit);
+                break;
+            }
+        }
+
+        if (queue->numQueued > 0) SolveNext(ctx, queue);
+        else if (client->reader.ended) break;
+    }
+
+    free(queue);
+    free(client);
+    return quit;
+}
+
+#ifndef _WIN32
+
+/*
+** Accepts a connection into a free client slot. The connection is closed if
+** there's no free slot or its streams can't be opened.
+**
+** Returns false if the listener has stopped accepting connections.
+*/
+static bool AcceptClient(const int listener, ServiceClient** clients)
+{
+    const int connection = accept(listener, NULL, NULL);
+    ServiceClient* client = NULL;
+    unsigned int slot = 0;
+    int outConnection = -1;
+
+    if (connection < 0) return (errno == EINTR) || (errno == ECONNABORTED) || (errno == EAGAIN);
+
+    while ((slot < MAX_SERVICE_CLIENTS) && (clients[slot] != NULL)) ++slot;
+    if (slot < MAX_SERVICE_CLIENTS) client = (ServiceClient*)calloc(1, sizeof(ServiceClient));
+
+    /* Separate streams for reading and writing, each closing its own descriptor */
+    if (client != NULL) outConnection = dup(connection);
+    if (outConnection >= 0) client->out = fdopen(outConnection, "w");
+    if ((client != NULL) && (client->out != NULL)) client->reader.file = fdopen(connection, "r");
+
+    if ((client == NULL) || (client->reader.file == NULL)) {
+        close(connection);
+        if (client != NULL) {
+            if (client->out != NULL) fclose(client->out);
+            else if (outConnection >= 0) close(outConnection);
+        }
+
+        free(client);
+        return true;
+    }
+
+    clients[slot] = client;
+    return true;
+}
+
+static void CloseClient(ServiceClient** client)
+{
+    fclose((*client)->reader.file);
+    fclose((*client)->out);
+    free(*client);
+    *client = NULL;
+}
+
+bool ServeSocket(SolverContext* ctx, const char* path)
+{
+    struct sockaddr_un address;
+    ServiceClient* clients[MAX_SERVICE_CLIENTS] = { NULL };
+    RequestQueue* queue = NULL;
+    bool listening = true;
+    bool quit = false;
+    unsigned int index = 0;
+    int listener = -1;
+
+    assert((ctx != NULL) && (path != NULL));
+
+    if (strlen(path) >= sizeof(address.sun_path)) return false;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    queue = (RequestQueue*)calloc(1, sizeof(RequestQueue));
+    if (queue == NULL) return false;
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        free(queue);
+        return false;
+    }
+
+    unlink(path);
+    if ((bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0) || (listen(listener, SERVICE_BACKLOG) != 0)) {
+        close(listener);
+        free(queue);
+        return false;
+    }
+
+    /* A client closing early must not end the service */
+    signal(SIGPIPE, SIG_IGN);
+
+    while ((listening && !quit) || (queue->numQueued > 0)) {
+        struct pollfd fds[MAX_SERVICE_CLIENTS + 1];
+        ServiceClient* polled[MAX_SERVICE_CLIENTS + 1];
+        nfds_t numFds = 0;
+        unsigned int numClients = 0;
+
+        for (index = 0; index < MAX_SERVICE_CLIENTS; ++index) {
+            ServiceClient* client = clients[index];
+
+            if (client == NULL) continue;
+
+            /* Requests left in the buffer when the queue was full */
+            TakeRequests(ctx, queue, client, &quit);
+
+            /* A disconnected client is closed once its requests are answered */
+            if (client->reader.ended && (client->numWaiting == 0)) {
+                CloseClient(&clients[index]);
+                continue;
+            }
+
+            ++numClients;
+            if (client->reader.ended || quit) continue;
+
+            fds[numFds].fd = fileno(client->reader.file);
+            fds[numFds].events = POLLIN;
+            fds[numFds].revents = 0;
+            polled[numFds++] = client;
+        }
+
+        if (listening && !quit && (numClients < MAX_SERVICE_CLIENTS)) {
+            fds[numFds].fd = listener;
+            fds[numFds].events = POLLIN;
+            fds[numFds].revents = 0;
+            polled[numFds++] = NULL;
+        }
+
+        /* Take every request that has arrived from any client, waiting for more only if there's nothing to solve */
+        if ((numFds > 0) && (queue->numQueued < MAX_QUEUED_REQUESTS) && (poll(fds, numFds, (queue->numQueued > 0) ? 0 : -1) > 0)) {
+            for (index = 0; index < numFds; ++index) {
+                ServiceClient* client = polled[index];
+
+                if (fds[index].revents == 0) continue;
+
+                if (client == NULL) {
+                    listening = AcceptClient(listener, clients);
+                    continue;
+                }
+
+                FillReader(&client->reader, true);
+                TakeRequests(ctx, queue, client, &quit);
+            }
+        }
+        else if ((numFds == 0) && (queue->numQueued == 0)) {
+            break;
+        }
+
+        if (queue->numQueued > 0) SolveNext(ctx, queue);
+    }
+
+    for (index = 0; index < MAX_SERVICE_CLIENTS; ++index) {
+        if (clients[index] != NULL) CloseClient(&clients[index]);
+    }
+
+    close(listener);
+    unlink(path);
+    free(queue);
+    return quit;
+}
+
+#else
+
+bool ServeSocket(SolverContext* ctx, const char* path)
+{
+    printf("ERROR: Unix domain sockets aren't supported on this platform\n");
+    return false;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,200 @@
+/*
+** SudokuService.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef SUDOKU_SERVICE_H
+#define SUDOKU_SERVICE_H
+
+#include "SolutionCache.h"
+#include "SolutionStore.h"
+#include "SudokuConstraints.h"
+#include "SudokuSolver.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+** A long-running solver reading one puzzle per line and writing one response
+** per line, so a caller pays process startup and puzzle creation once rather
+** than for every puzzle.
+**
+** A request is a line holding the grid row-wise, one character per square:
+** '1' to '9' and then 'A' to 'Z' (or 'a' to 'z') for values 10 and up, and
+** '.' or '0' for a blank square. The grid order is the square root of the
+** number of characters, so 4x4, 9x9, 16x16 and 25x25 grids are accepted.
+** Empty lines and lines starting with '#' are ignored, and "quit" ends the
+** service once the requests before it are answered.
+**
+** The grid may be preceded by a tag of up to MAX_TAG_LENGTH characters and
+** followed by a deadline in microseconds, separated by spaces:
+**
+**  <grid>
+**  <tag> <grid>
+**  <tag> <grid> <deadline>
+**
+** Untagged requests are answered in the order they arrive. Tagged requests
+** are answered in any order, their responses starting with the tag, so the
+** service is free to schedule them:
+**
+**  - Requests answered from the solution cache or store, or solved by an
+**    AC3Solver pre-pass, are answered as soon as they're read.
+**
+**  - Requests for the same puzzle, or a transform of it, waiting at once are
+**    solved once for them all.
+**
+**  - Other requests are solved earliest deadline first, then those with the
+**    fewest squares left open by the pre-pass first, so easy requests aren't
+**    held up behind hard ones.
+**
+** Each response is one line, where the microseconds are the time from reading
+** the request to answering it:
+**
+**  - "solved <grid> <microseconds>" - The solution, in the request format.
+**
+**  - "unsolved <grid> <microseconds>" - The solver ran to completion without
+**    solving the puzzle. The grid holds the values it found.
+**
+**  - "failed <microseconds>" - The solver found the puzzle has no solution.
+**
+**  - "expired <microseconds>" - The deadline passed before the request was
+**    solved. A solve still running when the deadline passes is stopped.
+**
+**  - "error <reason>" - The request couldn't be read.
+*/
+
+enum {
+    MAX_REQUEST_ORDER = 25,
+    MAX_REQUEST_LENGTH = MAX_REQUEST_ORDER * MAX_REQUEST_ORDER,
+    MAX_TAG_LENGTH = 64,
+    MAX_RESPONSE_LENGTH = MAX_TAG_LENGTH + MAX_REQUEST_LENGTH + 64,
+    MAX_SERVICE_CLIENTS = 32,
+    SOLUTION_CACHE_SIZE = 4096,
+    SOLUTION_STORE_SIZE = 1 << 18,
+    STORE_RETRY_INTERVAL = 64
+};
+
+/*
+** Per-worker solver state. A puzzle of each grid order is created the first
+** time that order is requested and reset for every later request, so a
+** request makes no puzzle or grid allocations of its own. Each worker needs
+** its own context.
+**
+** Solutions of 9x9 puzzles are kept in a cache of SOLUTION_CACHE_SIZE entries
+** keyed by canonical form, so a puzzle repeated or transformed from one
+** already solved isn't solved again. A context may also use a persistent
+** store shared with other processes; see UseSolutionStore.
+**
+**  storePath - Path of the store, or NULL.
+**
+**  storeWritable - True if the store is open for writing.
+**
+**  numUnstored - Solutions not stored since the store was opened read-only.
+**
+**  timer - Cancels a solve when its deadline passes. Created for the first
+**          request with a deadline.
+*/
+struct _DeadlineTimerType;
+
+typedef struct {
+    SolverFunction solver;
+    SudokuPuzzle* puzzles[MAX_SUDOKU_BOX_ORDER + 1];
+    SolutionCache cache;
+    SolutionStore store;
+    char* storePath;
+    bool storeWritable;
+    unsigned int numUnstored;
+    struct _DeadlineTimerType* timer;
+} SolverContext;
+
+/*
+** Creates a context solving requests with solver. The 9x9 puzzle is created
+** straight away, so the first 9x9 request pays no setup.
+**
+** If successful, the ctx parameter is updated to point to the newly created
+** context and true is returned.
+**
+** If unsuccessful, the ctx parameter is not modified and false is returned.
+*/
+bool CreateSolverContext(SolverContext** ctx, SolverFunction solver);
+
+/*
+** Destroys the context and its puzzles.
+*/
+void DestroySolverContext(SolverContext** ctx);
+
+/*
+** Looks up 9x9 solutions missing from the context's cache in the store at path,
+** and adds new solutions to it. The store is created, holding up to
+** SOLUTION_STORE_SIZE solutions, if it doesn't exist.
+**
+** Only one process writes a store. If another process is writing it, the
+** store is opened read-only and storeWritable is cleared, so the caller can
+** report it. Opening the store for writing is retried after every
+** STORE_RETRY_INTERVAL solutions that couldn't be stored, so the context
+** takes over writing once the other process closes the store.
+**
+** Returns false if the store can't be opened.
+*/
+bool UseSolutionStore(SolverContext* ctx, const char* path);
+
+/*
+** Solves one request, without its line feed, straight away and writes the
+** response, without a line feed, to response. response must have room for
+** MAX_RESPONSE_LENGTH characters and the terminating null.
+*/
+void SolveRequest(SolverContext* ctx, const char* request, char* response);
+
+/*
+** Answers each request read from in by writing its response to out, until
+** in ends or a "quit" request. Every request that has arrived is read before
+** the next is solved, so waiting requests can be scheduled as above.
+** Responses are flushed as they are written.
+**
+** Returns true if the service was ended by "quit".
+*/
+bool ServeStream(SolverContext* ctx, FILE* in, FILE* out);
+
+/*
+** Listens on a Unix domain socket at path, replacing any socket already there,
+** and serves connections as ServeStream until a connection sends "quit". The
+** socket is removed when the service ends.
+**
+** Up to MAX_SERVICE_CLIENTS connections are served at once. Requests from
+** every connection wait in one queue, so they're scheduled together as above,
+** and each response is written to the connection its request came from.
+** Untagged requests are answered in the order each connection sent them.
+**
+** Returns true if the service was ended by "quit". Returns false if the
+** socket can't be created or stops accepting connections, or on platforms
+** without Unix domain sockets.
+*/
+bool ServeSocket(SolverContext* ctx, const char* path);
+
+#endif // !SUDOKU_SERVICE_H
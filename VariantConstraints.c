@@ -0,0 +1,258 @@
+/*
+** VariantConstraints.c
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#include "VariantConstraints.h"
+#include "SudokuConstraints.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+/*
+** Squares attacked by each neighbour rule, as row and column offsets.
+** Orthogonal king moves stay in a row or column, so only the diagonal ones
+** are listed.
+*/
+static const struct {
+    unsigned int variant;
+    int row;
+    int col;
+} variantMoves[] = {
+    { VARIANT_ANTI_KING,   -1, -1 }, { VARIANT_ANTI_KING,   -1,  1 },
+    { VARIANT_ANTI_KING,    1, -1 }, { VARIANT_ANTI_KING,    1,  1 },
+    { VARIANT_ANTI_KNIGHT, -2, -1 }, { VARIANT_ANTI_KNIGHT, -2,  1 },
+    { VARIANT_ANTI_KNIGHT, -1, -2 }, { VARIANT_ANTI_KNIGHT, -1,  2 },
+    { VARIANT_ANTI_KNIGHT,  1, -2 }, { VARIANT_ANTI_KNIGHT,  1,  2 },
+    { VARIANT_ANTI_KNIGHT,  2, -1 }, { VARIANT_ANTI_KNIGHT,  2,  1 }
+};
+
+#define NUM_VARIANT_MOVES (sizeof(variantMoves) / sizeof(variantMoves[0]))
+
+/*
+** Adds a unique value constraint of regionSize squares to list, taking its
+** locations from storage. Returns the locations to fill.
+*/
+static GridLocation* AddVariantRegion(ConstraintList* list, GridLocation** storage, const unsigned int regionSize)
+{
+    Constraint* constraint = &list->constraints[list->numConstraints++];
+
+    constraint->region.locations = *storage;
+    constraint->region.regionSize = regionSize;
+    constraint->region.cells = NULL;
+    constraint->region.rowMask = 0;
+    constraint->region.colMask = 0;
+    constraint->funcs = GetUniqueValueFuncs();
+    constraint->target = 0;
+
+    *storage += regionSize;
+    return constraint->region.locations;
+}
+
+/*
+** Adds both main diagonals to list.
+*/
+static void AddDiagonals(ConstraintList* list, GridLocation** storage, const unsigned int gridOrder)
+{
+    GridLocation* leading = AddVariantRegion(list, storage, gridOrder);
+    GridLocation* trailing = AddVariantRegion(list, storage, gridOrder);
+    unsigned int position = 0;
+
+    for (position = 0; position < gridOrder; ++position) {
+        leading[position].row = position;
+        leading[position].col = position;
+        trailing[position].row = position;
+        trailing[position].col = gridOrder - 1 - position;
+    }
+}
+
+/*
+** Adds the windoku windows to list, left to right and top to bottom. Windows
+** are boxes offset by one square, with one line between neighbouring windows.
+*/
+static void AddWindows(ConstraintList* list, GridLocation** storage, const unsigned int boxOrder)
+{
+    const unsigned int gridOrder = boxOrder * boxOrder;
+    unsigned int window = 0;
+
+    for (window = 0; window < (boxOrder - 1) * (boxOrder - 1); ++window) {
+        const unsigned int top = 1 + (window / (boxOrder - 1)) * (boxOrder + 1);
+        const unsigned int left = 1 + (window % (boxOrder - 1)) * (boxOrder + 1);
+        GridLocation* locations = AddVariantRegion(list, storage, gridOrder);
+        unsigned int position = 0;
+
+        for (position = 0; position < gridOrder; ++position) {
+            locations[position].row = top + position / boxOrder;
+            locations[position].col = left + position % boxOrder;
+        }
+    }
+}
+
+/*
+** Returns true if cell b is a compiled peer of cell a in list.
+*/
+static bool IsPeer(const ConstraintList* list, const CellIndex a, const CellIndex b)
+{
+    unsigned int low = list->peerStart[a];
+    unsigned int high = list->peerStart[a + 1];
+
+    while (low < high) {
+        const unsigned int middle = low + (high - low) / 2;
+
+        if (list->peers[middle] == b) return true;
+
+        if (list->peers[middle] < b) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return false;
+}
+
+/*
+** Fills the neighbour table of each square from the moves of the variant
+** rules. Squares already sharing a region of base are left out, as the
+** regions keep them apart.
+*/
+static void AddNeighbours(unsigned int* neighbourStart, CellIndex* neighbours, const ConstraintList* base, const unsigned int gridOrder,
+    const unsigned int variants)
+{
+    const unsigned int numSquares = gridOrder * gridOrder;
+    unsigned int numNeighbours = 0;
+    unsigned int cell = 0;
+
+    for (cell = 0; cell < numSquares; ++cell) {
+        const int row = (int)(cell / gridOrder);
+        const int col = (int)(cell % gridOrder);
+        unsigned int move = 0;
+
+        neighbourStart[cell] = numNeighbours;
+
+        for (move = 0; move < NUM_VARIANT_MOVES; ++move) {
+            const int neighbourRow = row + variantMoves[move].row;
+            const int neighbourCol = col + variantMoves[move].col;
+            CellIndex neighbour = 0;
+
+            if (!(variants & variantMoves[move].variant)) continue;
+            if ((neighbourRow < 0) || (neighbourRow >= (int)gridOrder) || (neighbourCol < 0) || (neighbourCol >= (int)gridOrder)) continue;
+
+            neighbour = (CellIndex)(neighbourRow * gridOrder + neighbourCol);
+            if (!IsPeer(base, (CellIndex)cell, neighbour)) neighbours[numNeighbours++] = neighbour;
+        }
+    }
+
+    neighbourStart[numSquares] = numNeighbours;
+}
+
+bool CreateVariantConstraints(ConstraintList** list, const ConstraintList* base, const unsigned int gridOrder, const unsigned int variants)
+{
+    const unsigned int numSquares = gridOrder * gridOrder;
+    const unsigned int boxOrder = GetSudokuBoxOrder(gridOrder);
+    ConstraintList* newList = NULL;
+    GridLocation* storage = NULL;
+    unsigned int* neighbourStart = NULL;
+    unsigned int numConstraints = 0;
+    unsigned int numLocations = 0;
+    unsigned int numMoves = 0;
+    unsigned int index = 0;
+
+    assert((list != NULL) && (base != NULL));
+    assert((base->peers != NULL) && (base->gridOrder == gridOrder));
+
+    if (base->neighbours != NULL) return false;
+    if ((variants & VARIANT_WINDOKU) && (boxOrder == 0)) return false;
+
+    numConstraints = base->numConstraints;
+    if (variants & VARIANT_DIAGONAL) numConstraints += 2;
+    if (variants & VARIANT_WINDOKU) numConstraints += (boxOrder - 1) * (boxOrder - 1);
+
+    numLocations = (numConstraints - base->numConstraints) * gridOrder;
+    for (index = 0; index < base->numConstraints; ++index) {
+        numLocations += base->constraints[index].region.regionSize;
+    }
+
+    for (index = 0; index < NUM_VARIANT_MOVES; ++index) {
+        if (variants & variantMoves[index].variant) ++numMoves;
+    }
+
+    /* The list, its constraints, their locations and the neighbour table share one allocation */
+    newList = (ConstraintList*)malloc(sizeof(ConstraintList) + numConstraints * sizeof(Constraint) + numLocations * sizeof(GridLocation)
+        + (numSquares + 1) * sizeof(unsigned int) + numSquares * numMoves * sizeof(CellIndex));
+    if (newList == NULL) return false;
+
+    newList->constraints = (Constraint*)(newList + 1);
+    newList->numConstraints = 0;
+    newList->neighbourStart = NULL;
+    newList->neighbours = NULL;
+    newList->cells = NULL;
+    newList->gridOrder = 0;
+    newList->regionStart = NULL;
+    newList->regionIndices = NULL;
+    newList->peerStart = NULL;
+    newList->peers = NULL;
+    storage = (GridLocation*)(newList->constraints + numConstraints);
+    neighbourStart = (unsigned int*)(storage + numLocations);
+
+    /* Base constraints keep their order, so rows, columns and boxes stay first */
+    for (index = 0; index < base->numConstraints; ++index) {
+        const Constraint* constraint = &base->constraints[index];
+        GridLocation* locations = AddVariantRegion(newList, &storage, constraint->region.regionSize);
+        unsigned int position = 0;
+
+        for (position = 0; position < constraint->region.regionSize; ++position) {
+            locations[position] = constraint->region.locations[position];
+        }
+
+        newList->constraints[index].funcs = constraint->funcs;
+        newList->constraints[index].target = constraint->target;
+    }
+
+    if (variants & VARIANT_DIAGONAL) AddDiagonals(newList, &storage, gridOrder);
+    if (variants & VARIANT_WINDOKU) AddWindows(newList, &storage, boxOrder);
+
+    assert(newList->numConstraints == numConstraints);
+
+    if (numMoves > 0) {
+        CellIndex* neighbours = (CellIndex*)(neighbourStart + numSquares + 1);
+
+        AddNeighbours(neighbourStart, neighbours, base, gridOrder, variants);
+        newList->neighbourStart = neighbourStart;
+        newList->neighbours = neighbours;
+    }
+
+    if (!CompileConstraints(newList, gridOrder)) {
+        free(newList);
+        return false;
+    }
+
+    *list = newList;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+** VariantConstraints.h
+** Chris Fletcher
+**
+** This is free and unencumbered software released into the public domain.
+**
+** Anyone is free to copy, modify, publish, use, compile, sell, or
+** distribute this software, either in source code form or as a compiled
+** binary, for any purpose, commercial or non-commercial, and by any
+** means.
+**
+** In jurisdictions that recognize copyright laws, the author or authors
+** of this software dedicate any and all copyright interest in the
+** software to the public domain. We make this dedication for the benefit
+** of the public at large and to the detriment of our heirs and
+** successors. We intend this dedication to be an overt act of
+** relinquishment in perpetuity of all present and future rights to this
+** software under copyright law.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+** MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+** OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+** ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+** OTHER DEALINGS IN THE SOFTWARE.
+**
+** For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef VARIANT_CONSTRAINTS_H
+#define VARIANT_CONSTRAINTS_H
+
+#include "Constraint.h"
+
+/*
+** Variant Sudoku adds rules to a puzzle's unique value constraints. Rules are
+** flags and may be combined:
+**
+**  VARIANT_DIAGONAL - X-Sudoku. Both main diagonals hold every value once.
+**
+**  VARIANT_WINDOKU - Windoku. Extra boxes, placed one square in from the edges
+**                    and one square apart, hold every value once. A 9x9 grid
+**                    has four.
+**
+**  VARIANT_ANTI_KING - Squares a king's move apart hold different values.
+**
+**  VARIANT_ANTI_KNIGHT - Squares a knight's move apart hold different values.
+**
+** Diagonals and windows are added as regions, so every region propagator uses
+** them. Anti-king and anti-knight squares are added as neighbours: a table of
+** the squares each square attacks, built once when the list is created. The
+** compiled peers include them, so arc consistency and the chain searches
+** apply them with the same mask operations as the regions.
+*/
+enum {
+    VARIANT_DIAGONAL = 0x1,
+    VARIANT_WINDOKU = 0x2,
+    VARIANT_ANTI_KING = 0x4,
+    VARIANT_ANTI_KNIGHT = 0x8
+};
+
+/*
+** Creates a compiled list holding the constraints of base, which must be
+** compiled for gridOrder, and the variant rules. Base isn't modified, and the
+** list doesn't refer to it. See DestroyConstraintList.
+**
+** Every rule of a puzzle is added at once: base's neighbour table isn't
+** copied, so base mustn't have one.
+**
+** Returns false and leaves list unmodified if base has neighbours, windoku is
+** requested for a grid order that isn't the square of a box order, or memory
+** can't be allocated.
+*/
+bool CreateVariantConstraints(ConstraintList** list, const ConstraintList* base, const unsigned int gridOrder, const unsigned int variants);
+
+#endif // !VARIANT_CONSTRAINTS_H
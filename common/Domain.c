@@ -31,72 +31,139 @@
 #include "Domain.h"
 
 #include <assert.h>
+#include <stddef.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* Word and bit holding the element at a bit index */
+#define WORD_INDEX(bit) ((bit) / DOM_WORD_BITS)
+#define WORD_MASK(bit) ((DomWord)0x1 << ((bit) % DOM_WORD_BITS))
+
+/*
+** Returns the number of words used by a domain of numElements. Builds with
+** single word domains never need more than one.
+*/
+static unsigned int NumWords(const DomElementValue numElements)
+{
+    return (DOM_MAX_WORDS == 1) ? 1 : (numElements + DOM_WORD_BITS - 1) / DOM_WORD_BITS;
+}
+
+/*
+** Returns the index of the least significant set bit. word must not be 0.
+*/
+static unsigned int LSBitIndex(const DomWord word)
+{
+    assert(word != 0);
+
+#if defined(_MSC_VER)
+    {
+        unsigned long index = 0;
+#if DOM_WORD_BITS == 64
+        _BitScanForward64(&index, word);
+#else
+        _BitScanForward(&index, word);
+#endif
+        return (unsigned int)index;
+    }
+#elif defined(__GNUC__) && (DOM_WORD_BITS == 64)
+    return (unsigned int)__builtin_ctzll(word);
+#elif defined(__GNUC__)
+    return (unsigned int)__builtin_ctz(word);
+#else
+    {
+        unsigned int index = 0;
+        while (!(word & ((DomWord)0x1 << index))) ++index;
+        return index;
+    }
+#endif
+}
+
+/*
+** Returns the number of set bits.
+*/
+static unsigned int BitCount(const DomWord word)
+{
+#if defined(_MSC_VER) && (DOM_WORD_BITS == 64)
+    return (unsigned int)__popcnt64(word);
+#elif defined(_MSC_VER)
+    return (unsigned int)__popcnt(word);
+#elif defined(__GNUC__) && (DOM_WORD_BITS == 64)
+    return (unsigned int)__builtin_popcountll(word);
+#elif defined(__GNUC__)
+    return (unsigned int)__builtin_popcount(word);
+#else
+    DomWord bits = word;
+    unsigned int count = 0;
+
+    /* Clear the least significant set bit until none remain */
+    while (bits) {
+        bits &= (bits - 1);
+        ++count;
+    }
+
+    return count;
+#endif
+}
 
 Domain DomCreate(const DomElementValue minValue, const DomElementValue numElements, const bool fullDomain)
 {
-    Domain domain = { 0 };
+    Domain domain;
 
-    assert((sizeof(DomBitField) * 8) >= numElements);
+    assert(numElements <= DOM_MAX_ELEMENTS);
     assert(numElements > 0);
 
     domain.minValue = minValue;
     domain.numElements = numElements;
 
-    if (fullDomain) {
-        DomSetFull(&domain);
-    }
-    else {
-        DomSetEmpty(&domain);
-    }
+    DomSetEmpty(&domain);
+    if (fullDomain) DomSetFull(&domain);
 
     return domain;
 }
 
 bool DomAddElement(Domain* domain, const DomElementValue element)
 {
-    DomBitField bitMask = 0;
+    unsigned int bit = 0;
 
     assert(domain != NULL);
-    assert((sizeof(DomBitField) * 8) >= domain->numElements);
     assert((element >= domain->minValue) && (element < (domain->minValue + domain->numElements)));
 
-    bitMask = 0x1 << (element - domain->minValue);
+    bit = element - domain->minValue;
 
-    if (domain->domain & bitMask) return false;    /* Element is already in the domain */
+    if (domain->words[WORD_INDEX(bit)] & WORD_MASK(bit)) return false;    /* Element is already in the domain */
 
-    domain->domain |= bitMask;
+    domain->words[WORD_INDEX(bit)] |= WORD_MASK(bit);
     return true;
 }
 
 bool DomRemoveElement(Domain* domain, const DomElementValue element)
 {
-    DomBitField bitMask = 0;
+    unsigned int bit = 0;
 
     assert(domain != NULL);
-    assert((sizeof(DomBitField) * 8) >= domain->numElements);
     assert((element >= domain->minValue) && (element < (domain->minValue + domain->numElements)));
 
-    bitMask = 0x1 << (element - domain->minValue);
+    bit = element - domain->minValue;
 
-    if (!(domain->domain & bitMask)) return false;     /* Element is not in the domain */
+    if (!(domain->words[WORD_INDEX(bit)] & WORD_MASK(bit))) return false;     /* Element is not in the domain */
 
-    domain->domain &= ~bitMask;
+    domain->words[WORD_INDEX(bit)] &= ~WORD_MASK(bit);
     return true;
 }
 
 DomElementValue DomGetLSValue(const Domain domain)
 {
-    DomElementValue elementNum = 0;
+    const unsigned int numWords = NumWords(domain.numElements);
+    unsigned int word = 0;
 
     /* Dont get values from empty domains */
     assert(!DomIsEmptyDomain(domain));
-    assert((sizeof(DomBitField) * 8) >= domain.numElements);
 
-    do {
-        if (domain.domain & (0x01 << elementNum)) return (elementNum + domain.minValue);
-    } while (++elementNum < domain.numElements);
+    while ((word < numWords - 1) && (domain.words[word] == 0)) ++word;
 
-    return 0;
+    return (word * DOM_WORD_BITS + LSBitIndex(domain.words[word]) + domain.minValue);
 }
 
 DomElementValue DomGetMSValue(const Domain domain)
@@ -105,60 +172,91 @@ DomElementValue DomGetMSValue(const Domain domain)
 
     /* Dont get values from empty domains */
     assert(!DomIsEmptyDomain(domain));
-    assert((sizeof(DomBitField) * 8) >= domain.numElements);
 
     do {
-        if (domain.domain & (0x01 << elementNum)) return (elementNum + domain.minValue);
+        if (domain.words[WORD_INDEX(elementNum)] & WORD_MASK(elementNum)) return (elementNum + domain.minValue);
     } while (elementNum-- > 0);
 
     return 0;
 }
 
+DomElementValue DomPopLSValue(Domain* domain)
+{
+    unsigned int numWords = 0;
+    DomElementValue element = 0;
+    unsigned int word = 0;
+
+    assert(domain != NULL);
+    assert(!DomIsEmptyDomain(*domain));
+
+    numWords = NumWords(domain->numElements);
+    while ((word < numWords - 1) && (domain->words[word] == 0)) ++word;
+
+    element = word * DOM_WORD_BITS + LSBitIndex(domain->words[word]);
+    domain->words[word] &= (domain->words[word] - 1);     /* Clear least significant set bit */
+
+    return (element + domain->minValue);
+}
+
 void DomSetFull(Domain* domain)
 {
+    unsigned int numWords = 0;
+    unsigned int word = 0;
+
     assert(domain != NULL);
-    assert((sizeof(DomBitField) * 8) >= domain->numElements);
+    assert(domain->numElements <= DOM_MAX_ELEMENTS);
+
+    numWords = NumWords(domain->numElements);
+    for (word = 0; word < numWords; ++word) {
+        domain->words[word] = ~(DomWord)0;
+    }
 
-    domain->domain = ~((DomBitField)(~0x0) << domain->numElements);
+    /* Clear the bits past numElements */
+    if (domain->numElements % DOM_WORD_BITS) {
+        domain->words[numWords - 1] = ~(~(DomWord)0 << (domain->numElements % DOM_WORD_BITS));
+    }
 }
 
 void DomSetEmpty(Domain* domain)
 {
+    unsigned int word = 0;
+
     assert(domain != NULL);
 
-    domain->domain = 0;
+    for (word = 0; word < DOM_MAX_WORDS; ++word) {
+        domain->words[word] = 0;
+    }
 }
 
 unsigned int DomNumElements(const Domain domain)
 {
-    DomBitField bitMask = 0x1 << (domain.numElements - 1);
-    unsigned int numElements = 0;
+    const unsigned int numWords = NumWords(domain.numElements);
+    unsigned int count = 0;
+    unsigned int word = 0;
 
-    assert((sizeof(DomBitField) * 8) >= domain.numElements);
-
-    do {
-        if (domain.domain & bitMask) ++numElements;
-    } while ((bitMask >>= 1) > 0);
+    for (word = 0; word < numWords; ++word) {
+        count += BitCount(domain.words[word]);
+    }
 
-    return numElements;
+    return count;
 }
 
 bool DomIsEmptyDomain(const Domain domain)
 {
-    const DomBitField emptyField = ((DomBitField)(~0x0) << domain.numElements);
+    const unsigned int numWords = NumWords(domain.numElements);
+    DomWord bits = 0;
+    unsigned int word = 0;
 
-    assert((sizeof(DomBitField) * 8) >= domain.numElements);
+    for (word = 0; word < numWords; ++word) {
+        bits |= domain.words[word];
+    }
 
-    return ((domain.domain | emptyField) ==  emptyField);
+    return (bits == 0);
 }
 
 bool DomIsFullDomain(const Domain domain)
 {
-    const DomBitField fullField = ~((DomBitField)(~0x0) << domain.numElements);
-
-    assert((sizeof(DomBitField) * 8) >= domain.numElements);
-
-    return ((domain.domain & fullField) ==  fullField);
+    return (DomNumElements(domain) == domain.numElements);
 }
 
 bool DomIsSingletonDomain(const Domain domain)
@@ -168,22 +266,31 @@ bool DomIsSingletonDomain(const Domain domain)
 
 bool DomContainsElement(const Domain domain, const DomElementValue element)
 {
-    const DomBitField bitMask = 0x1 << (element - domain.minValue);
+    const unsigned int bit = element - domain.minValue;
 
-    assert((sizeof(DomBitField) * 8) >= domain.numElements);
     assert((element >= domain.minValue) && (element < (domain.minValue + domain.numElements)));
 
-    return (domain.domain & bitMask);
+    return (domain.words[WORD_INDEX(bit)] & WORD_MASK(bit)) != 0;
 }
 
+/*
+** Set operations work on every word. Words past those in use are clear in
+** both domains, so they stay clear, and the fixed trip count lets the loops
+** be unrolled or vectorised.
+*/
+
 Domain DomUnion(const Domain a, const Domain b)
 {
-    Domain newDomain = { 0 };
+    Domain newDomain;
+    unsigned int word = 0;
 
     assert(a.minValue == b.minValue);
     assert(a.numElements == b.numElements);
 
-    newDomain.domain = a.domain | b.domain;
+    for (word = 0; word < DOM_MAX_WORDS; ++word) {
+        newDomain.words[word] = a.words[word] | b.words[word];
+    }
+
     newDomain.minValue = a.minValue;
     newDomain.numElements = a.numElements;
 
@@ -192,12 +299,34 @@ Domain DomUnion(const Domain a, const Domain b)
 
 Domain DomIntersection(const Domain a, const Domain b)
 {
-    Domain newDomain = { 0 };
+    Domain newDomain;
+    unsigned int word = 0;
+
+    assert(a.minValue == b.minValue);
+    assert(a.numElements == b.numElements);
+
+    for (word = 0; word < DOM_MAX_WORDS; ++word) {
+        newDomain.words[word] = a.words[word] & b.words[word];
+    }
+
+    newDomain.minValue = a.minValue;
+    newDomain.numElements = a.numElements;
+
+    return newDomain;
+}
+
+Domain DomDifference(const Domain a, const Domain b)
+{
+    Domain newDomain;
+    unsigned int word = 0;
 
     assert(a.minValue == b.minValue);
     assert(a.numElements == b.numElements);
 
-    newDomain.domain = a.domain & b.domain;
+    for (word = 0; word < DOM_MAX_WORDS; ++word) {
+        newDomain.words[word] = a.words[word] & ~b.words[word];
+    }
+
     newDomain.minValue = a.minValue;
     newDomain.numElements = a.numElements;
 
@@ -37,13 +37,45 @@
 */
 
 #include <stdbool.h>
+#include <stdint.h>
+
+/*
+** Bitfields are made of words of the target's native width: 64 bits on 64-bit
+** targets and 32 bits otherwise. Define DOM_WORD_BITS to override.
+*/
+#ifndef DOM_WORD_BITS
+#if defined(_WIN64) || defined(__LP64__) || (defined(UINTPTR_MAX) && (UINTPTR_MAX > 0xFFFFFFFFu))
+#define DOM_WORD_BITS 64
+#else
+#define DOM_WORD_BITS 32
+#endif
+#endif
+
+#if DOM_WORD_BITS == 64
+typedef uint64_t DomWord;
+#else
+typedef uint32_t DomWord;
+#endif
+
+/*
+** Most elements a domain may hold. Define DOM_MAX_ELEMENTS to build with
+** larger domains; the default covers the largest supported grid.
+*/
+#ifndef DOM_MAX_ELEMENTS
+#define DOM_MAX_ELEMENTS 64
+#endif
+
+#define DOM_MAX_WORDS ((DOM_MAX_ELEMENTS + DOM_WORD_BITS - 1) / DOM_WORD_BITS)
 
-/* The number of bits in BitField must be >= numElements */
-typedef unsigned short DomBitField;
 typedef unsigned int DomElementValue;
 
+/*
+** A domain uses the fewest words that hold numElements, chosen when it's
+** created: one word for up to DOM_WORD_BITS elements, several beyond that.
+** Words past those in use, and bits past numElements, are always clear.
+*/
 struct _DomainType {
-    DomBitField domain;
+    DomWord words[DOM_MAX_WORDS];
     DomElementValue minValue;
     DomElementValue numElements;
 };
@@ -52,7 +84,8 @@ typedef struct _DomainType Domain;
 
 /*
 ** Creates a new domain with the given values. If fullDomain is true the
-** created domain will be full; otherwise it will be empty.
+** created domain will be full; otherwise it will be empty. numElements must
+** not exceed DOM_MAX_ELEMENTS.
 */
 Domain DomCreate(const DomElementValue minValue, const DomElementValue numElements, const bool fullDomain);
 
@@ -77,6 +110,15 @@ bool DomRemoveElement(Domain* domain, const DomElementValue element);
 DomElementValue DomGetLSValue(const Domain domain);
 DomElementValue DomGetMSValue(const Domain domain);
 
+/*
+** Removes the least significant value from the domain and returns it. Calling
+** DomPopLSValue until the domain is empty iterates through each element in
+** ascending order.
+**
+** Behavior is undefined if domain is empty.
+*/
+DomElementValue DomPopLSValue(Domain* domain);
+
 /*
 ** Sets the domain to be full or empty.
 */
@@ -104,4 +146,10 @@ bool DomIsSingletonDomain(const Domain domain);
 Domain DomUnion(const Domain a, const Domain b);
 Domain DomIntersection(const Domain a, const Domain b);
 
+/*
+** Returns the elements of domain a that are not in domain b. Behavior is
+** undefined if both domains do not have the same minValue and numElements.
+*/
+Domain DomDifference(const Domain a, const Domain b);
+
 #endif // !DOMAIN_H
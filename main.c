@@ -29,16 +29,25 @@
 */
 
 #include "SudokuPuzzle.h"
+#include "KillerConstraints.h"
 #include "SudokuFile.h"
 #include "SudokuPrint.h"
+#include "SudokuService.h"
 #include "AC3Solver/AC3Solver.h"
 #include "AC3Backtrack/AC3Backtrack.h"
+#include "AdaptiveSolver/AdaptiveSolver.h"
+#include "PortfolioSolver/PortfolioSolver.h"
 #include "BacktrackSolver/BacktrackSolver.h"
+#include "Propagators/ChainPropagator.h"
+#include "Propagators/FishPropagator.h"
+#include "Propagators/SubsetPropagator.h"
+#include "SamuraiSolver/SamuraiSolver.h"
 
 #include <assert.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 typedef struct {
@@ -59,39 +68,215 @@ typedef struct {
 } SolverTest;
 
 SolverTest TEST_LIST[] = {
-    /*  SolverFunction      name                    testFile                            numTries        stats    */
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\one_star.txt",         10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\two_star.txt",         10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\three_star.txt",       10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\four_star.txt",        10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\five_star.txt",        10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\super.txt",            10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\extreme.txt",          10,             {   0   }   },
-    {   BacktrackSolver,    "BacktrackSolver",      ".\\sudokus\\blank.txt",            10,             {   0   }   },
-
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\one_star.txt",         10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\two_star.txt",         10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\three_star.txt",       10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\four_star.txt",        10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\five_star.txt",        10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\super.txt",            10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\extreme.txt",          10,             {   0   }   },
-    {   AC3Solver,          "AC3Solver",            ".\\sudokus\\blank.txt",            10,             {   0   }   },
-
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\one_star.txt",         10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\two_star.txt",         10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\three_star.txt",       10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\four_star.txt",        10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\five_star.txt",        10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\super.txt",            10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\extreme.txt",          10,             {   0   }   },
-    {   AC3BacktrackSolver, "AC3Backtrack",         ".\\sudokus\\blank.txt",            10,             {   0   }   },
+    /*  SolverFunction                  name                    testFile                            numTries        stats    */
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   BacktrackSolver,                "BacktrackSolver",      ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3Solver,                      "AC3Solver",            ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3BacktrackSolver,             "AC3Backtrack",         ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3BacktrackLCVSolver,          "AC3BacktrackLCV",      ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3SubsetSolver,                "AC3SubsetSolver",      ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3SubsetBacktrackSolver,       "AC3SubsetBacktrack",   ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3FishSolver,                  "AC3FishSolver",        ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\blank.txt",            10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\sixteen.txt",          10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\killer.txt",           10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\jigsaw.txt",           10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\xsudoku.txt",          10,             {   0   }   },
+    {   AC3ChainSolver,                 "AC3ChainSolver",       ".\\sudokus\\antiknight.txt",       10,             {   0   }   },
+
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\blank.txt",            10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\sixteen.txt",          10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\killer.txt",           10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\jigsaw.txt",           10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\xsudoku.txt",          10,             {   0   }   },
+    {   AC3ChainBacktrackSolver,        "AC3ChainBacktrack",    ".\\sudokus\\antiknight.txt",       10,             {   0   }   },
+
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3AllDifferentSolver,          "AC3AllDifferent",      ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3AllDifferentBacktrackSolver, "AC3AllDiffBacktrack",  ".\\sudokus\\blank.txt",            10,             {   0   }   },
+
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\blank.txt",            10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\sixteen.txt",          10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\killer.txt",           10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\jigsaw.txt",           10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\xsudoku.txt",          10,             {   0   }   },
+    {   AC3ProbeSolver,                 "AC3ProbeSolver",       ".\\sudokus\\antiknight.txt",       10,             {   0   }   },
+
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\blank.txt",            10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\sixteen.txt",          10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\killer.txt",           10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\jigsaw.txt",           10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\xsudoku.txt",          10,             {   0   }   },
+    {   AC3ProbeBacktrackSolver,        "AC3ProbeBacktrack",    ".\\sudokus\\antiknight.txt",       10,             {   0   }   },
+
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\blank.txt",            10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\sixteen.txt",          10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\killer.txt",           10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\jigsaw.txt",           10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\xsudoku.txt",          10,             {   0   }   },
+    {   AdaptiveSolver,                 "AdaptiveSolver",       ".\\sudokus\\antiknight.txt",       10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\blank.txt",            10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\sixteen.txt",          10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\killer.txt",           10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\jigsaw.txt",           10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\xsudoku.txt",          10,             {   0   }   },
+    {   AC3RestartBacktrackSolver,      "AC3RestartBacktrack",  ".\\sudokus\\antiknight.txt",       10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\original_sudoku.txt",  10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\test_sudoku.txt",      10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\one_star.txt",         10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\two_star.txt",         10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\three_star.txt",       10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\four_star.txt",        10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\five_star.txt",        10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\super.txt",            10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\extreme.txt",          10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\blank.txt",            10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\sixteen.txt",          10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\killer.txt",           10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\jigsaw.txt",           10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\xsudoku.txt",          10,             {   0   }   },
+    {   AC3BackjumpSolver,              "AC3Backjump",          ".\\sudokus\\antiknight.txt",       10,             {   0   }   },
 };
 
 unsigned int NUM_TESTS = sizeof(TEST_LIST) / sizeof(TEST_LIST[0]);
@@ -103,6 +288,67 @@ unsigned int NUM_TESTS = sizeof(TEST_LIST) / sizeof(TEST_LIST[0]);
 #define min(a,b) (((a) < (b)) ? (a) : (b))
 #define max(a,b) (((a) > (b)) ? (a) : (b))
 
+/* Store the tests look solutions up in and add them to, or NULL. See SolveWithStore. */
+static SolutionStore testStore = NULL;
+
+/*
+** Opens the store at path for the tests. If another process is writing the
+** store it's opened read-only, and new solutions aren't stored.
+**
+** Returns false if the store can't be opened.
+*/
+static bool OpenTestStore(const char* path)
+{
+    if (OpenSolutionStore(&testStore, path, SOLUTION_STORE_SIZE, true)) return true;
+    if (!OpenSolutionStore(&testStore, path, 0, false)) return false;
+
+    printf("Solution store %s is being written by another process, so new solutions won't be stored\n", path);
+    return true;
+}
+
+/*
+** Runs solver against pzl. If the tests have a store, a plain 9x9 puzzle is
+** looked up in it by canonical form first and isn't solved if its solution is
+** stored, and a solution the solver finds is stored.
+*/
+static bool SolveWithStore(SolverFunction solver, SudokuPuzzle* pzl)
+{
+    GridSquare* squares = GetSquares(pzl->grid);
+    uint8_t values[CANON_SQUARES];
+    uint8_t canonical[CANON_SQUARES];
+    uint8_t solution[CANON_SQUARES];
+    CanonTransform transform;
+    unsigned int cell = 0;
+
+    if ((testStore == NULL) || (GetGridOrder(pzl->grid) != CANON_ORDER) || pzl->ownsRegions || (pzl->cages != NULL)) return solver(pzl);
+
+    for (cell = 0; cell < CANON_SQUARES; ++cell) values[cell] = (uint8_t)squares[cell].value;
+    if (!GetCanonicalForm(values, canonical, &transform)) return solver(pzl);
+
+    if (FindStoredSolution(testStore, canonical, solution)) {
+        InvertCanonTransform(&transform, solution, values);
+
+        for (cell = 0; cell < CANON_SQUARES; ++cell) {
+            squares[cell].value = (SquareValue)values[cell];
+            DomSetEmpty(&squares[cell].domain);
+            DomAddElement(&squares[cell].domain, values[cell]);
+        }
+
+        return true;
+    }
+
+    if (!solver(pzl)) return false;
+
+    if (isSudokuComplete(pzl) && isSudokuValid(pzl)) {
+        for (cell = 0; cell < CANON_SQUARES; ++cell) values[cell] = (uint8_t)squares[cell].value;
+
+        ApplyCanonTransform(&transform, values, solution);
+        StoreSolution(testStore, canonical, solution);
+    }
+
+    return true;
+}
+
 /*
 ** Runs individual test and calculates stats
 */
@@ -126,7 +372,7 @@ bool RunTest(SolverTest* test)
         SudokuPuzzle* pzl = NULL;
         SolverFunction solverFunc = test->solver;
 
-        if (CreateSudoku(&pzl) && LoadSudoku(pzl, test->testFile)) {
+        if (CreateSudokuFromFile(&pzl, test->testFile)) {
             clock_t startTime = 0;
             clock_t stopTime = 0;
             bool success = false;
@@ -134,7 +380,7 @@ bool RunTest(SolverTest* test)
             ++stats->attempted;
 
             startTime = clock();
-            success = solverFunc(pzl);
+            success = SolveWithStore(solverFunc, pzl);
             stopTime = clock();
 
             if (success) {
@@ -183,13 +429,13 @@ static void TestSolvers(SolverTest* tests, unsigned int numTests)
     }
 
     putchar('\n');
-    printf("Solver             Success   Solved     Avg time      Min time      Max time        Puzzle\n");
-    printf("------------------------------------------------------------------------------------------\n");
+    printf("Solver                Success   Solved     Avg time      Min time      Max time        Puzzle\n");
+    printf("---------------------------------------------------------------------------------------------\n");
     for (index = 0; index < numTests; ++index) {
         const double ave = tests[index].stats.solveTime_avg / (double)CLOCKS_PER_SEC;
         const double min = tests[index].stats.solveTime_min / (double)CLOCKS_PER_SEC;
         const double max = tests[index].stats.solveTime_max / (double)CLOCKS_PER_SEC;
-        printf("%-17s  %3u/%-3u  %3u/%-3u  %8.3f sec  %8.3f sec  %8.3f sec       %s\n", 
+        printf("%-20s  %3u/%-3u  %3u/%-3u  %8.3f sec  %8.3f sec  %8.3f sec       %s\n", 
             tests[index].name, tests[index].stats.successful, tests[index].stats.attempted, tests[index].stats.solved, tests[index].stats.attempted, ave, min, max, tests[index].testFile);
     }
 }
@@ -210,12 +456,12 @@ static void ShowSolutions(SolverTest* tests, unsigned int numTests)
         SudokuPuzzle* pzl = NULL;
         SolverFunction solverFunc = tests[index].solver;
 
-        if (CreateSudoku(&pzl) && LoadSudoku(pzl, tests[index].testFile)) {
+        if (CreateSudokuFromFile(&pzl, tests[index].testFile)) {
 
             printf("\nInitial Sudoku:\n");
             PrintSudoku(pzl);
 
-            if (solverFunc(pzl)) {
+            if (SolveWithStore(solverFunc, pzl)) {
                 printf("\nSolution:\n");
                 PrintSudoku(pzl);
             }
@@ -233,8 +479,344 @@ static void ShowSolutions(SolverTest* tests, unsigned int numTests)
     }
 }
 
-int main()
+/* Samurai puzzle run by TestSamurai */
+#define SAMURAI_FILE ".\\sudokus\\samurai.txt"
+#define SAMURAI_TRIES 10
+
+/*
+** Runs SamuraiSolver against the Samurai puzzle and prints results.
+*/
+static void TestSamurai(void)
 {
+    clock_t totalTime = 0;
+    unsigned int solved = 0;
+    unsigned int testNum = 0;
+
+    printf("Testing solver SamuraiSolver %u times against puzzle %s...", SAMURAI_TRIES, SAMURAI_FILE);
+
+    for (testNum = 0; testNum < SAMURAI_TRIES; ++testNum) {
+        SamuraiPuzzle* pzl = NULL;
+        clock_t startTime = 0;
+
+        if (!CreateSamurai(&pzl) || !LoadSamurai(pzl, SAMURAI_FILE)) {
+            DestroySamurai(&pzl);
+            printf("error loading puzzle\n");
+            return;
+        }
+
+        startTime = clock();
+        if (SamuraiSolver(pzl) && isSamuraiComplete(pzl) && isSamuraiValid(pzl)) ++solved;
+        totalTime += clock() - startTime;
+
+        DestroySamurai(&pzl);
+    }
+
+    printf("done\n");
+    printf("SamuraiSolver         Solved %u/%u  Avg time %8.3f sec\n\n", solved, SAMURAI_TRIES, totalTime / (double)CLOCKS_PER_SEC / SAMURAI_TRIES);
+}
+
+/* Define TECHNIQUES to report the search saved by each propagator */
+#ifdef TECHNIQUES
+
+/* Propagators added one at a time by ReportTechniques, cheapest first */
+static const Propagator* const TECHNIQUE_FUNCS[] = { &lockedCandidatesPropagator, &nakedSubsetsPropagator, &hiddenSubsetsPropagator, &fishPropagator,
+    &simpleColoringPropagator, &xyChainsPropagator, &forcingChainsPropagator };
+static const char* TECHNIQUE_NAMES[] = { "AC3 only", "+LockedCandidates", "+NakedSubsets", "+HiddenSubsets", "+Fish", "+SimpleColoring", "+XYChains", "+ForcingChains" };
+static const char* TECHNIQUE_FILES[] = { ".\\sudokus\\four_star.txt", ".\\sudokus\\five_star.txt", ".\\sudokus\\super.txt", ".\\sudokus\\extreme.txt", ".\\sudokus\\diabolical.txt" };
+
+/*
+** For each technique file, propagates with each technique added in turn and
+** then counts the values the backtracking search tries to finish the puzzle.
+** Prints the open squares left after propagation, the number of propagator
+** runs needed to reach fixpoint, and the search saved relative to AC3 alone.
+*/
+static void ReportTechniques(void)
+{
+    const unsigned int numTechniques = sizeof(TECHNIQUE_FUNCS) / sizeof(TECHNIQUE_FUNCS[0]);
+    const unsigned int numFiles = sizeof(TECHNIQUE_FILES) / sizeof(TECHNIQUE_FILES[0]);
+    unsigned int fileIndex = 0;
+
+    printf("Technique             Open   Runs   Search nodes      Saved     Time        Puzzle\n");
+    printf("--------------------------------------------------------------------------------------------\n");
+
+    for (fileIndex = 0; fileIndex < numFiles; ++fileIndex) {
+        unsigned long baseNodes = 0;
+        unsigned int numUsed = 0;
+
+        for (numUsed = 0; numUsed <= numTechniques; ++numUsed) {
+            const PropagatorList propagators = { TECHNIQUE_FUNCS, numUsed };
+            SudokuPuzzle* pzl = NULL;
+            EngineStats engineStats = { 0 };
+            unsigned long numNodes = 0;
+            unsigned int numOpen = 0;
+            clock_t startTime = 0;
+            clock_t stopTime = 0;
+            unsigned int row = 0;
+
+            if (!CreateSudokuFromFile(&pzl, TECHNIQUE_FILES[fileIndex])) {
+                printf("Error loading puzzle file!\n");
+                DestroySudoku(&pzl);
+                return;
+            }
+
+            startTime = clock();
+            if (AC3PropagatorSolver(pzl, &propagators, &engineStats)) {
+                for (row = 0; row < GetGridOrder(pzl->grid); ++row) {
+                    GridSquare* square = GetRow(pzl->grid, row);
+
+                    do {
+                        if (square->value == VALUE_NONE) ++numOpen;
+                    } while (GetNextColumn(pzl->grid, &square));
+                }
+
+                BacktrackCountingSolver(pzl, &numNodes);
+            }
+            stopTime = clock();
+
+            if (numUsed == 0) baseNodes = numNodes;
+
+            printf("%-20s  %4u  %5lu  %13lu  %8.1f%%  %6.3f sec  %s\n", TECHNIQUE_NAMES[numUsed], numOpen, engineStats.numRuns, numNodes,
+                (baseNodes > 0) ? 100.0 * (1.0 - (double)numNodes / (double)baseNodes) : 0.0,
+                (stopTime - startTime) / (double)CLOCKS_PER_SEC, TECHNIQUE_FILES[fileIndex]);
+
+            DestroySudoku(&pzl);
+        }
+
+        putchar('\n');
+    }
+}
+
+#endif
+
+/* Define ESCALATION to report the statistics AdaptiveSolver's thresholds are tuned from */
+#ifdef ESCALATION
+
+/* Puzzles run by ReportEscalation, easiest first */
+static const char* ESCALATION_FILES[] = { ".\\sudokus\\one_star.txt", ".\\sudokus\\two_star.txt", ".\\sudokus\\three_star.txt", ".\\sudokus\\four_star.txt",
+    ".\\sudokus\\five_star.txt", ".\\sudokus\\super.txt", ".\\sudokus\\extreme.txt", ".\\sudokus\\diabolical.txt", ".\\sudokus\\blank.txt" };
+
+/* Engines AdaptiveSolver escalates between, each run to the end by ReportEscalation */
+static const SolverFunction ESCALATION_FUNCS[] = { AC3BacktrackSolver, AC3SubsetBacktrackSolver, AC3ProbeBacktrackSolver, AdaptiveSolver };
+static const char* ESCALATION_STAGES[] = { "AC3", "Subsets", "Probe", "Search" };
+
+/*
+** Returns the squares left open after running solver against the puzzle in
+** fileName, or -1 if the file can't be loaded or the solver fails.
+*/
+static int CountOpenAfter(SolverFunction solver, const char* fileName)
+{
+    SudokuPuzzle* pzl = NULL;
+    int numOpen = -1;
+
+    if (CreateSudokuFromFile(&pzl, fileName) && solver(pzl)) {
+        const GridSquare* squares = GetSquares(pzl->grid);
+        unsigned int cell = 0;
+
+        numOpen = 0;
+        for (cell = 0; cell < GetGridOrder(pzl->grid) * GetGridOrder(pzl->grid); ++cell) {
+            if (squares[cell].value == VALUE_NONE) ++numOpen;
+        }
+    }
+
+    DestroySudoku(&pzl);
+    return numOpen;
+}
+
+/*
+** For each escalation file, prints the squares left open by AC3Solver and
+** AC3SubsetSolver, the time each engine AdaptiveSolver escalates to takes to
+** finish the puzzle, and the stage AdaptiveSolver stopped at. The thresholds
+** in AdaptiveSolver.h are tuned from this report: search should start below
+** the open squares where AC3Backtrack stops being the fastest, and probing
+** straight away above those where AC3SubsetBacktrack stops beating
+** AC3ProbeBacktrack.
+*/
+static void ReportEscalation(void)
+{
+    const unsigned int numFiles = sizeof(ESCALATION_FILES) / sizeof(ESCALATION_FILES[0]);
+    const unsigned int numFuncs = sizeof(ESCALATION_FUNCS) / sizeof(ESCALATION_FUNCS[0]);
+    const AdaptiveThresholds thresholds = GetAdaptiveThresholds(9);     /* The escalation files are all 9x9 */
+    unsigned int fileIndex = 0;
+
+    printf("Escalation thresholds: search at %u%% open squares or fewer, probe straight away at %u%% or more, search straight away above %u%%\n\n",
+        thresholds.searchOpen, thresholds.probeOpen, thresholds.maxProbeOpen);
+    printf("AC3 open  Subset open   AC3Backtrack  SubsetBacktrack  ProbeBacktrack      Adaptive  Stage     Puzzle\n");
+    printf("------------------------------------------------------------------------------------------------------\n");
+
+    for (fileIndex = 0; fileIndex < numFiles; ++fileIndex) {
+        AdaptiveStage stage = ADAPTIVE_STAGE_AC3;
+        SudokuPuzzle* pzl = NULL;
+        unsigned int funcIndex = 0;
+
+        printf("%8d  %11d", CountOpenAfter(AC3Solver, ESCALATION_FILES[fileIndex]), CountOpenAfter(AC3SubsetSolver, ESCALATION_FILES[fileIndex]));
+
+        for (funcIndex = 0; funcIndex < numFuncs; ++funcIndex) {
+            clock_t startTime = 0;
+
+            if (!CreateSudokuFromFile(&pzl, ESCALATION_FILES[fileIndex])) {
+                printf("\nError loading puzzle file!\n");
+                DestroySudoku(&pzl);
+                return;
+            }
+
+            startTime = clock();
+            ESCALATION_FUNCS[funcIndex](pzl);
+            printf("  %9.4f sec", (clock() - startTime) / (double)CLOCKS_PER_SEC);
+
+            DestroySudoku(&pzl);
+        }
+
+        if (CreateSudokuFromFile(&pzl, ESCALATION_FILES[fileIndex])) AdaptiveStageSolver(pzl, &stage);
+        DestroySudoku(&pzl);
+
+        printf("  %-8s  %s\n", ESCALATION_STAGES[stage], ESCALATION_FILES[fileIndex]);
+    }
+
+    putchar('\n');
+}
+
+#endif
+
+/* Define PORTFOLIO to report which solver wins the portfolio race on each puzzle */
+#ifdef PORTFOLIO
+
+/* Puzzles run by ReportPortfolio */
+static const char* PORTFOLIO_FILES[] = { ".\\sudokus\\five_star.txt", ".\\sudokus\\extreme.txt", ".\\sudokus\\diabolical.txt", ".\\sudokus\\sixteen.txt",
+    ".\\sudokus\\killer.txt", ".\\sudokus\\jigsaw.txt", ".\\sudokus\\xsudoku.txt", ".\\sudokus\\antiknight.txt" };
+#define PORTFOLIO_TRIES 10
+
+/*
+** Returns the wall clock time in seconds. The portfolio's solvers run in
+** parallel, so processor time would count every thread.
+*/
+static double WallSeconds(void)
+{
+    struct timespec now;
+
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/*
+** Races the default portfolio against each portfolio file, and prints how
+** often each solver won and the average wall time to solve. The solvers that
+** win most often are the best defaults for puzzles like these.
+*/
+static void ReportPortfolio(void)
+{
+    const unsigned int numFiles = sizeof(PORTFOLIO_FILES) / sizeof(PORTFOLIO_FILES[0]);
+    unsigned int numSolvers = 0;
+    const PortfolioEntry* portfolio = GetDefaultPortfolio(&numSolvers);
+    unsigned int totalWins[MAX_PORTFOLIO_SOLVERS] = { 0 };
+    unsigned int fileIndex = 0;
+    unsigned int index = 0;
+
+    printf("Solved  Wall time     Wins                                  Puzzle\n");
+    printf("--------------------------------------------------------------------------------------------\n");
+
+    for (fileIndex = 0; fileIndex < numFiles; ++fileIndex) {
+        unsigned int wins[MAX_PORTFOLIO_SOLVERS] = { 0 };
+        unsigned int solved = 0;
+        double totalTime = 0.0;
+        unsigned int testNum = 0;
+
+        for (testNum = 0; testNum < PORTFOLIO_TRIES; ++testNum) {
+            SudokuPuzzle* pzl = NULL;
+            double startTime = 0.0;
+            int winner = -1;
+
+            if (!CreateSudokuFromFile(&pzl, PORTFOLIO_FILES[fileIndex])) {
+                printf("Error loading puzzle file!\n");
+                DestroySudoku(&pzl);
+                return;
+            }
+
+            startTime = WallSeconds();
+            if (PortfolioRaceSolver(pzl, portfolio, numSolvers, &winner) && isSudokuComplete(pzl) && isSudokuValid(pzl)) ++solved;
+            totalTime += WallSeconds() - startTime;
+
+            if (winner >= 0) {
+                ++wins[winner];
+                ++totalWins[winner];
+            }
+
+            DestroySudoku(&pzl);
+        }
+
+        printf("%3u/%-3u  %8.4f sec  ", solved, PORTFOLIO_TRIES, totalTime / PORTFOLIO_TRIES);
+        for (index = 0; index < numSolvers; ++index) printf("%2u ", wins[index]);
+        printf("%*s%s\n", (int)(3 * (MAX_PORTFOLIO_SOLVERS - numSolvers) + 14), "", PORTFOLIO_FILES[fileIndex]);
+    }
+
+    printf("\nWins by solver:\n");
+    for (index = 0; index < numSolvers; ++index) printf("%-22s %3u\n", portfolio[index].name, totalWins[index]);
+    putchar('\n');
+}
+
+#endif
+
+/* Solver used by the service */
+#define SERVICE_SOLVER AdaptiveSolver
+
+/*
+** Serves puzzles from stdin, or from a Unix domain socket at socketPath if it
+** isn't NULL, until the input ends or a "quit" request. Solutions are kept in
+** the store at storePath if it isn't NULL. See SudokuService.h.
+*/
+static int Serve(const char* socketPath, const char* storePath)
+{
+    SolverContext* ctx = NULL;
+    bool success = false;
+
+    if (!CreateSolverContext(&ctx, SERVICE_SOLVER)) return EXIT_FAILURE;
+
+    if ((storePath != NULL) && !UseSolutionStore(ctx, storePath)) {
+        printf("ERROR: Unable to open solution store %s\n", storePath);
+        DestroySolverContext(&ctx);
+        return EXIT_FAILURE;
+    }
+
+    /* Responses go to stdout, so the note goes to stderr */
+    if ((storePath != NULL) && !ctx->storeWritable) {
+        fprintf(stderr, "Solution store %s is being written by another process; it's read-only until that process closes it\n", storePath);
+    }
+
+    if (socketPath != NULL) {
+        success = ServeSocket(ctx, socketPath);
+    }
+    else {
+        ServeStream(ctx, stdin, stdout);
+        success = true;
+    }
+
+    DestroySolverContext(&ctx);
+    ReleaseSudokuConstraints();
+    ReleaseCageCombinations();
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[])
+{
+    /* "--serve [socket] [--store path]" runs the solver service instead of the tests */
+    if ((argc > 1) && (strcmp(argv[1], "--serve") == 0)) {
+        const char* socketPath = NULL;
+        const char* storePath = NULL;
+        int arg = 0;
+
+        for (arg = 2; arg < argc; ++arg) {
+            if ((strcmp(argv[arg], "--store") == 0) && (arg + 1 < argc)) storePath = argv[++arg];
+            else socketPath = argv[arg];
+        }
+
+        return Serve(socketPath, storePath);
+    }
+
+    /* "--store path" looks the tests' plain 9x9 puzzles up in a solution store, and stores their solutions */
+    if ((argc > 2) && (strcmp(argv[1], "--store") == 0) && !OpenTestStore(argv[2])) {
+        printf("ERROR: Unable to open solution store %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
     /* Define RUN_TESTS to run solvers and accumulate runtime statistics */
     /* Define SOLUTIONS to run each solver and show the solution */
 #define RUN_TESTS
@@ -244,8 +826,25 @@ int main()
 #endif
 
 #ifdef RUN_TESTS
+    TestSamurai();
     TestSolvers(TEST_LIST, NUM_TESTS);
 #endif
 
+#ifdef TECHNIQUES
+    ReportTechniques();
+#endif
+
+#ifdef ESCALATION
+    ReportEscalation();
+#endif
+
+#ifdef PORTFOLIO
+    ReportPortfolio();
+#endif
+
+    CloseSolutionStore(&testStore);
+    ReleaseSudokuConstraints();
+    ReleaseSamuraiConstraints();
+    ReleaseCageCombinations();
     return EXIT_SUCCESS;
 }
\ No newline at end of file